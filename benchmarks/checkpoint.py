@@ -0,0 +1,31 @@
+import argparse
+import tempfile
+import time
+from pathlib import Path
+
+import vowpal_wabbit_next as vw
+
+parser = argparse.ArgumentParser(
+    description="Compare how long learning is blocked by serialize_to_file and by checkpoint_async."
+)
+parser.add_argument("--bits", type=int, nargs="+", default=[18, 22, 24, 26])
+args = parser.parse_args()
+
+print("| Bits | Method | Learning blocked | Total |")
+print("| --- | --- | --- | --- |")
+with tempfile.TemporaryDirectory() as temp_dir:
+    for bits in args.bits:
+        # Random weights make every weight non zero, so the model is as large as it can be for this many bits.
+        workspace = vw.Workspace(["-b", str(bits), "--random_weights"])
+
+        start = time.perf_counter()
+        workspace.serialize_to_file(Path(temp_dir) / "model.vw")
+        elapsed = time.perf_counter() - start
+        print(f"| {bits} | serialize_to_file | {elapsed:.4f} s | {elapsed:.4f} s |")
+
+        start = time.perf_counter()
+        future = workspace.checkpoint_async(Path(temp_dir) / "model.checkpoint")
+        future.result()
+        elapsed = time.perf_counter() - start
+        pause = workspace.checkpoint_stats["last_pause_seconds"]
+        print(f"| {bits} | checkpoint_async | {pause:.4f} s | {elapsed:.4f} s |")
@@ -0,0 +1,51 @@
+import argparse
+import time
+
+import numpy as np
+import vowpal_wabbit_next as vw
+
+parser = argparse.ArgumentParser(
+    description="Measure the cost of recording counters and of reading them compared with metrics."
+)
+parser.add_argument("--args", default="--quiet -q ab")
+parser.add_argument("--examples", type=int, default=100000)
+parser.add_argument("--reads", type=int, default=100000)
+args = parser.parse_args()
+
+
+def learn(**kwargs):
+    workspace = vw.Workspace(args.args.split(), **kwargs)
+    text_parser = vw.TextFormatParser(workspace)
+    examples = [
+        text_parser.parse_line(f"{i % 2} |a a_{i % 100} |b b_{i % 10} b_{i % 7}")
+        for i in range(args.examples)
+    ]
+    start = time.perf_counter()
+    for example in examples:
+        workspace.learn_one(example)
+    return workspace, (time.perf_counter() - start) / args.examples
+
+
+def time_reads(read):
+    start = time.perf_counter()
+    for _ in range(args.reads):
+        read()
+    return (time.perf_counter() - start) / args.reads
+
+
+_, baseline = learn()
+metrics_workspace, with_metrics = learn(record_metrics=True)
+counters_workspace, with_counters = learn(record_counters=True)
+buffer = np.zeros(len(vw.Workspace.counter_names()), dtype=np.uint64)
+
+print("| Mode | Learn time per example | Read time |")
+print("| --- | --- | --- |")
+print(f"| no metrics | {baseline * 1e6:.2f} us | |")
+print(
+    f"| record_metrics, metrics | {with_metrics * 1e6:.2f} us | "
+    f"{time_reads(lambda: metrics_workspace.metrics) * 1e6:.2f} us |"
+)
+print(
+    f"| record_counters, read_counters(out=buffer) | {with_counters * 1e6:.2f} us | "
+    f"{time_reads(lambda: counters_workspace.read_counters(out=buffer)) * 1e6:.2f} us |"
+)
@@ -0,0 +1,68 @@
+import argparse
+import time
+
+import vowpal_wabbit_next as vw
+
+parser = argparse.ArgumentParser(
+    description="Measure the overhead per reduction of the debug tree and of profiling on learn_one."
+)
+parser.add_argument("--args", default="--cb_explore_adf --quiet")
+parser.add_argument("--examples", type=int, default=20000)
+parser.add_argument("--actions", type=int, default=4)
+args = parser.parse_args()
+
+
+def make_lines(i):
+    lines = [f"shared | user_{i % 100} time_{i % 24}"]
+    for action in range(args.actions):
+        label = (
+            f"{action}:{(i + action) % 2}:0.5 " if action == i % args.actions else ""
+        )
+        lines.append(f"{label}| action_{action} topic_{(i + action) % 10}")
+    return lines
+
+
+def count_nodes(node):
+    return 1 + sum(count_nodes(child) for child in node.children)
+
+
+def run(**kwargs):
+    workspace = vw.Workspace(args.args.split(), **kwargs)
+    text_parser = vw.TextFormatParser(workspace)
+    # Parse up front so that only learn is measured.
+    examples = [
+        [text_parser.parse_line(line) for line in make_lines(i)]
+        for i in range(args.examples)
+    ]
+    nodes = 0
+    start = time.perf_counter()
+    for example in examples:
+        trees = workspace.learn_one(example)
+        if trees is not None:
+            nodes += sum(count_nodes(tree) for tree in trees)
+    elapsed = time.perf_counter() - start
+    return elapsed / args.examples, nodes / args.examples
+
+
+modes = [
+    ("no debugging", {}),
+    ("enable_profiling", {"enable_profiling": True}),
+    ("debug tree, all fields", {"enable_debug_tree": True}),
+    ("debug tree, no fields", {"enable_debug_tree": True, "debug_tree_fields": []}),
+    ("debug tree sampled 1 in 100", {"debug_sample_every": 100}),
+]
+
+# The number of reductions each call passes through is taken from the debug tree.
+_, reductions_per_call = run(enable_debug_tree=True, debug_tree_fields=[])
+baseline = None
+print(f"Reductions per call: {reductions_per_call:.1f}")
+print("| Mode | Time per call | Slowdown | Overhead per reduction |")
+print("| --- | --- | --- | --- |")
+for name, kwargs in modes:
+    per_call, _ = run(**kwargs)
+    if baseline is None:
+        baseline = per_call
+    overhead = (per_call - baseline) / reductions_per_call
+    print(
+        f"| {name} | {per_call * 1e6:.2f} us | {per_call / baseline:.2f}x | {overhead * 1e9:.0f} ns |"
+    )
@@ -0,0 +1,59 @@
+import argparse
+import random
+import time
+
+import vowpal_wabbit_next as vw
+
+parser = argparse.ArgumentParser(
+    description="Compare dense and sparse model deltas when each client only updates a small fraction of the weights."
+)
+parser.add_argument("--bits", type=int, default=24)
+parser.add_argument("--clients", type=int, default=8)
+parser.add_argument("--examples", type=int, default=1000)
+parser.add_argument("--features", type=int, default=20)
+args = parser.parse_args()
+
+
+def timed(func):
+    start = time.perf_counter()
+    result = func()
+    return result, time.perf_counter() - start
+
+
+base = vw.Workspace(["-b", str(args.bits)])
+base_data = base.serialize()
+clients = []
+for client in range(args.clients):
+    model = vw.Workspace(model_data=base_data)
+    text_parser = vw.TextFormatParser(model)
+    rng = random.Random(client)
+    for _ in range(args.examples):
+        features = " ".join(f"f{rng.randrange(1 << 30)}" for _ in range(args.features))
+        model.learn_one(text_parser.parse_line(f"{rng.choice([0, 1])} | {features}"))
+    clients.append(model)
+
+dense_deltas, dense_calculate = timed(
+    lambda: [vw.calculate_delta(base, model) for model in clients]
+)
+dense_size = sum(len(delta.serialize()) for delta in dense_deltas)
+dense_merged, dense_merge = timed(lambda: vw.merge_deltas(dense_deltas))
+_, dense_apply = timed(lambda: vw.apply_delta(base, dense_merged))
+
+sparse_deltas, sparse_calculate = timed(
+    lambda: [vw.calculate_sparse_delta(base, model) for model in clients]
+)
+sparse_size = sum(delta.indices.nbytes + delta.values.nbytes for delta in sparse_deltas)
+sparse_merged, sparse_merge = timed(lambda: vw.merge_sparse_deltas(sparse_deltas))
+_, sparse_apply = timed(lambda: vw.apply_delta_inplace(base, sparse_merged))
+
+print(
+    f"{args.clients} clients, {args.bits} bits, {len(sparse_merged)} changed weights\n"
+)
+print("| Delta | Size | Calculate | Merge | Apply |")
+print("| --- | --- | --- | --- | --- |")
+print(
+    f"| Dense | {dense_size / 1024 / 1024:.2f} MB | {dense_calculate:.4f} s | {dense_merge:.4f} s | {dense_apply:.4f} s |"
+)
+print(
+    f"| Sparse | {sparse_size / 1024 / 1024:.2f} MB | {sparse_calculate:.4f} s | {sparse_merge:.4f} s | {sparse_apply:.4f} s |"
+)
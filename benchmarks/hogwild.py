@@ -0,0 +1,53 @@
+import argparse
+import time
+
+import numpy as np
+
+import vowpal_wabbit_next as vw
+
+parser = argparse.ArgumentParser(
+    description="Measure throughput and loss of learn_parallel on one shared workspace as the number of threads grows."
+)
+parser.add_argument("--data", default="../tests/data/rcv1_small.dat")
+parser.add_argument("--args", default="--quiet")
+parser.add_argument("--repeat", type=int, default=200)
+parser.add_argument("--max_threads", type=int, default=8)
+args = parser.parse_args()
+
+with open(args.data, "r") as f:
+    lines = [line for line in f.read().splitlines() if line]
+labels = np.array([float(line.split()[0]) for line in lines])
+
+
+def train(num_threads):
+    workspace = vw.Workspace(args.args.split())
+    text_parser = vw.TextFormatParser(workspace)
+    # Parse up front so that only learn is measured. Each example object may only be given once.
+    examples = [text_parser.parse_line(line) for line in lines * args.repeat]
+    start = time.perf_counter()
+    workspace.learn_parallel(examples, threads=num_threads)
+    elapsed = time.perf_counter() - start
+
+    predictions = workspace.predict_batch(
+        [text_parser.parse_line(line) for line in lines]
+    )
+    return elapsed, len(examples), float(np.mean((predictions - labels) ** 2))
+
+
+thread_counts = []
+n = 1
+while n <= args.max_threads:
+    thread_counts.append(n)
+    n *= 2
+
+baseline = None
+print("| Threads | Time | Examples/s | Speedup | Training MSE |")
+print("| --- | --- | --- | --- | --- |")
+for num_threads in thread_counts:
+    elapsed, num_examples, loss = train(num_threads)
+    throughput = num_examples / elapsed
+    if baseline is None:
+        baseline = throughput
+    print(
+        f"| {num_threads} | {elapsed:.4f} s | {throughput:.0f} | {throughput / baseline:.2f}x | {loss:.5f} |"
+    )
@@ -0,0 +1,71 @@
+import argparse
+import resource
+import subprocess
+import sys
+import tempfile
+import time
+from pathlib import Path
+
+import vowpal_wabbit_next as vw
+
+parser = argparse.ArgumentParser(
+    description="Compare load time and peak memory of loading models of different sizes from bytes and from a file."
+)
+parser.add_argument("--bits", type=int, nargs="+", default=[18, 22, 24, 26])
+parser.add_argument(
+    "--_load", nargs=2, metavar=("METHOD", "PATH"), help=argparse.SUPPRESS
+)
+args = parser.parse_args()
+
+
+def load(method: str, path: str) -> None:
+    if method == "bytes":
+        with open(path, "rb") as f:
+            vw.Workspace(model_data=f.read())
+    elif method == "file object":
+        with open(path, "rb") as f:
+            vw.Workspace(model_file=f)
+    else:
+        vw.Workspace.load_from_file(path)
+
+
+if args._load is not None:
+    # Each load runs in a fresh process so the peak resident memory belongs to it alone.
+    before = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    start = time.perf_counter()
+    load(*args._load)
+    elapsed = time.perf_counter() - start
+    peak = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss - before
+    print(f"{elapsed} {peak}")
+    sys.exit(0)
+
+print("| Bits | Model size | Method | Time | Peak memory increase |")
+print("| --- | --- | --- | --- | --- |")
+with tempfile.TemporaryDirectory() as temp_dir:
+    for bits in args.bits:
+        model_path = Path(temp_dir) / f"model_{bits}.vw"
+        # Random weights make every weight non zero, so the model is as large as it can be for this many bits.
+        vw.Workspace(["-b", str(bits), "--random_weights"]).serialize_to_file(
+            model_path
+        )
+        gz_path = Path(temp_dir) / f"model_{bits}.vw.gz"
+        subprocess.run(f"gzip -c {model_path} > {gz_path}", shell=True, check=True)
+
+        size_mb = model_path.stat().st_size / 1024 / 1024
+        for method, path in [
+            ("bytes", model_path),
+            ("file object", model_path),
+            ("path", model_path),
+            ("gzip path", gz_path),
+        ]:
+            result = subprocess.run(
+                [sys.executable, __file__, "--_load", method, str(path)],
+                check=True,
+                capture_output=True,
+                text=True,
+            )
+            elapsed, peak = result.stdout.split()
+            # ru_maxrss is in kilobytes on Linux.
+            print(
+                f"| {bits} | {size_mb:.1f} MB | {method} | {float(elapsed):.4f} s | {int(peak) / 1024:.1f} MB |"
+            )
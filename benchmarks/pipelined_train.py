@@ -0,0 +1,35 @@
+import argparse
+import time
+
+import vowpal_wabbit_next as vw
+
+parser = argparse.ArgumentParser(
+    description="Compare learning from a text file in a Python loop with the background parsing pipeline."
+)
+parser.add_argument("--data", default="rcv1.5k.txt")
+parser.add_argument("--args", default="--quiet -q::")
+parser.add_argument("--passes", type=int, default=1)
+args = parser.parse_args()
+
+
+def python_loop() -> None:
+    workspace = vw.Workspace(args.args.split())
+    for _ in range(args.passes):
+        with open(args.data, "r") as f:
+            with vw.TextFormatReader(workspace, f) as reader:
+                for example in reader:
+                    workspace.learn_one(example)
+        workspace.end_pass()
+
+
+def pipelined() -> None:
+    workspace = vw.Workspace(args.args.split())
+    workspace.train_from_file(args.data, passes=args.passes)
+
+
+print("| Method | Time |")
+print("| --- | --- |")
+for name, func in [("Python loop", python_loop), ("train_from_file", pipelined)]:
+    start = time.perf_counter()
+    func()
+    print(f"| {name} | {time.perf_counter() - start:.4f} s |")
@@ -0,0 +1,54 @@
+import argparse
+import time
+from concurrent.futures import ThreadPoolExecutor
+
+import vowpal_wabbit_next as vw
+
+parser = argparse.ArgumentParser(
+    description="Measure learn throughput of N independent workspaces trained on N threads."
+)
+parser.add_argument("--data", default="rcv1.5k.txt")
+parser.add_argument("--args", default="--quiet -q::")
+parser.add_argument("--max_threads", type=int, default=8)
+args = parser.parse_args()
+
+with open(args.data, "r") as f:
+    lines = f.readlines()
+
+
+def make_job():
+    workspace = vw.Workspace(args.args.split())
+    text_parser = vw.TextFormatParser(workspace)
+    # Parse up front so that only learn is measured.
+    examples = [text_parser.parse_line(line) for line in lines]
+    return workspace, examples
+
+
+def train(job):
+    workspace, examples = job
+    for example in examples:
+        workspace.learn_one(example)
+
+
+thread_counts = []
+n = 1
+while n <= args.max_threads:
+    thread_counts.append(n)
+    n *= 2
+
+baseline = None
+print("| Threads | Time | Examples/s | Speedup |")
+print("| --- | --- | --- | --- |")
+for num_threads in thread_counts:
+    jobs = [make_job() for _ in range(num_threads)]
+    with ThreadPoolExecutor(max_workers=num_threads) as executor:
+        start = time.perf_counter()
+        list(executor.map(train, jobs))
+        elapsed = time.perf_counter() - start
+
+    throughput = num_threads * len(lines) / elapsed
+    if baseline is None:
+        baseline = throughput
+    print(
+        f"| {num_threads} | {elapsed:.4f} s | {throughput:.0f} | {throughput / baseline:.2f}x |"
+    )
@@ -0,0 +1,179 @@
+#include "atomic_file.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#ifdef _WIN32
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  include <windows.h>
+
+#  include <algorithm>
+#  include <filesystem>
+#else
+#  include <fcntl.h>
+#  include <unistd.h>
+
+#  include <cerrno>
+#endif
+
+namespace
+{
+// The process id keeps the names unique between processes and the counter between writers in this process.
+std::string make_temp_path(const std::string& path, uint64_t process_id)
+{
+  static std::atomic<uint64_t> next_id{0};
+  return path + ".tmp." + std::to_string(process_id) + "." +
+      std::to_string(next_id.fetch_add(1, std::memory_order_relaxed));
+}
+
+#ifndef _WIN32
+std::runtime_error make_error(const std::string& what, const std::string& path)
+{
+  return std::runtime_error(what + " '" + path + "': " + std::strerror(errno));
+}
+
+std::string parent_directory(const std::string& path)
+{
+  const auto separator = path.find_last_of('/');
+  if (separator == std::string::npos) { return "."; }
+  return separator == 0 ? "/" : path.substr(0, separator);
+}
+#endif
+}  // namespace
+
+#ifdef _WIN32
+vwpy::atomic_file_writer::atomic_file_writer(std::string path) : _path(std::move(path))
+{
+  // CREATE_NEW fails if the file exists, which can only be a leftover of a process which had the same id.
+  while (_handle == nullptr)
+  {
+    _temp_path = make_temp_path(_path, GetCurrentProcessId());
+    HANDLE handle = CreateFileW(std::filesystem::u8path(_temp_path).wstring().c_str(), GENERIC_WRITE, 0, nullptr,
+        CREATE_NEW, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle != INVALID_HANDLE_VALUE) { _handle = handle; }
+    else if (GetLastError() != ERROR_FILE_EXISTS) { throw std::runtime_error("Failed to create '" + _temp_path + "'"); }
+  }
+}
+
+ssize_t vwpy::atomic_file_writer::write(const char* buffer, size_t num_bytes)
+{
+  size_t offset = 0;
+  while (offset < num_bytes)
+  {
+    const auto to_write = static_cast<DWORD>(std::min<size_t>(num_bytes - offset, 1 << 30));
+    DWORD written = 0;
+    if (!WriteFile(_handle, buffer + offset, to_write, &written, nullptr) || written == 0)
+    {
+      throw std::runtime_error("Failed to write '" + _temp_path + "'");
+    }
+    offset += written;
+  }
+  return static_cast<ssize_t>(num_bytes);
+}
+
+void vwpy::atomic_file_writer::commit()
+{
+  if (!FlushFileBuffers(_handle)) { throw std::runtime_error("Failed to sync '" + _temp_path + "'"); }
+  close();
+  if (!MoveFileExW(std::filesystem::u8path(_temp_path).wstring().c_str(),
+          std::filesystem::u8path(_path).wstring().c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+  {
+    throw std::runtime_error("Failed to rename '" + _temp_path + "' to '" + _path + "'");
+  }
+  _committed = true;
+}
+
+void vwpy::atomic_file_writer::close()
+{
+  if (_handle != nullptr && !CloseHandle(_handle))
+  {
+    _handle = nullptr;
+    throw std::runtime_error("Failed to close '" + _temp_path + "'");
+  }
+  _handle = nullptr;
+}
+
+vwpy::atomic_file_writer::~atomic_file_writer()
+{
+  if (_committed) { return; }
+  if (_handle != nullptr) { CloseHandle(_handle); }
+  DeleteFileW(std::filesystem::u8path(_temp_path).wstring().c_str());
+}
+#else
+vwpy::atomic_file_writer::atomic_file_writer(std::string path) : _path(std::move(path))
+{
+  // O_EXCL fails if the file exists, which can only be a leftover of a process which had the same id.
+  while (_fd == -1)
+  {
+    _temp_path = make_temp_path(_path, static_cast<uint64_t>(::getpid()));
+    _fd = ::open(_temp_path.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0666);
+    if (_fd == -1 && errno != EEXIST) { throw make_error("Failed to create", _temp_path); }
+  }
+}
+
+ssize_t vwpy::atomic_file_writer::write(const char* buffer, size_t num_bytes)
+{
+  size_t offset = 0;
+  while (offset < num_bytes)
+  {
+    const auto written = ::write(_fd, buffer + offset, num_bytes - offset);
+    if (written == -1 && errno == EINTR) { continue; }
+    if (written <= 0) { throw make_error("Failed to write", _temp_path); }
+    offset += static_cast<size_t>(written);
+  }
+  return static_cast<ssize_t>(num_bytes);
+}
+
+void vwpy::atomic_file_writer::commit()
+{
+  if (::fsync(_fd) == -1) { throw make_error("Failed to sync", _temp_path); }
+  close();
+  if (::rename(_temp_path.c_str(), _path.c_str()) == -1) { throw make_error("Failed to rename", _temp_path); }
+  _committed = true;
+
+  // The rename is only durable once the directory is synced. The file is already complete either way, so this is
+  // best effort.
+  const int directory = ::open(parent_directory(_path).c_str(), O_RDONLY | O_CLOEXEC);
+  if (directory != -1)
+  {
+    ::fsync(directory);
+    ::close(directory);
+  }
+}
+
+void vwpy::atomic_file_writer::close()
+{
+  const int fd = std::exchange(_fd, -1);
+  if (fd != -1 && ::close(fd) == -1) { throw make_error("Failed to close", _temp_path); }
+}
+
+vwpy::atomic_file_writer::~atomic_file_writer()
+{
+  if (_committed) { return; }
+  if (_fd != -1) { ::close(_fd); }
+  ::unlink(_temp_path.c_str());
+}
+#endif
+
+void vwpy::write_all(VW::io::writer& output, const char* data, size_t size)
+{
+  const auto written = output.write(data, size);
+  if (written < 0) { throw std::runtime_error("Failed to write " + std::to_string(size) + " bytes."); }
+  if (static_cast<size_t>(written) != size)
+  {
+    throw std::runtime_error(
+        "Only " + std::to_string(written) + " of " + std::to_string(size) + " bytes were written, the disk may be full.");
+  }
+}
+
+ssize_t vwpy::checked_writer::write(const char* buffer, size_t num_bytes)
+{
+  write_all(*_inner, buffer, num_bytes);
+  return static_cast<ssize_t>(num_bytes);
+}
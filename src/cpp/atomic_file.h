@@ -0,0 +1,62 @@
+#pragma once
+
+#include "vw/io/io_adapter.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace vwpy
+{
+
+// Writes a file which either completely replaces the file at path or leaves it untouched. The data is written to a
+// temporary file with a unique name in the same directory, so concurrent writers to the same path never share it.
+// commit syncs the temporary file to disk and renames it over path. If this is destroyed without committing, the
+// temporary file is removed. Every write either writes all of its data or throws.
+class atomic_file_writer : public VW::io::writer
+{
+public:
+  explicit atomic_file_writer(std::string path);
+  ~atomic_file_writer() override;
+
+  atomic_file_writer(const atomic_file_writer&) = delete;
+  atomic_file_writer& operator=(const atomic_file_writer&) = delete;
+
+  ssize_t write(const char* buffer, size_t num_bytes) override;
+  // Nothing is buffered, commit syncs the data to disk.
+  void flush() override {}
+  void commit();
+
+private:
+  void close();
+
+  std::string _path;
+  std::string _temp_path;
+#ifdef _WIN32
+  void* _handle = nullptr;
+#else
+  int _fd = -1;
+#endif
+  bool _committed = false;
+};
+
+// Forwards to another writer, throwing if any write is short. Wrapping the writer of a VW::io_buf makes a failed write
+// surface as an error from its flush.
+class checked_writer : public VW::io::writer
+{
+public:
+  explicit checked_writer(std::unique_ptr<VW::io::writer> inner) : _inner(std::move(inner)) {}
+
+  ssize_t write(const char* buffer, size_t num_bytes) override;
+  void flush() override { _inner->flush(); }
+
+private:
+  std::unique_ptr<VW::io::writer> _inner;
+};
+
+// Writes all of data or throws. VW::io::writer::write may write less than it was given, which would otherwise go
+// unnoticed and leave a truncated file.
+void write_all(VW::io::writer& output, const char* data, size_t size);
+
+}  // namespace vwpy
@@ -0,0 +1,134 @@
+#include "checkpoint.h"
+
+#include "atomic_file.h"
+#include "vw/core/array_parameters_dense.h"
+#include "vw/core/global_data.h"
+#include "vw/core/io_buf.h"
+#include "vw/core/scope_exit.h"
+#include "vw/core/vw.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace
+{
+constexpr char CHECKPOINT_MAGIC[8] = {'V', 'W', 'P', 'Y', 'C', 'K', 'P', 'T'};
+constexpr uint32_t CHECKPOINT_VERSION = 1;
+constexpr size_t CHECKPOINT_HEADER_SIZE = 40;
+constexpr size_t CHECKPOINT_WEIGHTS_ALIGNMENT = 64;
+// Large writes are split so a Python file object is never handed a single bytes object the size of the weights.
+constexpr size_t WRITE_CHUNK_SIZE = 1 << 20;
+
+size_t align_up(size_t value, size_t alignment) { return (value + alignment - 1) / alignment * alignment; }
+
+// Header fields are stored in native byte order, which is little endian on every supported platform.
+template <typename T>
+void write_header_field(char* header, size_t offset, T value)
+{
+  std::memcpy(header + offset, &value, sizeof(T));
+}
+
+template <typename T>
+T read_header_field(const char* header, size_t offset)
+{
+  T value;
+  std::memcpy(&value, header + offset, sizeof(T));
+  return value;
+}
+
+void write_chunked(VW::io::writer& output, const char* data, size_t size)
+{
+  for (size_t offset = 0; offset < size; offset += WRITE_CHUNK_SIZE)
+  {
+    vwpy::write_all(output, data + offset, std::min(WRITE_CHUNK_SIZE, size - offset));
+  }
+}
+}  // namespace
+
+std::vector<char> vwpy::save_model_without_weights(VW::workspace& ws)
+{
+  if (ws.weights.sparse) { throw std::invalid_argument("Only dense weights are supported."); }
+  // The model is serialized with an empty placeholder in place of the weights. The placeholder keeps the stride so the
+  // layout of the workspace is unchanged.
+  auto& dense = ws.weights.dense_weights;
+  VW::dense_parameters placeholder(1, dense.stride_shift());
+  std::swap(dense, placeholder);
+  auto restore = VW::scope_exit([&]() { std::swap(dense, placeholder); });
+  auto backing_vector = std::make_shared<std::vector<char>>();
+  VW::io_buf io_writer;
+  io_writer.add_file(VW::io::create_vector_writer(backing_vector));
+  VW::save_predictor(ws, io_writer);
+  io_writer.flush();
+  return std::move(*backing_vector);
+}
+
+std::unique_ptr<vwpy::workspace_snapshot> vwpy::workspace_snapshot::take(VW::workspace& ws)
+{
+  if (ws.weights.sparse) { throw std::invalid_argument("Checkpoints are only supported for dense weights."); }
+  std::unique_ptr<workspace_snapshot> snapshot(new workspace_snapshot());
+
+  auto& dense = ws.weights.dense_weights;
+  snapshot->_weights.assign(dense.first(), dense.first() + dense.mask() + 1);
+  snapshot->_model = save_model_without_weights(ws);
+  return snapshot;
+}
+
+void vwpy::workspace_snapshot::write(VW::io::writer& output) const
+{
+  const uint64_t weights_offset = align_up(CHECKPOINT_HEADER_SIZE + _model.size(), CHECKPOINT_WEIGHTS_ALIGNMENT);
+  char header[CHECKPOINT_HEADER_SIZE] = {};
+  std::memcpy(header, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+  write_header_field(header, 8, CHECKPOINT_VERSION);
+  write_header_field(header, 16, static_cast<uint64_t>(_model.size()));
+  write_header_field(header, 24, weights_offset);
+  write_header_field(header, 32, static_cast<uint64_t>(weights_bytes()));
+
+  const std::vector<char> padding(weights_offset - CHECKPOINT_HEADER_SIZE - _model.size(), 0);
+  vwpy::write_all(output, header, sizeof(header));
+  write_chunked(output, _model.data(), _model.size());
+  vwpy::write_all(output, padding.data(), padding.size());
+  write_chunked(output, reinterpret_cast<const char*>(_weights.data()), weights_bytes());
+  output.flush();
+}
+
+vwpy::checkpoint_file vwpy::checkpoint_file::open(const std::string& path)
+{
+  checkpoint_file result{};
+  auto file = mapped_file::open(path);
+  const char* data = file->data();
+  if (file->size() < CHECKPOINT_HEADER_SIZE || std::memcmp(data, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC)) != 0)
+  {
+    throw std::invalid_argument("'" + path + "' is not a checkpoint file.");
+  }
+  if (read_header_field<uint32_t>(data, 8) != CHECKPOINT_VERSION)
+  {
+    throw std::invalid_argument("'" + path + "' was written by an unsupported version.");
+  }
+  result.model_size = read_header_field<uint64_t>(data, 16);
+  const auto weights_offset = read_header_field<uint64_t>(data, 24);
+  result.weights_size = read_header_field<uint64_t>(data, 32);
+  if (weights_offset < CHECKPOINT_HEADER_SIZE || result.model_size > weights_offset - CHECKPOINT_HEADER_SIZE ||
+      weights_offset > file->size() || result.weights_size > file->size() - weights_offset)
+  {
+    throw std::invalid_argument("'" + path + "' is truncated or corrupt.");
+  }
+  result.model_data = data + CHECKPOINT_HEADER_SIZE;
+  result.weights = data + weights_offset;
+  result.file = std::move(file);
+  return result;
+}
+
+void vwpy::restore_checkpoint(VW::workspace& ws, const checkpoint_file& file)
+{
+  if (ws.weights.sparse) { throw std::invalid_argument("Checkpoints are only supported for dense weights."); }
+  auto& dense = ws.weights.dense_weights;
+  if ((dense.mask() + 1) * sizeof(float) != file.weights_size)
+  {
+    throw std::invalid_argument("The checkpoint weights do not match the model they were loaded with.");
+  }
+  file.file->advise_sequential();
+  std::memcpy(dense.first(), file.weights, file.weights_size);
+}
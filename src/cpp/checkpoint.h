@@ -0,0 +1,62 @@
+#pragma once
+
+#include "mapped_file.h"
+#include "vw/core/vw_fwd.h"
+#include "vw/io/io_adapter.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace vwpy
+{
+
+// Serializes everything in the model except the weights, which keeps it small and fast to write. A workspace created
+// from it has the same options and learning state, with zeroed weights. The caller must hold the workspace lock.
+// Throws if the workspace uses sparse weights.
+std::vector<char> save_model_without_weights(VW::workspace& ws);
+
+// A copy of a workspace's model taken under the workspace lock. Taking it costs a copy of the dense weights, and it
+// can then be written without the lock while the workspace keeps learning.
+class workspace_snapshot
+{
+public:
+  // The caller must hold the workspace lock. Throws if the workspace uses sparse weights.
+  static std::unique_ptr<workspace_snapshot> take(VW::workspace& ws);
+
+  workspace_snapshot(const workspace_snapshot&) = delete;
+  workspace_snapshot& operator=(const workspace_snapshot&) = delete;
+
+  // Writes a checkpoint file, which holds the serialized model without its weights followed by the dense weights,
+  // including the per weight learning state, as they are laid out in memory. Throws if any write is short.
+  void write(VW::io::writer& output) const;
+
+  size_t weights_bytes() const { return _weights.size() * sizeof(float); }
+
+private:
+  workspace_snapshot() = default;
+
+  std::vector<char> _model;
+  std::vector<float> _weights;
+};
+
+// A file written by workspace_snapshot::write.
+struct checkpoint_file
+{
+  // Throws if the file is not a checkpoint file.
+  static checkpoint_file open(const std::string& path);
+
+  std::shared_ptr<const mapped_file> file;
+  // The serialized model, without weights.
+  const char* model_data;
+  size_t model_size;
+  const char* weights;
+  size_t weights_size;
+};
+
+// Copies the weights of a checkpoint into a workspace created from its model data. The caller must hold the workspace
+// lock.
+void restore_checkpoint(VW::workspace& ws, const checkpoint_file& file);
+
+}  // namespace vwpy
@@ -3,8 +3,11 @@
 #include "label.h"
 #include "vw/core/debug_print.h"
 #include "vw/core/label_type.h"
+#include "vw/core/scope_exit.h"
 
+#include <algorithm>
 #include <memory>
+#include <random>
 #include <stack>
 #include <string>
 #include <vector>
@@ -85,17 +88,17 @@ std::string interaction_to_string(const std::vector<VW::namespace_index>& inter_
   return ss.str();
 }
 
-std::vector<std::string> get_interactions(const VW::example& ex)
+std::variant<vwpy::interaction_names, std::vector<vwpy::interaction_names>> get_interactions(
+    const VW::example& ex, vwpy::debug_data& state)
 {
-  std::vector<std::string> interactions;
-  for (auto& inter_list : *ex.interactions) { interactions.push_back(interaction_to_string(inter_list)); }
-  return interactions;
+  return state.intern_interactions(*ex.interactions);
 }
 
-std::vector<std::vector<std::string>> get_interactions(const VW::multi_ex& ex)
+std::variant<vwpy::interaction_names, std::vector<vwpy::interaction_names>> get_interactions(
+    const VW::multi_ex& ex, vwpy::debug_data& state)
 {
-  std::vector<std::vector<std::string>> interactions;
-  for (auto& example : ex) { interactions.push_back(get_interactions(*example)); }
+  std::vector<vwpy::interaction_names> interactions;
+  for (auto& example : ex) { interactions.push_back(state.intern_interactions(*example->interactions)); }
   return interactions;
 }
 
@@ -108,14 +111,29 @@ struct debug_data_holder
 template <typename ExampleT, bool is_learn>
 static void debug_transform(debug_data_holder& data, VW::LEARNER::learner& base, ExampleT& ex)
 {
+  auto& state = *data.shared_debug_state;
+  // Calls which are not captured, and the calls made below them, go straight to the reduction below.
+  if (state.uncaptured_depth > 0 || (state.active.empty() && !state.should_capture()))
+  {
+    state.uncaptured_depth++;
+    auto on_exit = VW::scope_exit([&]() { state.uncaptured_depth--; });
+    if constexpr (is_learn) { base.learn(ex); }
+    else { base.predict(ex); }
+    return;
+  }
+
   auto overall_start_time = std::chrono::high_resolution_clock::now();
-  auto self = std::make_shared<vwpy::debug_node>();
+  auto* self = state.active.empty() ? &state.start_tree() : &state.arena->allocate();
   self->overall_start_time = overall_start_time;
   self->name = base.get_name();
-  self->input_labels = get_labels(ex, base.get_input_label_type());
-  self->interactions = get_interactions(ex);
-  self->weight = get_weight(ex);
-  self->offset = get_offset(ex);
+  self->fields = state.fields;
+  if (state.fields & vwpy::DEBUG_FIELD_INPUT_LABELS)
+  {
+    self->input_labels = get_labels(ex, base.get_input_label_type());
+  }
+  if (state.fields & vwpy::DEBUG_FIELD_INTERACTIONS) { self->interactions = get_interactions(ex, state); }
+  if (state.fields & vwpy::DEBUG_FIELD_WEIGHT) { self->weight = get_weight(ex); }
+  if (state.fields & vwpy::DEBUG_FIELD_OFFSET) { self->offset = get_offset(ex); }
 
   // Test if ExampleT is VW::example
   if constexpr (std::is_same_v<ExampleT, VW::example>)
@@ -135,7 +153,6 @@ static void debug_transform(debug_data_holder& data, VW::LEARNER::learner& base,
   }
 
   if (!data.shared_debug_state->active.empty()) { data.shared_debug_state->active.top()->children.push_back(self); }
-  else { data.shared_debug_state->root = self; }
 
   // TODO: make this more robust.
   // If we are entering into the same reduction which currently resides at the top of the stack we do not push a new
@@ -147,25 +164,110 @@ static void debug_transform(debug_data_holder& data, VW::LEARNER::learner& base,
     data.shared_debug_state->active.push(self);
   }
   self->start_time = std::chrono::high_resolution_clock::now();
-  if constexpr (is_learn)
+  try
   {
-    self->function = "learn";
-    base.learn(ex);
+    if constexpr (is_learn)
+    {
+      self->function = "learn";
+      base.learn(ex);
+    }
+    else
+    {
+      self->function = "predict";
+      base.predict(ex);
+    }
   }
-  else
+  catch (...)
   {
-    self->function = "predict";
-    base.predict(ex);
+    // A failed call must not leave its nodes active, or later calls would be taken for calls made below it.
+    if (pushed) { data.shared_debug_state->active.pop(); }
+    throw;
   }
   self->end_time = std::chrono::high_resolution_clock::now();
-  self->output_prediction = get_prediction(ex, base.get_output_prediction_type());
-  self->updated_prediction = get_updated_prediction(ex);
-  self->partial_prediction = get_partial_prediction(ex);
+  if (state.fields & vwpy::DEBUG_FIELD_OUTPUT_PREDICTION)
+  {
+    self->output_prediction = get_prediction(ex, base.get_output_prediction_type());
+  }
+  if (state.fields & vwpy::DEBUG_FIELD_UPDATED_PREDICTION) { self->updated_prediction = get_updated_prediction(ex); }
+  if (state.fields & vwpy::DEBUG_FIELD_PARTIAL_PREDICTION) { self->partial_prediction = get_partial_prediction(ex); }
   if (pushed) { data.shared_debug_state->active.pop(); }
   self->overall_end_time = std::chrono::high_resolution_clock::now();
+  if (state.sampling.has_value() && state.active.empty()) { state.add_captured(state.root); }
 }
 }  // namespace
 
+vwpy::debug_node& vwpy::debug_arena::allocate()
+{
+  if (used == nodes.size()) { nodes.emplace_back(); }
+  auto& node = nodes[used++];
+  node.children.clear();
+  return node;
+}
+
+vwpy::debug_node& vwpy::debug_data::start_tree()
+{
+  // The previous tree has been taken by the caller by now, so it only keeps its arena alive if it is still referenced
+  // elsewhere.
+  root = nullptr;
+  if (arena == nullptr || arena.use_count() > 1) { arena = std::make_shared<debug_arena>(); }
+  arena->used = 0;
+  auto& node = arena->allocate();
+  root = std::shared_ptr<debug_node>(arena, &node);
+  return node;
+}
+
+vwpy::interaction_names vwpy::debug_data::intern_interactions(
+    const std::vector<std::vector<VW::namespace_index>>& interactions)
+{
+  auto& entry = interned[&interactions];
+  if (entry.names == nullptr || entry.interactions != interactions)
+  {
+    auto names = std::make_shared<std::vector<std::string>>();
+    for (const auto& inter_list : interactions) { names->push_back(interaction_to_string(inter_list)); }
+    entry.interactions = interactions;
+    entry.names = std::move(names);
+  }
+  return entry.names;
+}
+
+void vwpy::debug_data::set_sampling(const debug_sampling& new_sampling)
+{
+  sampling = new_sampling;
+  captured.assign(new_sampling.buffer_size, nullptr);
+  next = 0;
+}
+
+bool vwpy::debug_data::should_capture()
+{
+  if (!sampling.has_value()) { return true; }
+  calls++;
+  if (sampling->every != 0) { return calls % sampling->every == 0; }
+  return std::uniform_real_distribution<float>(0.f, 1.f)(random) < sampling->probability;
+}
+
+void vwpy::debug_data::add_captured(std::shared_ptr<debug_node> tree)
+{
+  captured[next] = std::move(tree);
+  next = (next + 1) % captured.size();
+}
+
+std::vector<std::shared_ptr<vwpy::debug_node>> vwpy::debug_data::get_captured() const
+{
+  std::vector<std::shared_ptr<debug_node>> result;
+  for (size_t i = 0; i < captured.size(); i++)
+  {
+    const auto& tree = captured[(next + i) % captured.size()];
+    if (tree != nullptr) { result.push_back(tree); }
+  }
+  return result;
+}
+
+void vwpy::debug_data::clear_captured()
+{
+  std::fill(captured.begin(), captured.end(), nullptr);
+  next = 0;
+}
+
 std::shared_ptr<VW::LEARNER::learner> vwpy::debug_reduction_setup(VW::setup_base_i& stack_builder)
 {
   auto base = stack_builder.setup_base_learner();
@@ -2,29 +2,54 @@
 
 #include "label.h"
 #include "prediction.h"
+#include "vw/core/example.h"
 #include "vw/core/input_parser.h"
 #include "vw/core/learner.h"
 #include "vw/core/prediction_type.h"
 #include "vw/core/reduction_stack.h"
 
 #include <chrono>
+#include <cstdint>
+#include <deque>
 #include <memory>
+#include <optional>
+#include <random>
 #include <stack>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace vwpy
 {
 
+// The fields of the examples which are copied into each debug node. Copying the labels and predictions is most of the
+// cost of a node, so only the fields which are needed can be selected.
+enum debug_field : uint32_t
+{
+  DEBUG_FIELD_INPUT_LABELS = 1 << 0,
+  DEBUG_FIELD_OUTPUT_PREDICTION = 1 << 1,
+  DEBUG_FIELD_INTERACTIONS = 1 << 2,
+  DEBUG_FIELD_WEIGHT = 1 << 3,
+  DEBUG_FIELD_OFFSET = 1 << 4,
+  DEBUG_FIELD_PARTIAL_PREDICTION = 1 << 5,
+  DEBUG_FIELD_UPDATED_PREDICTION = 1 << 6,
+  DEBUG_FIELD_ALL = (1 << 7) - 1
+};
+
+// The interactions of an example point at a list owned by the workspace, so the names are only built once per list.
+using interaction_names = std::shared_ptr<const std::vector<std::string>>;
+
 struct debug_node
 {
   std::string name;
   std::string function;
   bool is_multiline;
   size_t num_examples;
+  // The debug_field values of the fields below which were captured. The others are left from an earlier call.
+  uint32_t fields = DEBUG_FIELD_ALL;
   prediction_t output_prediction;
   std::variant<label_variant_t, std::vector<label_variant_t>> input_labels;
-  std::variant<std::vector<std::string>, std::vector<std::vector<std::string>>> interactions;
+  std::variant<interaction_names, std::vector<interaction_names>> interactions;
   std::variant<float, std::vector<float>> weight;
   std::variant<float, std::vector<float>> partial_prediction;
   std::variant<float, std::vector<float>> updated_prediction;
@@ -55,17 +80,74 @@ struct debug_node
   {
     std::chrono::high_resolution_clock::duration self_time = end_time - start_time;
     std::chrono::high_resolution_clock::duration debug_time = (overall_end_time - overall_start_time) - self_time;
-    for (const auto& child : children) { self_time += child->calc_debug_time_recursive(); }
+    for (const auto& child : children) { debug_time += child->calc_debug_time_recursive(); }
     return debug_time;
   }
 
-  std::vector<std::shared_ptr<debug_node>> children;
+  // Nodes are owned by the debug_arena of their tree.
+  std::vector<debug_node*> children;
+};
+
+// Owns the nodes of one debug tree, which are handed out as shared_ptrs aliasing the arena so a tree is freed at once.
+// The nodes are kept for the next tree once every pointer to the arena is gone, which saves reallocating their strings
+// and vectors.
+struct debug_arena
+{
+  // A deque never moves its elements, so the nodes can point at each other.
+  std::deque<debug_node> nodes;
+  size_t used = 0;
+
+  debug_node& allocate();
+};
+
+// The interactions a list of names was built from, to detect when the list was changed since.
+struct interned_interactions
+{
+  std::vector<std::vector<VW::namespace_index>> interactions;
+  interaction_names names;
+};
+
+// Which calls into the reduction stack a debug tree is captured for, when only some are. The trees are then kept in a
+// ring buffer instead of being returned by each call.
+struct debug_sampling
+{
+  // Every nth call is captured if this is not 0.
+  uint64_t every = 0;
+  // Otherwise each call is captured with this probability.
+  float probability = 0.f;
+  // Number of the most recent trees kept.
+  size_t buffer_size = 0;
 };
 
 struct debug_data
 {
-  std::stack<std::shared_ptr<debug_node>> active;
+  std::stack<debug_node*> active;
   std::shared_ptr<debug_node> root;
+  // Holds the nodes of the current tree.
+  std::shared_ptr<debug_arena> arena;
+  uint32_t fields = DEBUG_FIELD_ALL;
+  std::unordered_map<const std::vector<std::vector<VW::namespace_index>>*, interned_interactions> interned;
+
+  // Only set when sampling. Calls which are not captured go straight to the reduction below each interceptor.
+  std::optional<debug_sampling> sampling;
+  // Set while inside a call which is not captured.
+  size_t uncaptured_depth = 0;
+  uint64_t calls = 0;
+  std::minstd_rand random{std::random_device{}()};
+  // A ring buffer of the trees of the most recent captured calls, next is where the next one is written.
+  std::vector<std::shared_ptr<debug_node>> captured;
+  size_t next = 0;
+
+  void set_sampling(const debug_sampling& sampling);
+  // Called when a call enters the reduction stack.
+  bool should_capture();
+  void add_captured(std::shared_ptr<debug_node> tree);
+  // Oldest first.
+  std::vector<std::shared_ptr<debug_node>> get_captured() const;
+  void clear_captured();
+  // Called when a call enters the reduction stack, returns the root node of its tree.
+  debug_node& start_tree();
+  interaction_names intern_interactions(const std::vector<std::vector<VW::namespace_index>>& interactions);
 };
 
 struct debug_data_stash : public VW::details::input_parser
@@ -0,0 +1,120 @@
+#include "debug_trace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+// Nodes which reentered the reduction on top of the stack overlap their siblings, see debug_transform, which can make
+// the differences between their times negative.
+int64_t to_nanoseconds(std::chrono::high_resolution_clock::duration duration)
+{
+  return std::max<int64_t>(0, std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+}
+
+std::string frame_name(const vwpy::debug_node& node) { return node.name + "(" + node.function + ")"; }
+
+void collect_stacks(const vwpy::debug_node& node, std::string& stack, std::map<std::string, int64_t>& totals)
+{
+  const size_t parent_length = stack.size();
+  if (!stack.empty()) { stack += ';'; }
+  stack += frame_name(node);
+  totals[stack] += to_nanoseconds(node.calc_self_time());
+  for (const auto& child : node.children) { collect_stacks(*child, stack, totals); }
+  stack.resize(parent_length);
+}
+
+void append_json_string(std::string& output, const std::string& value)
+{
+  output += '"';
+  for (const char c : value)
+  {
+    if (c == '"' || c == '\\')
+    {
+      output += '\\';
+      output += c;
+    }
+    else if (static_cast<unsigned char>(c) < 0x20)
+    {
+      char escaped[8];
+      std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned int>(c));
+      output += escaped;
+    }
+    else { output += c; }
+  }
+  output += '"';
+}
+
+// Trace event times are in microseconds, with fractions for finer resolution.
+void append_microseconds(std::string& output, int64_t nanoseconds)
+{
+  char formatted[32];
+  std::snprintf(formatted, sizeof(formatted), "%lld.%03lld", static_cast<long long>(nanoseconds / 1000),
+      static_cast<long long>(nanoseconds % 1000));
+  output += formatted;
+}
+
+void append_events(const vwpy::debug_node& node, int64_t start_ns, std::string& output)
+{
+  if (output.back() != '[') { output += ','; }
+  output += "{\"name\":";
+  append_json_string(output, node.name);
+  output += ",\"cat\":";
+  append_json_string(output, node.function);
+  output += ",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":";
+  append_microseconds(output, start_ns);
+  output += ",\"dur\":";
+  append_microseconds(output, to_nanoseconds(node.calc_overall_time()));
+  output += ",\"args\":{\"num_examples\":" + std::to_string(node.num_examples) + "}}";
+
+  // The gaps between the children are the node's own time, which the debug interceptors do not add to.
+  int64_t child_start_ns = start_ns;
+  auto previous_end = node.start_time;
+  for (const auto& child : node.children)
+  {
+    child_start_ns += to_nanoseconds(child->overall_start_time - previous_end);
+    append_events(*child, child_start_ns, output);
+    child_start_ns += to_nanoseconds(child->calc_overall_time());
+    previous_end = child->overall_end_time;
+  }
+}
+}  // namespace
+
+std::string vwpy::to_collapsed_stacks(const std::vector<std::shared_ptr<debug_node>>& trees)
+{
+  std::map<std::string, int64_t> totals;
+  std::string stack;
+  for (const auto& tree : trees) { collect_stacks(*tree, stack, totals); }
+
+  std::string output;
+  for (const auto& [frames, total_ns] : totals)
+  {
+    output += frames;
+    output += ' ';
+    output += std::to_string(total_ns);
+    output += '\n';
+  }
+  return output;
+}
+
+std::string vwpy::to_chrome_trace(const std::vector<std::shared_ptr<debug_node>>& trees)
+{
+  std::string output = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  if (!trees.empty())
+  {
+    const auto first_start = trees.front()->overall_start_time;
+    for (const auto& tree : trees)
+    {
+      append_events(*tree, to_nanoseconds(tree->overall_start_time - first_start), output);
+    }
+  }
+  output += "]}";
+  return output;
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "debug_reduction.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace vwpy
+{
+
+// Aggregates the trees into the collapsed stack format read by flamegraph.pl. Each line is a stack of name(function)
+// frames separated by semicolons, followed by the self time in nanoseconds of its innermost frame summed over every
+// call with that stack. The time spent in the debug interceptors is excluded.
+std::string to_collapsed_stacks(const std::vector<std::shared_ptr<debug_node>>& trees);
+
+// Writes the trees as a JSON object in the Chrome trace event format, with a complete event for each node. Each tree
+// starts when its call started, relative to the first tree. Within a tree the time spent in the debug interceptors is
+// removed, so each node lasts for its calc_overall_time and its children are laid out in the time that remains.
+std::string to_chrome_trace(const std::vector<std::shared_ptr<debug_node>>& trees);
+
+}  // namespace vwpy
@@ -0,0 +1,162 @@
+#include "example_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <unordered_map>
+
+namespace
+{
+struct prepared_registry
+{
+  std::mutex mutex;
+  std::unordered_map<const VW::example*, uint64_t> owners;
+};
+
+// Intentionally leaked so that examples released during interpreter shutdown can still use it.
+prepared_registry& get_prepared_registry()
+{
+  static auto* registry = new prepared_registry();
+  return *registry;
+}
+}  // namespace
+
+uint64_t vwpy::prepared_examples::next_workspace_id()
+{
+  static std::atomic<uint64_t> next_id{1};
+  return next_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+void vwpy::prepared_examples::mark(const VW::example& ex, uint64_t workspace_id)
+{
+  auto& registry = get_prepared_registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  registry.owners[&ex] = workspace_id;
+}
+
+uint64_t vwpy::prepared_examples::owner(const VW::example& ex)
+{
+  auto& registry = get_prepared_registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  auto it = registry.owners.find(&ex);
+  return it == registry.owners.end() ? 0 : it->second;
+}
+
+void vwpy::prepared_examples::erase(const VW::example& ex)
+{
+  auto& registry = get_prepared_registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  registry.owners.erase(&ex);
+}
+
+void vwpy::clean_example(VW::example& ec)
+{
+  for (auto& fs : ec) { fs.clear(); }
+
+  ec.pred = VW::polyprediction{};
+  ec.l = VW::polylabel{};
+  ec.ex_reduction_features.clear();
+  ec.indices.clear();
+  ec.tag.clear();
+  ec.sorted = false;
+  ec.end_pass = false;
+  ec.is_newline = false;
+  ec.ex_reduction_features.clear();
+  ec.num_features_from_interactions = 0;
+
+  // Only examples which are still prepared have interactions set here, so others never take the lock.
+  if (ec.interactions != nullptr)
+  {
+    prepared_examples::erase(ec);
+    ec.interactions = nullptr;
+    ec.extent_interactions = nullptr;
+  }
+}
+
+VW::example* vwpy::example_pool::acquire()
+{
+  std::unique_ptr<VW::example> ex;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _in_use++;
+    _high_water_mark = std::max(_high_water_mark, _in_use);
+    if (!_retained.empty())
+    {
+      _hits++;
+      ex = std::move(_retained.back());
+      _retained.pop_back();
+      return ex.release();
+    }
+    _misses++;
+  }
+  // Allocate outside of the lock.
+  return new VW::example();
+}
+
+void vwpy::example_pool::release(VW::example* ex)
+{
+  std::unique_ptr<VW::example> owned(ex);
+  clean_example(*owned);
+  std::lock_guard<std::mutex> lock(_mutex);
+  _in_use--;
+  if (_retained.size() < _max_retained) { _retained.push_back(std::move(owned)); }
+  else { _discarded++; }
+}
+
+std::shared_ptr<VW::example> vwpy::example_pool::adopt(VW::example* ex)
+{
+  auto pool = shared_from_this();
+  return std::shared_ptr<VW::example>(ex, [pool](VW::example* ptr) { pool->release(ptr); });
+}
+
+void vwpy::example_pool::trim()
+{
+  std::vector<std::unique_ptr<VW::example>> to_free;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    const size_t target = _high_water_mark > _in_use ? _high_water_mark - _in_use : 0;
+    if (_retained.size() > target)
+    {
+      to_free.insert(to_free.end(), std::make_move_iterator(_retained.begin() + target),
+          std::make_move_iterator(_retained.end()));
+      _retained.resize(target);
+    }
+    _high_water_mark = _in_use;
+  }
+  // to_free is destroyed outside of the lock.
+}
+
+void vwpy::example_pool::set_max_retained(size_t max_retained)
+{
+  std::vector<std::unique_ptr<VW::example>> to_free;
+  std::lock_guard<std::mutex> lock(_mutex);
+  _max_retained = max_retained;
+  if (_retained.size() > _max_retained)
+  {
+    to_free.insert(to_free.end(), std::make_move_iterator(_retained.begin() + _max_retained),
+        std::make_move_iterator(_retained.end()));
+    _retained.resize(_max_retained);
+  }
+}
+
+vwpy::example_pool_stats vwpy::example_pool::stats() const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  example_pool_stats result{};
+  result.hits = _hits;
+  result.misses = _misses;
+  result.discarded = _discarded;
+  result.in_use = _in_use;
+  result.retained = _retained.size();
+  result.high_water_mark = _high_water_mark;
+  result.max_retained = _max_retained;
+  for (const auto& ex : _retained)
+  {
+    result.retained_bytes += sizeof(VW::example);
+    for (const auto& fs : ex->feature_space)
+    {
+      result.retained_bytes += fs.values.capacity() * sizeof(VW::feature_value);
+      result.retained_bytes += fs.indices.capacity() * sizeof(VW::feature_index);
+    }
+  }
+  return result;
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "vw/core/example.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace vwpy
+{
+
+// Resets an example so it can be reused, keeping the memory it has already allocated. Examples which are still prepared
+// for a workspace are forgotten by prepared_examples.
+void clean_example(VW::example& ec);
+
+// Tracks examples which are left setup for a workspace between calls, see Workspace.prepare. Examples are keyed to a
+// workspace id which is never reused, so an example prepared for a destroyed workspace can't be mistaken as prepared for
+// a new one allocated at the same address. Thread safe.
+namespace prepared_examples
+{
+uint64_t next_workspace_id();
+void mark(const VW::example& ex, uint64_t workspace_id);
+// Returns 0 if the example is not prepared for any workspace.
+uint64_t owner(const VW::example& ex);
+void erase(const VW::example& ex);
+}  // namespace prepared_examples
+
+struct example_pool_stats
+{
+  // Number of acquires served from retained examples and the number which had to allocate.
+  uint64_t hits;
+  uint64_t misses;
+  // Number of released examples which were freed because the pool was already at its maximum size.
+  uint64_t discarded;
+  size_t in_use;
+  size_t retained;
+  // Approximate bytes held by retained examples including their feature buffers.
+  size_t retained_bytes;
+  // Largest number of examples in use at once since the last trim.
+  size_t high_water_mark;
+  size_t max_retained;
+};
+
+// Pool of examples which retains released examples, and their feature buffers, for reuse. Each workspace owns one so
+// that workspaces used from different threads never share a pool. Thread safe.
+class example_pool : public std::enable_shared_from_this<example_pool>
+{
+public:
+  static constexpr size_t DEFAULT_MAX_RETAINED = 4096;
+
+  explicit example_pool(size_t max_retained = DEFAULT_MAX_RETAINED) : _max_retained(max_retained) {}
+
+  example_pool(const example_pool&) = delete;
+  example_pool& operator=(const example_pool&) = delete;
+
+  // Ownership passes to the caller, who must give it back with release.
+  VW::example* acquire();
+  // Cleans the example then retains it, or frees it if max_retained examples are already retained.
+  void release(VW::example* ex);
+
+  // Takes ownership of an example obtained from acquire. The returned pointer releases it back to this pool and keeps
+  // the pool alive until then.
+  std::shared_ptr<VW::example> adopt(VW::example* ex);
+  std::shared_ptr<VW::example> acquire_shared() { return adopt(acquire()); }
+
+  // Frees retained examples beyond what is needed to reach the high water mark again, then resets the high water mark.
+  // Call after a burst to give back memory which the steady state does not need.
+  void trim();
+  // Frees retained examples if there are now more than max_retained.
+  void set_max_retained(size_t max_retained);
+  example_pool_stats stats() const;
+
+private:
+  mutable std::mutex _mutex;
+  std::vector<std::unique_ptr<VW::example>> _retained;
+  size_t _max_retained;
+  size_t _in_use = 0;
+  size_t _high_water_mark = 0;
+  uint64_t _hits = 0;
+  uint64_t _misses = 0;
+  uint64_t _discarded = 0;
+};
+
+}  // namespace vwpy
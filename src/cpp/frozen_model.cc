@@ -0,0 +1,325 @@
+#include "frozen_model.h"
+
+#include "atomic_file.h"
+#include "vw/core/array_parameters_dense.h"
+#include "vw/core/gd_predict.h"
+#include "vw/core/global_data.h"
+#include "vw/core/learner.h"
+#include "vw/core/scope_exit.h"
+#include "vw/core/shared_data.h"
+#include "vw/core/simple_label.h"
+#include "vw/io/io_adapter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+size_t align_up(size_t value, size_t alignment) { return (value + alignment - 1) / alignment * alignment; }
+
+constexpr char FROZEN_FILE_MAGIC[8] = {'V', 'W', 'P', 'Y', 'F', 'R', 'Z', 'N'};
+constexpr uint32_t FROZEN_FILE_VERSION = 1;
+constexpr size_t FROZEN_FILE_HEADER_SIZE = 48;
+// Cache line alignment, which also satisfies the alignment of every weight type.
+constexpr size_t FROZEN_FILE_WEIGHTS_ALIGNMENT = 64;
+
+// Header fields are stored in native byte order, which is little endian on every supported platform.
+template <typename T>
+void write_header_field(char* header, size_t offset, T value)
+{
+  std::memcpy(header + offset, &value, sizeof(T));
+}
+
+template <typename T>
+T read_header_field(const char* header, size_t offset)
+{
+  T value;
+  std::memcpy(&value, header + offset, sizeof(T));
+  return value;
+}
+}  // namespace
+
+std::unique_ptr<vwpy::frozen_model> vwpy::frozen_model::create_without_weights(
+    VW::workspace& ws, weight_precision precision)
+{
+  std::unique_ptr<frozen_model> model(new frozen_model());
+
+  // The prediction is computed here rather than by the reduction stack, so only a plain linear model can be frozen.
+  std::vector<std::string> enabled_learners;
+  ws.l->get_enabled_learners(enabled_learners);
+  for (const auto& name : enabled_learners)
+  {
+    if (name == "gd" || name == "count_label") { continue; }
+    if (name == "scorer-identity") { model->_link = link_function::IDENTITY; }
+    else if (name == "scorer-logistic") { model->_link = link_function::LOGISTIC; }
+    else if (name == "scorer-glf1") { model->_link = link_function::GLF1; }
+    else if (name == "scorer-poisson") { model->_link = link_function::POISSON; }
+    else
+    {
+      throw std::invalid_argument("Only linear models can be frozen, but the reduction '" + name + "' is enabled.");
+    }
+  }
+  if (ws.weights.sparse) { throw std::invalid_argument("Models with sparse weights can't be frozen."); }
+  if (ws.sd->gravity != 0.) { throw std::invalid_argument("Models trained with l1 regularization can't be frozen."); }
+
+  const auto& dense = ws.weights.dense_weights;
+  model->_precision = precision;
+  model->_weight_mask = dense.mask();
+  model->_stride_shift = dense.stride_shift();
+  model->_num_weights = (dense.mask() + 1) >> dense.stride_shift();
+  model->_weights_size = weights_size(precision, model->_num_weights);
+  model->_multiplier = static_cast<uint64_t>(ws.reduction_state.total_feature_width) << dense.stride_shift();
+  model->_add_constant = ws.feature_tweaks_config.add_constant;
+  model->_permutations = ws.feature_tweaks_config.permutations;
+  model->_ignore_some_linear = ws.feature_tweaks_config.ignore_some_linear;
+  model->_ignore_linear = ws.feature_tweaks_config.ignore_linear;
+  model->_interactions = ws.feature_tweaks_config.interactions;
+  model->_extent_interactions = ws.feature_tweaks_config.extent_interactions;
+  model->_min_label = ws.sd->min_label;
+  model->_max_label = ws.sd->max_label;
+  return model;
+}
+
+std::unique_ptr<vwpy::frozen_model> vwpy::frozen_model::create(VW::workspace& ws, weight_precision precision)
+{
+  auto model = create_without_weights(ws, precision);
+  const size_t num_weights = model->_num_weights;
+  model->_owned_weights.resize(model->_weights_size);
+  char* output = model->_owned_weights.data();
+
+  // Only the first value of each stride is the weight, the rest is adaptive and normalized state used to learn. Any
+  // pending contraction from l2 regularization is applied now.
+  const float* source = ws.weights.dense_weights.first();
+  const auto contraction = static_cast<float>(ws.sd->contraction);
+  const auto read_weight = [&](size_t i) { return source[i << model->_stride_shift] * contraction; };
+  switch (precision)
+  {
+    case weight_precision::FLOAT32:
+    {
+      auto* weights = reinterpret_cast<float*>(output);
+      for (size_t i = 0; i < num_weights; i++) { weights[i] = read_weight(i); }
+      break;
+    }
+    case weight_precision::FLOAT16:
+    {
+      auto* weights = reinterpret_cast<uint16_t*>(output);
+      for (size_t i = 0; i < num_weights; i++) { weights[i] = float_to_half(read_weight(i)); }
+      break;
+    }
+    case weight_precision::INT8:
+    {
+      // Symmetric quantization with a scale per block, so a few large weights only cost precision in their own block.
+      auto* weights = reinterpret_cast<int8_t*>(output);
+      auto* scales = reinterpret_cast<float*>(output + align_up(num_weights, sizeof(float)));
+      for (size_t block = 0; block * INT8_BLOCK_SIZE < num_weights; block++)
+      {
+        const size_t begin = block * INT8_BLOCK_SIZE;
+        const size_t end = std::min(begin + INT8_BLOCK_SIZE, num_weights);
+        float max_abs = 0.f;
+        for (size_t i = begin; i < end; i++) { max_abs = std::max(max_abs, std::fabs(read_weight(i))); }
+        const float scale = max_abs > 0.f ? max_abs / 127.f : 1.f;
+        scales[block] = scale;
+        for (size_t i = begin; i < end; i++)
+        {
+          const float quantized = std::round(read_weight(i) / scale);
+          weights[i] = static_cast<int8_t>(std::max(-127.f, std::min(127.f, quantized)));
+        }
+      }
+      break;
+    }
+  }
+  model->set_weights(output);
+  return model;
+}
+
+std::unique_ptr<vwpy::frozen_model> vwpy::frozen_model::attach(VW::workspace& ws, const frozen_model_file& file)
+{
+  auto model = create_without_weights(ws, file.precision);
+  if (model->_num_weights != file.num_weights || model->_weights_size != file.weights_size)
+  {
+    throw std::invalid_argument("The frozen weights do not match the model they were loaded with.");
+  }
+  model->_mapped_file = file.file;
+  model->set_weights(file.file->data() + file.weights_offset);
+  return model;
+}
+
+size_t vwpy::frozen_model::weights_size(weight_precision precision, size_t num_weights)
+{
+  switch (precision)
+  {
+    case weight_precision::FLOAT16:
+      return num_weights * sizeof(uint16_t);
+    case weight_precision::INT8:
+      return align_up(num_weights, sizeof(float)) +
+          (num_weights + INT8_BLOCK_SIZE - 1) / INT8_BLOCK_SIZE * sizeof(float);
+    default:
+      return num_weights * sizeof(float);
+  }
+}
+
+void vwpy::frozen_model::set_weights(const char* weights)
+{
+  switch (_precision)
+  {
+    case weight_precision::FLOAT32:
+      _float_weights = reinterpret_cast<const float*>(weights);
+      break;
+    case weight_precision::FLOAT16:
+      _half_weights = reinterpret_cast<const uint16_t*>(weights);
+      break;
+    case weight_precision::INT8:
+      _int8_weights = reinterpret_cast<const int8_t*>(weights);
+      _int8_scales = reinterpret_cast<const float*>(weights + align_up(_num_weights, sizeof(float)));
+      break;
+  }
+}
+
+void vwpy::frozen_model::save(const std::string& path, const char* model_data, size_t model_size) const
+{
+  const uint64_t weights_offset = align_up(FROZEN_FILE_HEADER_SIZE + model_size, FROZEN_FILE_WEIGHTS_ALIGNMENT);
+  char header[FROZEN_FILE_HEADER_SIZE] = {};
+  std::memcpy(header, FROZEN_FILE_MAGIC, sizeof(FROZEN_FILE_MAGIC));
+  write_header_field(header, 8, FROZEN_FILE_VERSION);
+  write_header_field(header, 12, static_cast<uint32_t>(_precision));
+  write_header_field(header, 16, static_cast<uint64_t>(_num_weights));
+  write_header_field(header, 24, static_cast<uint64_t>(model_size));
+  write_header_field(header, 32, weights_offset);
+  write_header_field(header, 40, static_cast<uint64_t>(_weights_size));
+
+  const char* weights = _float_weights != nullptr ? reinterpret_cast<const char*>(_float_weights)
+      : _half_weights != nullptr                  ? reinterpret_cast<const char*>(_half_weights)
+                                                  : reinterpret_cast<const char*>(_int8_weights);
+  const std::vector<char> padding(weights_offset - FROZEN_FILE_HEADER_SIZE - model_size, 0);
+  auto writer = VW::io::open_file_writer(path);
+  vwpy::write_all(*writer, header, sizeof(header));
+  vwpy::write_all(*writer, model_data, model_size);
+  vwpy::write_all(*writer, padding.data(), padding.size());
+  vwpy::write_all(*writer, weights, _weights_size);
+  writer->flush();
+}
+
+vwpy::frozen_model_file vwpy::frozen_model_file::open(const std::string& path)
+{
+  frozen_model_file result{};
+  auto file = mapped_file::open(path);
+  const char* data = file->data();
+  if (file->size() < FROZEN_FILE_HEADER_SIZE || std::memcmp(data, FROZEN_FILE_MAGIC, sizeof(FROZEN_FILE_MAGIC)) != 0)
+  {
+    throw std::invalid_argument("'" + path + "' is not a frozen model file.");
+  }
+  if (read_header_field<uint32_t>(data, 8) != FROZEN_FILE_VERSION)
+  {
+    throw std::invalid_argument("'" + path + "' was written by an unsupported version.");
+  }
+  const auto precision = read_header_field<uint32_t>(data, 12);
+  if (precision > static_cast<uint32_t>(weight_precision::INT8))
+  {
+    throw std::invalid_argument("'" + path + "' has an unknown weight precision.");
+  }
+  result.precision = static_cast<weight_precision>(precision);
+  result.num_weights = read_header_field<uint64_t>(data, 16);
+  result.model_size = read_header_field<uint64_t>(data, 24);
+  result.weights_offset = read_header_field<uint64_t>(data, 32);
+  result.weights_size = read_header_field<uint64_t>(data, 40);
+  if (result.weights_offset < FROZEN_FILE_HEADER_SIZE ||
+      result.model_size > result.weights_offset - FROZEN_FILE_HEADER_SIZE ||
+      result.weights_offset % FROZEN_FILE_WEIGHTS_ALIGNMENT != 0 || result.weights_offset > file->size() ||
+      result.weights_size > file->size() - result.weights_offset)
+  {
+    throw std::invalid_argument("'" + path + "' is truncated or corrupt.");
+  }
+  result.model_data = data + FROZEN_FILE_HEADER_SIZE;
+  result.file = std::move(file);
+  return result;
+}
+
+float vwpy::frozen_model::weight(uint64_t index) const
+{
+  const uint64_t i = (index & _weight_mask) >> _stride_shift;
+  switch (_precision)
+  {
+    case weight_precision::FLOAT16:
+      return half_to_float(_half_weights[i]);
+    case weight_precision::INT8:
+      return static_cast<float>(_int8_weights[i]) * _int8_scales[i / INT8_BLOCK_SIZE];
+    default:
+      return _float_weights[i];
+  }
+}
+
+void vwpy::frozen_model::accumulate(prediction_state& state, float value, uint64_t index)
+{
+  state.sum += value * state.model->weight(index);
+}
+
+float vwpy::frozen_model::predict(VW::example& ex, feature_counts* counts) const
+{
+  if (ex.interactions != nullptr)
+  {
+    throw std::invalid_argument("Prepared examples can't be used with a frozen workspace, unprepare them first.");
+  }
+
+  // The same steps as setting up an example for a workspace, undone on the way out.
+  if (_add_constant)
+  {
+    ex.indices.push_back(VW::details::CONSTANT_NAMESPACE);
+    ex.feature_space[VW::details::CONSTANT_NAMESPACE].push_back(
+        1.f, VW::details::CONSTANT, VW::details::CONSTANT_NAMESPACE);
+  }
+  if (_multiplier != 1)
+  {
+    for (auto& fs : ex)
+    {
+      for (auto& index : fs.indices) { index *= _multiplier; }
+    }
+  }
+  auto restore = VW::scope_exit(
+      [&]()
+      {
+        if (_multiplier != 1)
+        {
+          for (auto& fs : ex)
+          {
+            for (auto& index : fs.indices) { index /= _multiplier; }
+          }
+        }
+        if (_add_constant)
+        {
+          ex.feature_space[VW::details::CONSTANT_NAMESPACE].clear();
+          ex.indices.pop_back();
+        }
+      });
+
+  thread_local VW::details::generate_interactions_object_cache cache;
+  auto ignore_linear = _ignore_linear;
+  size_t num_interacted_features = 0;
+  prediction_state state{this, ex.ex_reduction_features.get<VW::simple_label_reduction_features>().initial};
+  VW::foreach_feature<prediction_state, uint64_t, accumulate>(*this, _ignore_some_linear, ignore_linear, _interactions,
+      _extent_interactions, _permutations, ex, state, num_interacted_features, cache);
+  if (counts != nullptr)
+  {
+    counts->features = 0;
+    for (const auto& fs : ex) { counts->features += fs.size(); }
+    counts->interacted_features = num_interacted_features;
+  }
+
+  // Equivalent to the clamping done by gd followed by the link applied by the scorer.
+  float prediction = state.sum;
+  if (std::isnan(prediction)) { prediction = 0.f; }
+  prediction = std::max(_min_label, std::min(_max_label, prediction));
+  switch (_link)
+  {
+    case link_function::LOGISTIC:
+      return 1.f / (1.f + std::exp(-prediction));
+    case link_function::GLF1:
+      return 2.f / (1.f + std::exp(-prediction)) - 1.f;
+    case link_function::POISSON:
+      return std::exp(prediction);
+    default:
+      return prediction;
+  }
+}
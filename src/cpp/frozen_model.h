@@ -0,0 +1,130 @@
+#pragma once
+
+#include "mapped_file.h"
+#include "vw/core/constant.h"
+#include "vw/core/example.h"
+#include "vw/core/vw_fwd.h"
+#include "weight_precision.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace vwpy
+{
+
+// A file written by frozen_model::save. It holds the model without its weights, which is used to create the workspace,
+// followed by the frozen weights laid out exactly as they are used. All values are little endian.
+struct frozen_model_file
+{
+  // Throws if the file is not a frozen model file.
+  static frozen_model_file open(const std::string& path);
+
+  std::shared_ptr<const mapped_file> file;
+  weight_precision precision;
+  uint64_t num_weights;
+  // The serialized model, without weights.
+  const char* model_data;
+  size_t model_size;
+  // The frozen weights, at an offset aligned to 64 bytes.
+  size_t weights_offset;
+  size_t weights_size;
+};
+
+// Features seen by one call to frozen_model::predict.
+struct feature_counts
+{
+  uint64_t features = 0;
+  uint64_t interacted_features = 0;
+};
+
+// Inference only copy of a linear model. Only the weights are kept, without the per weight state used for learning,
+// packed into a contiguous array and optionally quantized. Predicting does not modify the model, so any number of
+// threads may predict concurrently without locking.
+class frozen_model
+{
+public:
+  // Throws if the reduction stack of the workspace is anything other than a linear model.
+  static std::unique_ptr<frozen_model> create(VW::workspace& ws, weight_precision precision);
+  // Uses the weights of a frozen model file in place, so processes which attach the same file share one copy of the
+  // weights in memory. The workspace must have been created from the file's model data.
+  static std::unique_ptr<frozen_model> attach(VW::workspace& ws, const frozen_model_file& file);
+
+  frozen_model(const frozen_model&) = delete;
+  frozen_model& operator=(const frozen_model&) = delete;
+
+  // Equivalent to predict with the workspace this was created from. The feature indices of the example are rewritten
+  // for the duration of the call, so an example must not be used by two calls at once. If given, counts are set to the
+  // number of features of the example, including the constant feature, and the number generated by interactions.
+  float predict(VW::example& ex, feature_counts* counts = nullptr) const;
+
+  weight_precision precision() const { return _precision; }
+  size_t num_weights() const { return _num_weights; }
+  // Memory used by the weights, including quantization scales.
+  size_t weights_bytes() const { return _weights_size; }
+  // True if the weights are in a mapped frozen model file rather than owned by this model.
+  bool is_mapped() const { return _mapped_file != nullptr; }
+
+  // Writes a frozen model file. model_data is the serialized model, which should not contain the weights. Throws if any
+  // write is short.
+  void save(const std::string& path, const char* model_data, size_t model_size) const;
+
+private:
+  enum class link_function
+  {
+    IDENTITY,
+    LOGISTIC,
+    GLF1,
+    POISSON
+  };
+
+  static constexpr size_t INT8_BLOCK_SIZE = 64;
+
+  struct prediction_state
+  {
+    const frozen_model* model;
+    float sum;
+  };
+
+  frozen_model() = default;
+
+  // Reads everything except the weights from the workspace.
+  static std::unique_ptr<frozen_model> create_without_weights(VW::workspace& ws, weight_precision precision);
+  // Size of the weights, followed by the int8 scales if any.
+  static size_t weights_size(weight_precision precision, size_t num_weights);
+  // Points the weight arrays into a block laid out as described by weights_size.
+  void set_weights(const char* weights);
+
+  float weight(uint64_t index) const;
+  static void accumulate(prediction_state& state, float value, uint64_t index);
+
+  weight_precision _precision = weight_precision::FLOAT32;
+  size_t _num_weights = 0;
+  size_t _weights_size = 0;
+  // Only one of these is used depending on the precision. They point into either _owned_weights or _mapped_file.
+  const float* _float_weights = nullptr;
+  const uint16_t* _half_weights = nullptr;
+  const int8_t* _int8_weights = nullptr;
+  // One scale for each block of INT8_BLOCK_SIZE int8 weights.
+  const float* _int8_scales = nullptr;
+  std::vector<char> _owned_weights;
+  std::shared_ptr<const mapped_file> _mapped_file;
+
+  uint64_t _weight_mask = 0;
+  uint32_t _stride_shift = 0;
+  uint64_t _multiplier = 1;
+  bool _add_constant = true;
+  bool _permutations = false;
+  bool _ignore_some_linear = false;
+  std::array<bool, VW::NUM_NAMESPACES> _ignore_linear{};
+  std::vector<std::vector<VW::namespace_index>> _interactions;
+  std::vector<std::vector<VW::extent_term>> _extent_interactions;
+  float _min_label = 0.f;
+  float _max_label = 0.f;
+  link_function _link = link_function::IDENTITY;
+};
+
+}  // namespace vwpy
@@ -1,8 +1,20 @@
+#include "atomic_file.h"
+#include "checkpoint.h"
 #include "debug_reduction.h"
+#include "debug_trace.h"
+#include "example_pool.h"
+#include "frozen_model.h"
 #include "label.h"
+#include "mapped_file.h"
+#include "matrix_parser.h"
 #include "prediction.h"
+#include "profile_reduction.h"
+#include "sparse_delta.h"
+#include "sparse_delta_encoding.h"
+#include "spsc_queue.h"
 #include "vw/common/text_utils.h"
 #include "vw/config/options_cli.h"
+#include "vw/core/action_score.h"
 #include "vw/core/array_parameters.h"
 #include "vw/core/array_parameters_dense.h"
 #include "vw/core/cache.h"
@@ -27,8 +39,10 @@
 #include "vw/core/parse_example.h"
 #include "vw/core/parse_regressor.h"
 #include "vw/core/prediction_type.h"
+#include "vw/core/prob_dist_cont.h"
 #include "vw/core/reduction_stack.h"
 #include "vw/core/scope_exit.h"
+#include "vw/core/shared_data.h"
 #include "vw/core/simple_label.h"
 #include "vw/core/v_array.h"
 #include "vw/core/version.h"
@@ -38,6 +52,7 @@
 #include "vw/io/logger.h"
 #include "vw/json_parser/decision_service_utils.h"
 #include "vw/json_parser/parse_example_json.h"
+#include "workspace_counters.h"
 
 #include <pybind11/cast.h>
 #include <pybind11/numpy.h>
@@ -46,11 +61,28 @@
 #include <pybind11/stl.h>
 #include <sys/types.h>
 
+#ifdef _WIN32
+#  include <io.h>
+#else
+#  include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cfloat>
 #include <chrono>
 #include <csignal>
+#include <cstring>
+#include <exception>
+#include <functional>
 #include <iostream>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <thread>
+#include <utility>
 #include <variant>
 
 #define STRINGIFY(x) #x
@@ -72,10 +104,20 @@ overloaded(Ts...) -> overloaded<Ts...>;
 class python_reader : public VW::io::reader
 {
 public:
-  python_reader(py::object file) : VW::io::reader(false), _file(file) {}
+  python_reader(py::object file)
+      : VW::io::reader(false), _file(file), _has_readinto(py::hasattr(_file, "readinto"))
+  {
+  }
 
   ssize_t read(char* buffer, size_t num_bytes) override
   {
+    // Binary files can read straight into the destination instead of allocating a bytes object for every read.
+    if (_has_readinto)
+    {
+      auto res = _file.attr("readinto")(py::memoryview::from_memory(buffer, static_cast<ssize_t>(num_bytes)));
+      // None means a non blocking file had nothing to read.
+      return res.is_none() ? 0 : res.cast<ssize_t>();
+    }
     auto read_func = _file.attr("read");
     auto res = read_func(num_bytes);
     auto bytes = res.cast<py::bytes>();
@@ -86,8 +128,11 @@ public:
 
 private:
   py::object _file;
+  bool _has_readinto;
 };
 
+// The GIL is acquired for each call, so this can be written to while serializing a model with the GIL released. It must
+// still be destroyed with the GIL held.
 class python_writer : public VW::io::writer
 {
 public:
@@ -95,113 +140,149 @@ public:
 
   ssize_t write(const char* buffer, size_t num_bytes) override
   {
+    py::gil_scoped_acquire acquire;
     auto res = _file.attr("write")(py::bytes(buffer, num_bytes));
     return res.cast<ssize_t>();
   }
 
-  void flush() override { _file.attr("flush")(); }
+  void flush() override
+  {
+    py::gil_scoped_acquire acquire;
+    _file.attr("flush")();
+  }
 
 private:
   py::object _file;
 };
 
-// This is a global object pool for examples.
-static VW::object_pool<VW::example> SHARED_EXAMPLE_POOL;
+using vwpy::clean_example;
+
+// Pool for examples created from Python without a workspace. Everything else uses the pool of its workspace.
+const std::shared_ptr<vwpy::example_pool> DEFAULT_EXAMPLE_POOL = std::make_shared<vwpy::example_pool>();
 
-void clean_example(VW::example& ec)
+// Impl from VW. Returns the size of the header in bytes.
+size_t read_cache_header(VW::io::reader& cache_reader)
 {
-  for (auto& fs : ec) { fs.clear(); }
+  size_t version_buffer_length;
+  if (static_cast<size_t>(cache_reader.read(reinterpret_cast<char*>(&version_buffer_length),
+          sizeof(version_buffer_length))) < sizeof(version_buffer_length))
+  {
+    THROW("failed to read: version_buffer_length");
+  }
 
-  ec.pred = VW::polyprediction{};
-  ec.l = VW::polylabel{};
-  ec.ex_reduction_features.clear();
-  ec.indices.clear();
-  ec.tag.clear();
-  ec.sorted = false;
-  ec.end_pass = false;
-  ec.is_newline = false;
-  ec.ex_reduction_features.clear();
-  ec.num_features_from_interactions = 0;
-}
+  if (version_buffer_length > 61) THROW("cache version too long, cache file is probably invalid");
+  if (version_buffer_length == 0) THROW("cache version too short, cache file is probably invalid");
 
-std::shared_ptr<VW::example> get_example_from_pool()
-{
-  return std::shared_ptr<VW::example>(SHARED_EXAMPLE_POOL.get_object().release(),
-      [](VW::example* ptr)
-      {
-        clean_example(*ptr);
-        SHARED_EXAMPLE_POOL.return_object(ptr);
-      });
+  std::vector<char> version_buffer(version_buffer_length);
+  if (static_cast<size_t>(cache_reader.read(version_buffer.data(), version_buffer_length)) < version_buffer_length)
+  {
+    THROW("failed to read: version buffer");
+  }
+  VW::version_struct cache_version(version_buffer.data());
+  if (cache_version != VW::VERSION)
+  {
+    auto msg = fmt::format(
+        "Cache file version does not match current VW version. Cache files must be produced by the version consuming "
+        "them. Cache version: {} VW version: {}",
+        cache_version.to_string(), VW::VERSION.to_string());
+    THROW(msg);
+  }
+
+  char marker;
+  if (static_cast<size_t>(cache_reader.read(&marker, sizeof(marker))) < sizeof(marker)) { THROW("failed to read"); }
+
+  if (marker != 'c') THROW("data file is not a cache file");
+
+  uint32_t cache_numbits;
+  if (static_cast<size_t>(cache_reader.read(reinterpret_cast<char*>(&cache_numbits), sizeof(cache_numbits))) <
+      sizeof(cache_numbits))
+  {
+    THROW("failed to read");
+  }
+
+  // TODO: consider validating the number of bits
+  return sizeof(version_buffer_length) + version_buffer_length + sizeof(marker) + sizeof(cache_numbits);
 }
 
+// Reads cache examples either through a Python file object or from a memory mapped file. The mapped form avoids
+// calling into Python for each chunk and supports seeking to the offset of any example, for example one recorded with
+// tell() on an earlier pass.
 struct cache_reader
 {
-  cache_reader(std::shared_ptr<VW::workspace> workspace, py::object file) : _workspace(workspace), _file(file)
+  cache_reader(std::shared_ptr<VW::workspace> workspace, std::shared_ptr<vwpy::example_pool> pool, py::object file)
+      : _file(file), _workspace(workspace), _pool(std::move(pool))
   {
     auto reader = VW::make_unique<python_reader>(file);
-    read_cache_header(*reader);
-    _buffer.add_file(std::move(reader));
+    _offset = read_cache_header(*reader);
+    _buffer = VW::make_unique<VW::io_buf>();
+    _buffer->add_file(std::move(reader));
+  }
+
+  cache_reader(std::shared_ptr<VW::workspace> workspace, std::shared_ptr<vwpy::example_pool> pool,
+      std::shared_ptr<vwpy::mapped_file> mapped_file)
+      : _mapped_file(std::move(mapped_file)), _workspace(workspace), _pool(std::move(pool))
+  {
+    _mapped_file->advise_sequential();
+    vwpy::mapped_file_reader header_reader(_mapped_file, 0);
+    _header_size = read_cache_header(header_reader);
+    reset_mapped_buffer(_header_size);
   }
 
   std::shared_ptr<VW::example> read_cache_example()
   {
     VW::multi_ex examples;
-    auto return_value = get_example_from_pool();
+    auto return_value = _pool->acquire_shared();
     examples.push_back(return_value.get());
 
-    auto bytes_read = VW::parsers::cache::read_example_from_cache(_workspace.get(), _buffer, examples);
+    size_t bytes_read = 0;
+    if (_mapped_file != nullptr)
+    {
+      // Nothing below touches Python when reading from the mapping, so page faults don't block other threads.
+      py::gil_scoped_release release;
+      bytes_read = VW::parsers::cache::read_example_from_cache(_workspace.get(), *_buffer, examples);
+    }
+    else { bytes_read = VW::parsers::cache::read_example_from_cache(_workspace.get(), *_buffer, examples); }
     if (bytes_read == 0) { return nullptr; }
 
+    _offset += bytes_read;
     return return_value;
   }
 
-private:
-  // Impl from VW
-  void read_cache_header(VW::io::reader& cache_reader)
-  {
-    size_t version_buffer_length;
-    if (static_cast<size_t>(cache_reader.read(reinterpret_cast<char*>(&version_buffer_length),
-            sizeof(version_buffer_length))) < sizeof(version_buffer_length))
-    {
-      THROW("failed to read: version_buffer_length");
-    }
+  // Offset in the file of the next example to be read.
+  size_t tell() const { return _offset; }
 
-    if (version_buffer_length > 61) THROW("cache version too long, cache file is probably invalid");
-    if (version_buffer_length == 0) THROW("cache version too short, cache file is probably invalid");
-
-    std::vector<char> version_buffer(version_buffer_length);
-    if (static_cast<size_t>(cache_reader.read(version_buffer.data(), version_buffer_length)) < version_buffer_length)
-    {
-      THROW("failed to read: version buffer");
-    }
-    VW::version_struct cache_version(version_buffer.data());
-    if (cache_version != VW::VERSION)
+  void seek(size_t offset)
+  {
+    if (_mapped_file == nullptr) { THROW("Seeking is only supported when reading a cache file from a path."); }
+    if (offset < _header_size || offset > _mapped_file->size())
     {
-      auto msg = fmt::format(
-          "Cache file version does not match current VW version. Cache files must be produced by the version consuming "
-          "them. Cache version: {} VW version: {}",
-          cache_version.to_string(), VW::VERSION.to_string());
-      THROW(msg);
+      throw std::out_of_range(fmt::format("Offset {} is outside of the examples in the cache file.", offset));
     }
-
-    char marker;
-    if (static_cast<size_t>(cache_reader.read(&marker, sizeof(marker))) < sizeof(marker)) { THROW("failed to read"); }
-
-    if (marker != 'c') THROW("data file is not a cache file");
-
-    uint32_t cache_numbits;
-    if (static_cast<size_t>(cache_reader.read(reinterpret_cast<char*>(&cache_numbits), sizeof(cache_numbits))) <
-        sizeof(cache_numbits))
+    if (!_seeked)
     {
-      THROW("failed to read");
+      // Seeking usually means shuffled access so read ahead would be wasted.
+      _mapped_file->advise_random();
+      _seeked = true;
     }
+    reset_mapped_buffer(offset);
+  }
 
-    // TODO: consider validating the number of bits
+private:
+  void reset_mapped_buffer(size_t offset)
+  {
+    _buffer = VW::make_unique<VW::io_buf>();
+    _buffer->add_file(VW::make_unique<vwpy::mapped_file_reader>(_mapped_file, offset));
+    _offset = offset;
   }
 
   py::object _file;
-  VW::io_buf _buffer;
+  std::shared_ptr<vwpy::mapped_file> _mapped_file;
+  size_t _header_size = 0;
+  bool _seeked = false;
+  size_t _offset = 0;
+  std::unique_ptr<VW::io_buf> _buffer;
   std::shared_ptr<VW::workspace> _workspace;
+  std::shared_ptr<vwpy::example_pool> _pool;
 };
 
 struct logger_context
@@ -210,26 +291,121 @@ struct logger_context
   py::object log_logger;
 };
 
+// Written under the workspace lock and read without it.
+struct checkpoint_pause_stats
+{
+  std::atomic<uint64_t> count{0};
+  std::atomic<uint64_t> last_pause_ns{0};
+  std::atomic<uint64_t> max_pause_ns{0};
+  std::atomic<uint64_t> total_pause_ns{0};
+
+  void record_pause(std::chrono::steady_clock::duration pause)
+  {
+    const auto pause_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(pause).count());
+    count.fetch_add(1, std::memory_order_relaxed);
+    last_pause_ns.store(pause_ns, std::memory_order_relaxed);
+    max_pause_ns.store(std::max(max_pause_ns.load(std::memory_order_relaxed), pause_ns), std::memory_order_relaxed);
+    total_pause_ns.fetch_add(pause_ns, std::memory_order_relaxed);
+  }
+};
+
 struct workspace_with_logger_contexts
 {
   std::unique_ptr<logger_context> logger_context_ptr;
   std::shared_ptr<VW::workspace> workspace_ptr;
+  // Never reused, identifies the workspace examples are prepared for.
+  const uint64_t id = vwpy::prepared_examples::next_workspace_id();
+  // Examples parsed for this workspace come from and return to this pool.
+  std::shared_ptr<vwpy::example_pool> example_pool = std::make_shared<vwpy::example_pool>();
+  // The arguments the workspace was created with, which clone creates its copies with.
+  std::vector<std::string> args;
+  bool record_feature_names = false;
+  bool record_metrics = false;
   bool debug;
+  // Set if debug trees are captured for a sample of calls, which are then kept by the debug reduction rather than
+  // returned. debug is false in that case.
+  std::optional<vwpy::debug_sampling> debug_sampling;
+  // The debug_field values of the fields captured by the debug tree, when it is enabled.
+  uint32_t debug_fields = vwpy::DEBUG_FIELD_ALL;
+  // Set if the workspace was created with profiling, the counters of its profiling interceptors.
+  std::shared_ptr<vwpy::profile_data> profile;
+  // Set if the workspace was created with record_counters.
+  std::unique_ptr<vwpy::workspace_counters> counters;
+  checkpoint_pause_stats checkpoint_stats;
+  // Set once by freeze. Predictions then use this copy of the model without taking the lock, and everything else which
+  // needs the full model is rejected.
+  std::unique_ptr<vwpy::frozen_model> frozen_model;
+  std::atomic<const vwpy::frozen_model*> frozen{nullptr};
+  // Created by learn_parallel, these share the weights of the workspace so each thread can learn with its own reduction
+  // stack.
+  std::vector<std::unique_ptr<VW::workspace>> hogwild_replicas;
+  // Held by each workspace which shares its weights with another, from clone(share_weights=True) until it copies the
+  // weights before it first changes them.
+  std::shared_ptr<const void> shared_weights;
+  // Calls which run the reduction stack or read the model do so with the GIL released, this serializes them per
+  // workspace so that independent workspaces can be used from different threads concurrently.
+  mutable std::mutex mutex;
 };
 
+const vwpy::frozen_model* get_frozen_model(const workspace_with_logger_contexts& workspace)
+{
+  return workspace.frozen.load(std::memory_order_acquire);
+}
+
+void check_not_frozen(const workspace_with_logger_contexts& workspace)
+{
+  if (get_frozen_model(workspace) != nullptr)
+  {
+    THROW("This workspace has been frozen for inference and only supports prediction.");
+  }
+}
+
+// Run the given function with the GIL released while holding the workspace lock. The GIL must be released before the
+// lock is taken, otherwise we could deadlock with a thread which holds the lock and is waiting on the GIL to log.
+// Nothing in func may touch Python objects. Frozen workspaces are rejected, they never run the reduction stack.
+template <typename FuncT>
+auto run_without_gil(const workspace_with_logger_contexts& workspace, FuncT&& func) -> decltype(func())
+{
+  py::gil_scoped_release release;
+  std::lock_guard<std::mutex> lock(workspace.mutex);
+  // Checked under the lock so a call which was waiting while the workspace was frozen can't use the released weights.
+  check_not_frozen(workspace);
+  return func();
+}
+
+// Gives the workspace a copy of the weights it shares with a clone, before it changes them. Calls which may change the
+// weights call this first. Must be called from within run_without_gil.
+void own_weights(workspace_with_logger_contexts& workspace)
+{
+  if (workspace.shared_weights == nullptr) { return; }
+  // The others holding it may have copied the weights already, in which case this workspace is the last to use them.
+  if (workspace.shared_weights.use_count() > 1)
+  {
+    auto& dense = workspace.workspace_ptr->weights.dense_weights;
+    VW::dense_parameters copy((dense.mask() + 1) >> dense.stride_shift(), dense.stride_shift());
+    std::memcpy(copy.first(), dense.first(), (dense.mask() + 1) * sizeof(float));
+    dense = std::move(copy);
+    // The replicas would otherwise keep learning on the shared weights.
+    workspace.hogwild_replicas.clear();
+  }
+  workspace.shared_weights.reset();
+}
+
 // TODO capture audit logs and send to their own log stream
 void driver_log(void* context, const std::string& message)
 {
-  // We don't need to take the GIL here because all C++ should be driven by
-  // Python and not a background thread.
+  // Learn and predict release the GIL and train_from_file parses on a background thread, so this may be called without
+  // it held or from a thread which Python did not create.
+  py::gil_scoped_acquire acquire;
   py::object& driver_logger = static_cast<logger_context*>(context)->driver_logger;
   driver_logger.attr("info")(message);
 }
 
 void log_log(void* context, VW::io::log_level level, const std::string& message)
 {
-  // We don't need to take the GIL here because all C++ should be driven by
-  // Python and not a background thread.
+  // Learn and predict release the GIL and train_from_file parses on a background thread, so this may be called without
+  // it held or from a thread which Python did not create.
+  py::gil_scoped_acquire acquire;
   py::object& log_logger = static_cast<logger_context*>(context)->log_logger;
   switch (level)
   {
@@ -256,22 +432,64 @@ void log_log(void* context, VW::io::log_level level, const std::string& message)
   }
 }
 
-std::shared_ptr<VW::example> parse_text_line(workspace_with_logger_contexts& workspace, std::string_view line)
+// Decides where the examples used by the parsing functions below come from. This lets the same parsing code be used
+// with the pool of a workspace and with the examples owned by a background parsing pipeline.
+struct example_allocator
 {
-  auto ex = get_example_from_pool();
-  VW::parsers::text::read_line(*workspace.workspace_ptr, ex.get(), line);
-  return ex;
+  std::function<VW::example*()> get;
+  // Must clean the example before it is reused.
+  std::function<void(VW::example*)> release;
+};
+
+example_allocator pool_allocator(const std::shared_ptr<vwpy::example_pool>& pool)
+{
+  return example_allocator{
+      [pool]() { return pool->acquire(); }, [pool](VW::example* ex) { pool->release(ex); }};
 }
 
-std::vector<std::shared_ptr<VW::example>> parse_dsjson_line(
-    workspace_with_logger_contexts& workspace, std::string_view line)
+// Examples are owned by owned_examples and reused once released. Not thread safe.
+example_allocator reusing_allocator(
+    std::vector<std::unique_ptr<VW::example>>& owned_examples, std::vector<VW::example*>& spare_examples)
 {
-  auto ex = get_example_from_pool();
+  return example_allocator{[&owned_examples, &spare_examples]() -> VW::example*
+      {
+        if (spare_examples.empty())
+        {
+          owned_examples.push_back(VW::make_unique<VW::example>());
+          return owned_examples.back().get();
+        }
+        auto* ex = spare_examples.back();
+        spare_examples.pop_back();
+        return ex;
+      },
+      [&spare_examples](VW::example* ex)
+      {
+        clean_example(*ex);
+        spare_examples.push_back(ex);
+      }};
+}
 
-  VW::multi_ex examples;
-  examples.push_back(SHARED_EXAMPLE_POOL.get_object().release());
+std::vector<std::shared_ptr<VW::example>> adopt_pooled_examples(vwpy::example_pool& pool, const VW::multi_ex& examples)
+{
+  std::vector<std::shared_ptr<VW::example>> result;
+  result.reserve(examples.size());
+  for (auto* ex : examples) { result.push_back(pool.adopt(ex)); }
+  return result;
+}
+
+void release_examples(const example_allocator& allocator, VW::multi_ex& examples)
+{
+  for (auto* ex : examples) { allocator.release(ex); }
+  examples.clear();
+}
+
+// Parses into examples, which must be empty. On failure all examples are released back to the allocator.
+void read_dsjson_line(
+    VW::workspace& workspace, std::string_view line, VW::multi_ex& examples, const example_allocator& allocator)
+{
+  examples.push_back(allocator.get());
 
-  auto example_factory = []() -> VW::example& { return *SHARED_EXAMPLE_POOL.get_object().release(); };
+  auto example_factory = [&allocator]() -> VW::example& { return *allocator.get(); };
 
   VW::parsers::json::decision_service_interaction interaction;
   try
@@ -285,56 +503,35 @@ std::vector<std::shared_ptr<VW::example>> parse_dsjson_line(
     // input does not necessarily have a null terminator.
 
     bool result;
-    if (workspace.workspace_ptr->output_config.audit || workspace.workspace_ptr->output_config.hash_inv)
+    if (workspace.output_config.audit || workspace.output_config.hash_inv)
     {
       result = VW::parsers::json::read_line_decision_service_json<true>(
-          *workspace.workspace_ptr, examples, owned_str.data(), owned_str.size(), false, example_factory, &interaction);
+          workspace, examples, owned_str.data(), owned_str.size(), false, example_factory, &interaction);
     }
     else
     {
       result = VW::parsers::json::read_line_decision_service_json<false>(
-          *workspace.workspace_ptr, examples, owned_str.data(), owned_str.size(), false, example_factory, &interaction);
+          workspace, examples, owned_str.data(), owned_str.size(), false, example_factory, &interaction);
     }
 
     // Since we are using strict parse any errors should be surfaced via an exception.
     assert(result);
   }
-  catch (const VW::vw_exception& ex)
+  catch (...)
   {
-    for (auto* ex : examples)
-    {
-      clean_example(*ex);
-      SHARED_EXAMPLE_POOL.return_object(ex);
-    }
+    release_examples(allocator, examples);
     throw;
   }
-
-  std::vector<std::shared_ptr<VW::example>> result;
-  result.reserve(examples.size());
-  for (auto* ex : examples)
-  {
-    result.emplace_back(ex,
-        [](VW::example* ex)
-        {
-          clean_example(*ex);
-          SHARED_EXAMPLE_POOL.return_object(ex);
-        });
-  }
-
-  return result;
 }
 
-std::vector<std::shared_ptr<VW::example>> parse_json_line(
-    workspace_with_logger_contexts& workspace, std::string_view line)
+// Parses into examples, which must be empty. On failure all examples are released back to the allocator.
+void read_json_line(
+    VW::workspace& workspace, std::string_view line, VW::multi_ex& examples, const example_allocator& allocator)
 {
-  auto ex = get_example_from_pool();
-
-  VW::multi_ex examples;
-  examples.push_back(SHARED_EXAMPLE_POOL.get_object().release());
+  examples.push_back(allocator.get());
 
-  auto example_factory = []() -> VW::example& { return *SHARED_EXAMPLE_POOL.get_object().release(); };
+  auto example_factory = [&allocator]() -> VW::example& { return *allocator.get(); };
 
-  VW::parsers::json::decision_service_interaction interaction;
   try
   {
     // Must copy as the input is destructively parsed.
@@ -343,190 +540,917 @@ std::vector<std::shared_ptr<VW::example>> parse_json_line(
     std::memcpy(owned_str.data(), line.data(), line.size());
     owned_str[line.size()] = '\0';
 
-    if (workspace.workspace_ptr->output_config.audit || workspace.workspace_ptr->output_config.hash_inv)
+    if (workspace.output_config.audit || workspace.output_config.hash_inv)
     {
       VW::parsers::json::template read_line_json<true>(
-          *workspace.workspace_ptr, examples, owned_str.data(), owned_str.size(), example_factory);
+          workspace, examples, owned_str.data(), owned_str.size(), example_factory);
     }
     else
     {
       VW::parsers::json::template read_line_json<false>(
-          *workspace.workspace_ptr, examples, owned_str.data(), owned_str.size(), example_factory);
+          workspace, examples, owned_str.data(), owned_str.size(), example_factory);
     }
   }
-  catch (const VW::vw_exception& ex)
+  catch (...)
   {
-    for (auto* ex : examples)
-    {
-      clean_example(*ex);
-      SHARED_EXAMPLE_POOL.return_object(ex);
-    }
+    release_examples(allocator, examples);
     throw;
   }
-
-  std::vector<std::shared_ptr<VW::example>> result;
-  result.reserve(examples.size());
-  for (auto* ex : examples)
-  {
-    result.emplace_back(ex,
-        [](VW::example* ex)
-        {
-          clean_example(*ex);
-          SHARED_EXAMPLE_POOL.return_object(ex);
-        });
-  }
-
-  return result;
 }
 
-// Impl from VW
-void write_cache_header(workspace_with_logger_contexts& workspace, py::object file)
+std::shared_ptr<VW::example> parse_text_line(
+    VW::workspace& workspace, const std::shared_ptr<vwpy::example_pool>& pool, std::string_view line)
 {
-  python_writer writer(file);
-  size_t v_length = static_cast<uint64_t>(VW::VERSION.to_string().length()) + 1;
-
-  writer.write(reinterpret_cast<const char*>(&v_length), sizeof(v_length));
-  writer.write(VW::VERSION.to_string().c_str(), v_length);
-  writer.write("c", 1);
-  writer.write(reinterpret_cast<const char*>(&workspace.workspace_ptr->initial_weights_config.num_bits),
-      sizeof(workspace.workspace_ptr->initial_weights_config.num_bits));
+  auto ex = pool->acquire_shared();
+  VW::parsers::text::read_line(workspace, ex.get(), line);
+  return ex;
 }
 
-void write_cache_example(workspace_with_logger_contexts& workspace, VW::example& ex, py::object file)
+std::vector<std::shared_ptr<VW::example>> parse_dsjson_line(
+    VW::workspace& workspace, const std::shared_ptr<vwpy::example_pool>& pool, std::string_view line)
 {
-  VW::parsers::cache::details::cache_temp_buffer temp_buffer;
-  VW::io_buf output;
-  output.add_file(VW::make_unique<python_writer>(file));
-  VW::parsers::cache::write_example_to_cache(output, &ex,
-      workspace.workspace_ptr->parser_runtime.example_parser->lbl_parser,
-      workspace.workspace_ptr->runtime_state.parse_mask, temp_buffer);
-  output.flush();
+  VW::multi_ex examples;
+  read_dsjson_line(workspace, line, examples, pool_allocator(pool));
+  return adopt_pooled_examples(*pool, examples);
 }
 
-std::unique_ptr<VW::model_delta> merge_deltas(const std::vector<const VW::model_delta*>& deltas_to_merge)
+std::vector<std::shared_ptr<VW::example>> parse_json_line(
+    VW::workspace& workspace, const std::shared_ptr<vwpy::example_pool>& pool, std::string_view line)
 {
-  auto result = VW::merge_deltas(deltas_to_merge);
-  return std::make_unique<VW::model_delta>(std::move(result));
+  VW::multi_ex examples;
+  read_json_line(workspace, line, examples, pool_allocator(pool));
+  return adopt_pooled_examples(*pool, examples);
 }
 
-std::unique_ptr<VW::model_delta> calculate_delta(
-    const workspace_with_logger_contexts& base_workspace, const workspace_with_logger_contexts& derived_workspace)
+vwpy::workspace_counters& get_counters(const workspace_with_logger_contexts& workspace)
 {
-  auto delta = *derived_workspace.workspace_ptr - *base_workspace.workspace_ptr;
-  return std::make_unique<VW::model_delta>(std::move(delta));
+  if (workspace.counters == nullptr)
+  {
+    throw std::invalid_argument("Counters are not enabled. Pass record_counters=True to the Workspace constructor.");
+  }
+  return *workspace.counters;
 }
 
-std::unique_ptr<workspace_with_logger_contexts> apply_delta(
-    const workspace_with_logger_contexts& base_workspace, const VW::model_delta& delta)
+// Calls parse_func, counting the lines which fail to parse if the workspace records counters.
+template <typename ParseFunc>
+auto count_parse_errors(workspace_with_logger_contexts& workspace, ParseFunc&& parse_func)
 {
-  auto applied = *base_workspace.workspace_ptr + delta;
-  return std::make_unique<workspace_with_logger_contexts>(
-      workspace_with_logger_contexts{std::make_unique<logger_context>(*base_workspace.logger_context_ptr),
-          std::shared_ptr<VW::workspace>(std::move(applied))});
+  try
+  {
+    return parse_func();
+  }
+  catch (...)
+  {
+    if (workspace.counters != nullptr) { workspace.counters->parse_errors.fetch_add(1, std::memory_order_relaxed); }
+    throw;
+  }
 }
 
-std::shared_ptr<vwpy::debug_node> get_and_clear_debug_info(workspace_with_logger_contexts& workspace)
-{
-  assert(workspace.debug);
-  auto debug_info = dynamic_cast<vwpy::debug_data_stash*>(workspace.workspace_ptr->parser_runtime.custom_parser.get());
-  auto root = debug_info->shared_debug_state->root;
-  debug_info->shared_debug_state->active = std::stack<std::shared_ptr<vwpy::debug_node>>{};
-  debug_info->shared_debug_state->root = nullptr;
-  return root;
-}
+using float_array = py::array_t<float, py::array::c_style | py::array::forcecast>;
 
-template <typename LearnerT, typename ExampleT>
-void update_stats_recursive(VW::workspace& workspace, LearnerT& learner, ExampleT& example)
+// Acquires an example per row and fills them with fill_row(row, example) without the GIL. The arrays being read must be
+// kept alive by the caller.
+template <typename FillRowFunc>
+std::vector<std::shared_ptr<VW::example>> parse_matrix_rows(VW::workspace& workspace,
+    const std::shared_ptr<vwpy::example_pool>& pool, size_t num_rows, const std::optional<float_array>& labels,
+    FillRowFunc&& fill_row)
 {
-  if (learner.has_update_stats())
+  const float* label_data = nullptr;
+  if (labels.has_value())
   {
-    learner.update_stats(workspace, example);
-    return;
+    if (workspace.l->get_input_label_type() != VW::label_type_t::SIMPLE)
+    {
+      throw std::invalid_argument("Labels are only supported for workspaces which use simple labels.");
+    }
+    if (labels->ndim() != 1 || static_cast<size_t>(labels->size()) != num_rows)
+    {
+      throw std::invalid_argument("labels must be a 1-dimensional array with one element per row.");
+    }
+    label_data = labels->data();
   }
 
-  const auto has_at_least_one_new_style_func = learner.has_update_stats() || learner.has_output_example_prediction() ||
-      learner.has_print_update() || learner.has_cleanup_example();
-
-  // If we hit this point, there was no update stats but other funcs were
-  // defined so we should not forward. We log an error since this is probably an
-  // issue.
-  if (has_at_least_one_new_style_func)
+  std::vector<std::shared_ptr<VW::example>> result;
+  result.reserve(num_rows);
+  py::gil_scoped_release release;
+  for (size_t row = 0; row < num_rows; row++)
   {
-    workspace.logger.error(
-        "No update_stats function was registered for a reduction but other finalization functions were. This is likely "
-        "an issue with the reduction: '{}'. Please report this issue to the VW team.",
-        learner.get_name());
-    return;
+    result.push_back(pool->acquire_shared());
+    auto& ex = *result.back();
+    fill_row(row, ex);
+    if (label_data != nullptr) { ex.l.simple.label = label_data[row]; }
   }
+  return result;
+}
 
-  // Recurse until we find a reduction with an update_stats function.
-  auto* base = learner.get_base_learner();
-  if (base != nullptr)
+std::vector<std::shared_ptr<VW::example>> parse_csr_matrix(VW::workspace& workspace,
+    const std::shared_ptr<vwpy::example_pool>& pool,
+    const py::array_t<int64_t, py::array::c_style | py::array::forcecast>& indptr,
+    const py::array_t<int64_t, py::array::c_style | py::array::forcecast>& indices, const float_array& data,
+    const std::optional<float_array>& labels, const std::string& namespace_name, bool hash_columns)
+{
+  if (indptr.ndim() != 1 || indptr.size() < 1)
   {
-    if (learner.is_multiline() != base->is_multiline())
-    {
-      THROW("Cannot forward update_stats call across multiline/singleline boundary.");
-    }
-
-    update_stats_recursive(workspace, *base, example);
+    throw std::invalid_argument("indptr must be a 1-dimensional array with at least one element.");
   }
-  else { THROW("No update_stats functions were registered in the stack."); }
+  if (indices.ndim() != 1 || data.ndim() != 1 || indices.size() != data.size())
+  {
+    throw std::invalid_argument("indices and data must be 1-dimensional arrays of the same size.");
+  }
+  const auto num_rows = static_cast<size_t>(indptr.size() - 1);
+  const auto* row_offsets = indptr.data();
+  if (row_offsets[0] != 0 || row_offsets[num_rows] != static_cast<int64_t>(data.size()))
+  {
+    throw std::invalid_argument("indptr must start at 0 and end at the number of stored values.");
+  }
+  for (size_t row = 0; row < num_rows; row++)
+  {
+    if (row_offsets[row + 1] < row_offsets[row]) { throw std::invalid_argument("indptr must be non-decreasing."); }
+  }
+  const auto* columns = indices.data();
+  // A negative column id would otherwise become a huge feature index.
+  if (std::any_of(columns, columns + indices.size(), [](int64_t column) { return column < 0; }))
+  {
+    throw std::invalid_argument("indices must not be negative.");
+  }
+
+  const auto options =
+      vwpy::make_matrix_feature_options(workspace, namespace_name.data(), namespace_name.size(), hash_columns);
+  const auto* values = data.data();
+  return parse_matrix_rows(workspace, pool, num_rows, labels,
+      [&](size_t row, VW::example& ex)
+      {
+        const auto begin = row_offsets[row];
+        vwpy::push_sparse_row(workspace, options, ex, columns + begin, values + begin,
+            static_cast<size_t>(row_offsets[row + 1] - begin));
+      });
 }
 
-void py_setup_example(VW::workspace& ws, VW::example& ex)
+std::vector<std::shared_ptr<VW::example>> parse_dense_matrix(VW::workspace& workspace,
+    const std::shared_ptr<vwpy::example_pool>& pool, const float_array& matrix,
+    const std::optional<float_array>& labels, const std::string& namespace_name, bool hash_columns)
 {
-  ex.partial_prediction = 0.;
-  ex.num_features = 0;
-  ex.reset_total_sum_feat_sq();
-  ex.loss = 0.;
-  ex.debug_current_reduction_depth = 0;
-  // TODO: workout if this is necessary or how to set it from a non-friend function
-  // ex._use_permutations = all.permutations;
+  if (matrix.ndim() != 2) { throw std::invalid_argument("matrix must be a 2-dimensional array."); }
+  const auto num_rows = static_cast<size_t>(matrix.shape(0));
+  const auto num_columns = static_cast<size_t>(matrix.shape(1));
+  const auto options =
+      vwpy::make_matrix_feature_options(workspace, namespace_name.data(), namespace_name.size(), hash_columns);
+  const auto* values = matrix.data();
+  return parse_matrix_rows(workspace, pool, num_rows, labels,
+      [&](size_t row, VW::example& ex)
+      { vwpy::push_dense_row(workspace, options, ex, values + row * num_columns, num_columns); });
+}
 
-  ex.weight = ws.parser_runtime.example_parser->lbl_parser.get_weight(ex.l, ex.ex_reduction_features);
+// Releases the GIL while reading from the wrapped reader. Must only be read from while the GIL is held.
+class gil_releasing_reader : public VW::io::reader
+{
+public:
+  gil_releasing_reader(std::unique_ptr<VW::io::reader> inner)
+      : VW::io::reader(inner->is_resettable()), _inner(std::move(inner))
+  {
+  }
 
-  if (ws.feature_tweaks_config.add_constant)
+  ssize_t read(char* buffer, size_t num_bytes) override
   {
-    // TODO make workspace a const arg here.
-    VW::add_constant_feature(ws, &ex);
+    py::gil_scoped_release release;
+    return _inner->read(buffer, num_bytes);
   }
 
-  uint64_t multiplier = static_cast<uint64_t>(ws.reduction_state.total_feature_width) << ws.weights.stride_shift();
+  void reset() override { _inner->reset(); }
 
-  if (multiplier != 1)
-  {  // make room for per-feature information.
-    for (auto& fs : ex)
-    {
-      for (auto& j : fs.indices) { j *= multiplier; }
-    }
+private:
+  std::unique_ptr<VW::io::reader> _inner;
+};
+
+// Reads from a file descriptor which is owned by the caller.
+class fd_reader : public VW::io::reader
+{
+public:
+  fd_reader(int fd) : VW::io::reader(false), _fd(fd) {}
+
+  ssize_t read(char* buffer, size_t num_bytes) override
+  {
+#ifdef _WIN32
+    return ::_read(_fd, buffer, static_cast<unsigned int>(num_bytes));
+#else
+    return ::read(_fd, buffer, num_bytes);
+#endif
   }
-  ex.num_features = 0;
-  for (const auto& fs : ex) { ex.num_features += fs.size(); }
 
-  if (ex.interactions != nullptr)
+private:
+  int _fd;
+};
+
+// Files ending in .gz are decompressed.
+std::unique_ptr<VW::io::reader> open_file_input(const std::string& path)
+{
+  const std::string gz_extension = ".gz";
+  if (path.size() > gz_extension.size() &&
+      path.compare(path.size() - gz_extension.size(), gz_extension.size(), gz_extension) == 0)
   {
-    THROW("Example has either already been setup, or was never unsetup. This should never happen and is a bug.")
+    return VW::io::open_compressed_file_reader(path);
   }
+  return VW::io::open_file_reader(path);
+}
 
-  // Set the interactions for this example to the global set.
-  ex.interactions = &ws.feature_tweaks_config.interactions;
-  ex.extent_interactions = &ws.feature_tweaks_config.extent_interactions;
+// Files ending in .gz are compressed.
+std::unique_ptr<VW::io::writer> open_file_output(const std::string& path)
+{
+  const std::string gz_extension = ".gz";
+  if (path.size() > gz_extension.size() &&
+      path.compare(path.size() - gz_extension.size(), gz_extension.size(), gz_extension) == 0)
+  {
+    return VW::io::open_compressed_file_writer(path);
+  }
+  return VW::io::open_file_writer(path);
 }
 
-void py_setup_example(VW::workspace& ws, std::vector<VW::example*>& ex)
+std::unique_ptr<VW::io::reader> open_input(const std::variant<std::string, int>& source)
 {
-  for (auto& example : ex) { py_setup_example(ws, *example); }
+  if (std::holds_alternative<int>(source)) { return VW::make_unique<fd_reader>(std::get<int>(source)); }
+  return open_file_input(std::get<std::string>(source));
 }
 
-void py_unsetup_example(VW::workspace& ws, VW::example& ex)
+enum class input_format
 {
-  // Reset these to avoid reuse issues, but make sure keep the label that was passed in.
-  // This is wasteful from a memory perspective but important for correctness at
-  // the moment.
-  VW::polylabel replacement{};
-  switch (ws.l->get_input_label_type())
+  TEXT,
+  DSJSON,
+  JSON,
+  CACHE
+};
+
+// Reads examples from an input and groups multiline examples, so each group produced is ready to be passed to learn or
+// predict. This does not touch Python itself, whether it needs the GIL depends on the reader and allocator given.
+class example_file_parser
+{
+public:
+  example_file_parser(VW::workspace& workspace, std::unique_ptr<VW::io::reader> reader, input_format format,
+      example_allocator allocator)
+      : _workspace(workspace)
+      , _format(format)
+      , _multiline(workspace.l->is_multiline())
+      , _allocator(std::move(allocator))
   {
-    case VW::label_type_t::SIMPLE:
+    if (_format == input_format::CACHE) { read_cache_header(*reader); }
+    _buffer.add_file(std::move(reader));
+  }
+
+  example_file_parser(const example_file_parser&) = delete;
+  example_file_parser& operator=(const example_file_parser&) = delete;
+
+  ~example_file_parser() { release_examples(_allocator, _pending); }
+
+  // Fills output, which must be empty, with the next example or multiline example. Returns false at the end of input.
+  bool next(VW::multi_ex& output)
+  {
+    if (_format == input_format::CACHE) { return next_from_cache(output); }
+
+    char* line = nullptr;
+    size_t num_chars = 0;
+    while ((num_chars = _buffer.readto(line, '\n')) > 0)
+    {
+      std::string_view line_view(line, num_chars);
+      while (!line_view.empty() && (line_view.back() == '\n' || line_view.back() == '\r'))
+      {
+        line_view.remove_suffix(1);
+      }
+
+      if (_format == input_format::TEXT)
+      {
+        auto* ex = _allocator.get();
+        try
+        {
+          VW::parsers::text::read_line(_workspace, ex, line_view);
+        }
+        catch (...)
+        {
+          _allocator.release(ex);
+          throw;
+        }
+        if (add_to_group(ex, output)) { return true; }
+        continue;
+      }
+
+      if (line_view.find_first_not_of(" \t") == std::string_view::npos) { continue; }
+      if (_format == input_format::DSJSON) { read_dsjson_line(_workspace, line_view, output, _allocator); }
+      else { read_json_line(_workspace, line_view, output, _allocator); }
+      if (!_multiline && output.size() != 1)
+      {
+        release_examples(_allocator, output);
+        THROW("Expected single example");
+      }
+      return true;
+    }
+
+    return take_pending(output);
+  }
+
+private:
+  bool next_from_cache(VW::multi_ex& output)
+  {
+    while (true)
+    {
+      auto* ex = _allocator.get();
+      VW::multi_ex examples{ex};
+      size_t bytes_read = 0;
+      try
+      {
+        bytes_read = VW::parsers::cache::read_example_from_cache(&_workspace, _buffer, examples);
+      }
+      catch (...)
+      {
+        _allocator.release(ex);
+        throw;
+      }
+      if (bytes_read == 0)
+      {
+        _allocator.release(ex);
+        return take_pending(output);
+      }
+      if (add_to_group(ex, output)) { return true; }
+    }
+  }
+
+  // Returns true if output now contains a complete group. Multiline examples are terminated by a newline example, which
+  // is not part of the group.
+  bool add_to_group(VW::example* ex, VW::multi_ex& output)
+  {
+    if (!_multiline)
+    {
+      output.push_back(ex);
+      return true;
+    }
+    if (!ex->is_newline)
+    {
+      _pending.push_back(ex);
+      return false;
+    }
+    _allocator.release(ex);
+    return take_pending(output);
+  }
+
+  bool take_pending(VW::multi_ex& output)
+  {
+    if (_pending.empty()) { return false; }
+    std::swap(output, _pending);
+    return true;
+  }
+
+  VW::workspace& _workspace;
+  input_format _format;
+  bool _multiline;
+  example_allocator _allocator;
+  VW::io_buf _buffer;
+  VW::multi_ex _pending;
+};
+
+// Reads an input format directly from a file, without going through Python file iteration. Input is read with the GIL
+// released.
+struct file_reader
+{
+  using item_t = std::variant<std::shared_ptr<VW::example>, std::vector<std::shared_ptr<VW::example>>>;
+
+  file_reader(std::shared_ptr<VW::workspace> workspace, std::shared_ptr<vwpy::example_pool> pool,
+      std::unique_ptr<VW::io::reader> reader, input_format format)
+      : _workspace(workspace)
+      , _pool(pool)
+      , _parser(*workspace, VW::make_unique<gil_releasing_reader>(std::move(reader)), format, pool_allocator(pool))
+  {
+  }
+
+  std::optional<item_t> read_next()
+  {
+    VW::multi_ex examples;
+    if (!_parser.next(examples)) { return std::nullopt; }
+    auto result = adopt_pooled_examples(*_pool, examples);
+    if (_workspace->l->is_multiline()) { return result; }
+    return result[0];
+  }
+
+  std::vector<item_t> read_batch(size_t max_items)
+  {
+    std::vector<item_t> result;
+    result.reserve(max_items);
+    while (result.size() < max_items)
+    {
+      auto next = read_next();
+      if (!next.has_value()) { break; }
+      result.push_back(std::move(*next));
+    }
+    return result;
+  }
+
+private:
+  // Keeps the workspace alive for the parser.
+  std::shared_ptr<VW::workspace> _workspace;
+  std::shared_ptr<vwpy::example_pool> _pool;
+  example_file_parser _parser;
+};
+
+// Writes examples in cache format through a single persistent buffer. Examples are serialized into the buffer and only
+// handed to the output when it fills or at the end of each call, rather than once per example. Writing to a path does not
+// touch Python so those writes are done with the GIL released.
+class cache_writer
+{
+public:
+  cache_writer(std::shared_ptr<VW::workspace> workspace, std::unique_ptr<VW::io::writer> writer, bool needs_gil)
+      : _workspace(workspace), _needs_gil(needs_gil)
+  {
+    _output.add_file(std::make_unique<vwpy::checked_writer>(std::move(writer)));
+    // Multiline examples are terminated by an empty newline example, the same one the text parser produces.
+    VW::parsers::text::read_line(*_workspace, &_newline_example, "");
+
+    // Impl from VW
+    const auto version = VW::VERSION.to_string();
+    size_t v_length = static_cast<uint64_t>(version.length()) + 1;
+    _output.bin_write_fixed(reinterpret_cast<const char*>(&v_length), sizeof(v_length));
+    _output.bin_write_fixed(version.c_str(), v_length);
+    _output.bin_write_fixed("c", 1);
+    _output.bin_write_fixed(reinterpret_cast<const char*>(&_workspace->initial_weights_config.num_bits),
+        sizeof(_workspace->initial_weights_config.num_bits));
+    flush();
+  }
+
+  cache_writer(const cache_writer&) = delete;
+  cache_writer& operator=(const cache_writer&) = delete;
+
+  // Only a last resort for a writer which was never closed, errors can't be reported from here. close must be called to
+  // know that the whole cache was written.
+  ~cache_writer()
+  {
+    if (_closed) { return; }
+    try
+    {
+      flush();
+    }
+    catch (...)
+    {
+    }
+  }
+
+  // BatchT is either std::vector<VW::example*> or std::vector<VW::multi_ex>.
+  template <typename BatchT>
+  void write_many(BatchT& examples)
+  {
+    check_not_closed();
+    run_with_gil_policy(
+        [&]()
+        {
+          for (auto& item : examples) { write_item(deref_item(item)); }
+          _output.flush();
+        });
+  }
+
+  void flush()
+  {
+    check_not_closed();
+    run_with_gil_policy([&]() { _output.flush(); });
+  }
+
+  // Writes out everything which is buffered and closes the output, throwing if any of it could not be written.
+  void close()
+  {
+    if (_closed) { return; }
+    _closed = true;
+    run_with_gil_policy(
+        [&]()
+        {
+          _output.flush();
+          _output.close_files();
+        });
+  }
+
+private:
+  void check_not_closed() const
+  {
+    if (_closed) { THROW("The cache writer is closed."); }
+  }
+
+  static VW::example& deref_item(VW::example* ex) { return *ex; }
+  static VW::multi_ex& deref_item(VW::multi_ex& ex) { return ex; }
+
+  void write_item(VW::example& ex)
+  {
+    VW::parsers::cache::write_example_to_cache(_output, &ex,
+        _workspace->parser_runtime.example_parser->lbl_parser, _workspace->runtime_state.parse_mask, _temp_buffer);
+  }
+
+  void write_item(VW::multi_ex& examples)
+  {
+    for (auto* ex : examples) { write_item(*ex); }
+    write_item(_newline_example);
+  }
+
+  template <typename FuncT>
+  void run_with_gil_policy(FuncT&& func)
+  {
+    if (_needs_gil) { func(); }
+    else
+    {
+      py::gil_scoped_release release;
+      func();
+    }
+  }
+
+  std::shared_ptr<VW::workspace> _workspace;
+  bool _needs_gil;
+  bool _closed = false;
+  VW::io_buf _output;
+  VW::parsers::cache::details::cache_temp_buffer _temp_buffer;
+  VW::example _newline_example;
+};
+
+std::unique_ptr<VW::model_delta> merge_deltas(const std::vector<const VW::model_delta*>& deltas_to_merge)
+{
+  auto result = VW::merge_deltas(deltas_to_merge);
+  return std::make_unique<VW::model_delta>(std::move(result));
+}
+
+// Locks two workspaces, which may be the same one. std::lock takes both without deadlocking against a call which locks
+// them in the opposite order. As with run_without_gil, the GIL must be released first.
+std::pair<std::unique_lock<std::mutex>, std::unique_lock<std::mutex>> lock_workspaces(
+    const workspace_with_logger_contexts& first, const workspace_with_logger_contexts& second)
+{
+  std::unique_lock<std::mutex> first_lock(first.mutex, std::defer_lock);
+  std::unique_lock<std::mutex> second_lock(second.mutex, std::defer_lock);
+  if (&first == &second) { first_lock.lock(); }
+  else { std::lock(first_lock, second_lock); }
+  return {std::move(first_lock), std::move(second_lock)};
+}
+
+std::unique_ptr<VW::model_delta> calculate_delta(
+    const workspace_with_logger_contexts& base_workspace, const workspace_with_logger_contexts& derived_workspace)
+{
+  py::gil_scoped_release release;
+  const auto locks = lock_workspaces(base_workspace, derived_workspace);
+  check_not_frozen(base_workspace);
+  check_not_frozen(derived_workspace);
+  auto delta = *derived_workspace.workspace_ptr - *base_workspace.workspace_ptr;
+  return std::make_unique<VW::model_delta>(std::move(delta));
+}
+
+// The state shared by the debug interceptors of a workspace created with the debug tree or debug tree sampling.
+vwpy::debug_data& get_debug_data(const workspace_with_logger_contexts& workspace)
+{
+  auto* stash = dynamic_cast<vwpy::debug_data_stash*>(workspace.workspace_ptr->parser_runtime.custom_parser.get());
+  assert(stash != nullptr);
+  return *stash->shared_debug_state;
+}
+
+// Returns the value of a field of a debug node, or nothing if the field was not captured.
+template <typename T>
+std::optional<T> get_debug_field(const vwpy::debug_node& node, vwpy::debug_field field, const T& value)
+{
+  if (!(node.fields & field)) { return std::nullopt; }
+  return value;
+}
+
+uint32_t to_debug_fields(const std::vector<std::string>& names)
+{
+  static const std::map<std::string, vwpy::debug_field> fields = {
+      {"input_labels", vwpy::DEBUG_FIELD_INPUT_LABELS},
+      {"output_prediction", vwpy::DEBUG_FIELD_OUTPUT_PREDICTION},
+      {"interactions", vwpy::DEBUG_FIELD_INTERACTIONS},
+      {"weight", vwpy::DEBUG_FIELD_WEIGHT},
+      {"offset", vwpy::DEBUG_FIELD_OFFSET},
+      {"partial_prediction", vwpy::DEBUG_FIELD_PARTIAL_PREDICTION},
+      {"updated_prediction", vwpy::DEBUG_FIELD_UPDATED_PREDICTION},
+  };
+  uint32_t result = 0;
+  for (const auto& name : names)
+  {
+    auto it = fields.find(name);
+    if (it == fields.end()) { throw std::invalid_argument(fmt::format("Unknown debug tree field: {}", name)); }
+    result |= it->second;
+  }
+  return result;
+}
+
+// Creates a workspace and checks it only uses options which are supported. model_reader may be null.
+std::unique_ptr<workspace_with_logger_contexts> create_workspace(const std::vector<std::string>& args,
+    std::unique_ptr<VW::io::reader> model_reader, bool record_feature_names, bool record_metrics, bool record_counters,
+    bool debug, bool profile, const std::optional<vwpy::debug_sampling>& debug_sampling, uint32_t debug_fields)
+{
+  if (int(debug) + int(profile) + int(debug_sampling.has_value()) > 1)
+  {
+    throw std::invalid_argument("Only one of the debug tree, debug tree sampling and profiling can be enabled.");
+  }
+
+  auto opts = std::make_unique<VW::config::options_cli>(args);
+  if (record_metrics)
+  {
+    // VW enables metrics by passing a file to write the metrics to.
+    opts->insert("extra_metrics", "THIS_FILE_SHOULD_NOT_EXIST1");
+  }
+
+  if (record_feature_names)
+  {
+    // We need to ensure hash_inv is enabled during initialize for things to work correctly.
+    // The only way to do that is via an option. We're using this one
+    opts->insert("dump_json_weights_experimental", "THIS_FILE_SHOULD_NOT_EXIST2");
+    opts->insert("dump_json_weights_include_feature_names_experimental", "");
+  }
+
+  auto wrapped_object = std::make_unique<workspace_with_logger_contexts>();
+  wrapped_object->args = args;
+  wrapped_object->record_feature_names = record_feature_names;
+  wrapped_object->record_metrics = record_metrics;
+  if (record_counters) { wrapped_object->counters = std::make_unique<vwpy::workspace_counters>(); }
+  wrapped_object->debug_sampling = debug_sampling;
+  wrapped_object->debug_fields = debug_fields;
+  wrapped_object->logger_context_ptr = std::make_unique<logger_context>();
+  py::object get_logger = py::module::import("logging").attr("getLogger");
+  wrapped_object->logger_context_ptr->driver_logger = get_logger("vowpal_wabbit_next.driver");
+  wrapped_object->logger_context_ptr->log_logger = get_logger("vowpal_wabbit_next.log");
+  auto logger = VW::io::create_custom_sink_logger(wrapped_object->logger_context_ptr.get(), log_log);
+
+  std::unique_ptr<VW::setup_base_i> stack = nullptr;
+  if (debug || debug_sampling.has_value())
+  {
+    wrapped_object->debug = debug;
+    stack = std::make_unique<vwpy::debug_stack_builder>();
+  }
+  else if (profile)
+  {
+    auto profile_stack = std::make_unique<vwpy::profile_stack_builder>();
+    wrapped_object->profile = profile_stack->profile;
+    stack = std::move(profile_stack);
+  }
+  wrapped_object->workspace_ptr = std::shared_ptr<VW::workspace>(
+      VW::initialize_experimental(std::move(opts), std::move(model_reader), driver_log,
+          wrapped_object->logger_context_ptr.get(), &logger, std::move(stack)));
+  // This should cause parsing failures to be thrown instead of just logged.
+  wrapped_object->workspace_ptr->parser_runtime.example_parser->strict_parse = true;
+  if (debug || debug_sampling.has_value()) { get_debug_data(*wrapped_object).fields = debug_fields; }
+  if (debug_sampling.has_value()) { get_debug_data(*wrapped_object).set_sampling(*debug_sampling); }
+
+  // Check for unsupported features.
+  // The main reason for this is we want to remove the concept of "setup_example" in the python bindings
+  // This is achieved by performing necessary steps in the learn/predict call and undoing them on the way out.
+  if (wrapped_object->workspace_ptr->parser_runtime.example_parser->sort_features)
+  {
+    THROW("The command line option 'sort_features' is not supported in py-vowpal-wabbit-next.");
+  }
+
+  if (wrapped_object->workspace_ptr->feature_tweaks_config.ignore_some)
+  {
+    THROW("The command line option 'ignore' is not supported in py-vowpal-wabbit-next.");
+  }
+
+  if (wrapped_object->workspace_ptr->feature_tweaks_config.skip_gram_transformer != nullptr)
+  {
+    THROW("The command line option 'ngram' is not supported in py-vowpal-wabbit-next.");
+  }
+
+  if (!wrapped_object->workspace_ptr->feature_tweaks_config.limit_strings.empty())
+  {
+    THROW("The command line option 'feature_limit' is not supported in py-vowpal-wabbit-next.");
+  }
+
+  return wrapped_object;
+}
+
+// Wraps a workspace created from base_workspace, which logs to the same Python loggers.
+std::unique_ptr<workspace_with_logger_contexts> make_derived_workspace(
+    const workspace_with_logger_contexts& base_workspace, std::unique_ptr<VW::workspace> derived)
+{
+  auto result = std::make_unique<workspace_with_logger_contexts>();
+  result->logger_context_ptr = std::make_unique<logger_context>(*base_workspace.logger_context_ptr);
+  result->workspace_ptr = std::shared_ptr<VW::workspace>(std::move(derived));
+  result->args = base_workspace.args;
+  result->record_feature_names = base_workspace.record_feature_names;
+  result->record_metrics = base_workspace.record_metrics;
+  if (base_workspace.counters != nullptr) { result->counters = std::make_unique<vwpy::workspace_counters>(); }
+  result->debug = false;
+  return result;
+}
+
+std::unique_ptr<workspace_with_logger_contexts> apply_delta(
+    const workspace_with_logger_contexts& base_workspace, const VW::model_delta& delta)
+{
+  return run_without_gil(
+      base_workspace, [&]() { return make_derived_workspace(base_workspace, *base_workspace.workspace_ptr + delta); });
+}
+
+vwpy::sparse_delta calculate_sparse_delta(const workspace_with_logger_contexts& base_workspace,
+    const workspace_with_logger_contexts& derived_workspace, size_t num_threads)
+{
+  py::gil_scoped_release release;
+  const auto locks = lock_workspaces(base_workspace, derived_workspace);
+  check_not_frozen(base_workspace);
+  check_not_frozen(derived_workspace);
+  return vwpy::calculate_sparse_delta(*base_workspace.workspace_ptr, *derived_workspace.workspace_ptr, num_threads);
+}
+
+vwpy::sparse_delta merge_sparse_deltas(const std::vector<const vwpy::sparse_delta*>& deltas, size_t num_threads)
+{
+  py::gil_scoped_release release;
+  return vwpy::merge_sparse_deltas(deltas, num_threads);
+}
+
+void apply_delta_inplace(workspace_with_logger_contexts& workspace, const vwpy::sparse_delta& delta)
+{
+  run_without_gil(workspace,
+      [&]()
+      {
+        own_weights(workspace);
+        vwpy::apply_sparse_delta(*workspace.workspace_ptr, delta);
+      });
+}
+
+py::bytes serialize_sparse_delta(const vwpy::sparse_delta& delta, vwpy::weight_precision precision, bool compress)
+{
+  auto backing_vector = std::make_shared<std::vector<char>>();
+  {
+    py::gil_scoped_release release;
+    auto writer = VW::io::create_vector_writer(backing_vector);
+    vwpy::write_sparse_delta(delta, *writer, precision, compress);
+  }
+  return py::bytes(backing_vector->data(), backing_vector->size());
+}
+
+void serialize_sparse_delta_to(
+    const vwpy::sparse_delta& delta, py::object file, vwpy::weight_precision precision, bool compress)
+{
+  // The writer outlives the GIL release since a python_writer must be destroyed with the GIL held.
+  python_writer writer(std::move(file));
+  py::gil_scoped_release release;
+  vwpy::write_sparse_delta(delta, writer, precision, compress);
+}
+
+vwpy::sparse_delta deserialize_sparse_delta(const py::bytes& data)
+{
+  std::string_view data_view = data;
+  py::gil_scoped_release release;
+  auto reader = VW::io::create_buffer_view(data_view.data(), data_view.size());
+  return vwpy::read_sparse_delta(*reader);
+}
+
+// The GIL is held throughout since the file is read from as the delta is decoded.
+vwpy::sparse_delta deserialize_sparse_delta_from(py::object file)
+{
+  python_reader reader(std::move(file));
+  return vwpy::read_sparse_delta(reader);
+}
+
+// The trees are no longer written to once they are returned from a call, so they can be read without the GIL.
+std::string debug_trees_to_collapsed_stacks(const std::vector<std::shared_ptr<vwpy::debug_node>>& trees)
+{
+  py::gil_scoped_release release;
+  return vwpy::to_collapsed_stacks(trees);
+}
+
+std::string debug_trees_to_chrome_trace(const std::vector<std::shared_ptr<vwpy::debug_node>>& trees)
+{
+  py::gil_scoped_release release;
+  return vwpy::to_chrome_trace(trees);
+}
+
+// Read only view of memory owned by owner, which is kept alive by the array.
+template <typename T>
+py::array_t<T> make_readonly_view(std::vector<py::ssize_t> shape, const T* data, py::handle owner)
+{
+  py::array_t<T> result(std::move(shape), data, owner);
+  result.attr("setflags")(py::arg("write") = false);
+  return result;
+}
+
+std::shared_ptr<vwpy::debug_node> get_and_clear_debug_info(workspace_with_logger_contexts& workspace)
+{
+  assert(workspace.debug);
+  auto debug_info = dynamic_cast<vwpy::debug_data_stash*>(workspace.workspace_ptr->parser_runtime.custom_parser.get());
+  auto root = debug_info->shared_debug_state->root;
+  debug_info->shared_debug_state->active = std::stack<vwpy::debug_node*>{};
+  debug_info->shared_debug_state->root = nullptr;
+  return root;
+}
+
+template <typename LearnerT, typename ExampleT>
+void update_stats_recursive(VW::workspace& workspace, LearnerT& learner, ExampleT& example)
+{
+  if (learner.has_update_stats())
+  {
+    learner.update_stats(workspace, example);
+    return;
+  }
+
+  const auto has_at_least_one_new_style_func = learner.has_update_stats() || learner.has_output_example_prediction() ||
+      learner.has_print_update() || learner.has_cleanup_example();
+
+  // If we hit this point, there was no update stats but other funcs were
+  // defined so we should not forward. We log an error since this is probably an
+  // issue.
+  if (has_at_least_one_new_style_func)
+  {
+    workspace.logger.error(
+        "No update_stats function was registered for a reduction but other finalization functions were. This is likely "
+        "an issue with the reduction: '{}'. Please report this issue to the VW team.",
+        learner.get_name());
+    return;
+  }
+
+  // Recurse until we find a reduction with an update_stats function.
+  auto* base = learner.get_base_learner();
+  if (base != nullptr)
+  {
+    if (learner.is_multiline() != base->is_multiline())
+    {
+      THROW("Cannot forward update_stats call across multiline/singleline boundary.");
+    }
+
+    update_stats_recursive(workspace, *base, example);
+  }
+  else { THROW("No update_stats functions were registered in the stack."); }
+}
+
+// Per call state which is reset even for prepared examples.
+void reset_call_state(VW::workspace& ws, VW::example& ex)
+{
+  ex.partial_prediction = 0.;
+  ex.loss = 0.;
+  ex.debug_current_reduction_depth = 0;
+  // TODO: workout if this is necessary or how to set it from a non-friend function
+  // ex._use_permutations = all.permutations;
+
+  ex.weight = ws.parser_runtime.example_parser->lbl_parser.get_weight(ex.l, ex.ex_reduction_features);
+}
+
+// The O(features) part of setup, which is skipped for prepared examples.
+void setup_example_features(VW::workspace& ws, VW::example& ex)
+{
+  ex.num_features = 0;
+  ex.reset_total_sum_feat_sq();
+
+  if (ws.feature_tweaks_config.add_constant)
+  {
+    // TODO make workspace a const arg here.
+    VW::add_constant_feature(ws, &ex);
+  }
+
+  uint64_t multiplier = static_cast<uint64_t>(ws.reduction_state.total_feature_width) << ws.weights.stride_shift();
+
+  if (multiplier != 1)
+  {  // make room for per-feature information.
+    for (auto& fs : ex)
+    {
+      for (auto& j : fs.indices) { j *= multiplier; }
+    }
+  }
+  ex.num_features = 0;
+  for (const auto& fs : ex) { ex.num_features += fs.size(); }
+
+  if (ex.interactions != nullptr)
+  {
+    THROW("Example has either already been setup, or was never unsetup. This should never happen and is a bug.")
+  }
+
+  // Set the interactions for this example to the global set.
+  ex.interactions = &ws.feature_tweaks_config.interactions;
+  ex.extent_interactions = &ws.feature_tweaks_config.extent_interactions;
+}
+
+// Returns true if the example was left setup for this workspace by prepare_examples. Must not be used on an example
+// which is setup for a call. Only prepared examples have interactions set outside of a call, so the registry is not
+// consulted for the common case.
+bool is_prepared_for(const workspace_with_logger_contexts& workspace, const VW::example& ex)
+{
+  if (ex.interactions == nullptr) { return false; }
+  const auto owner = vwpy::prepared_examples::owner(ex);
+  if (owner != 0 && owner != workspace.id)
+  {
+    THROW("Example is prepared for a different workspace. Call unprepare on that workspace before using it here.")
+  }
+  return owner == workspace.id;
+}
+
+// Returns whether the example is prepared, which must be passed to py_unsetup_example. Once setup every example has
+// interactions set, so unsetup can't tell prepared examples apart without taking the lock of the registry.
+bool py_setup_example(const workspace_with_logger_contexts& workspace, VW::example& ex)
+{
+  auto& ws = *workspace.workspace_ptr;
+  reset_call_state(ws, ex);
+  if (is_prepared_for(workspace, ex)) { return true; }
+  setup_example_features(ws, ex);
+  return false;
+}
+
+std::vector<bool> py_setup_example(const workspace_with_logger_contexts& workspace, std::vector<VW::example*>& ex)
+{
+  std::vector<bool> prepared;
+  prepared.reserve(ex.size());
+  for (auto& example : ex) { prepared.push_back(py_setup_example(workspace, *example)); }
+  return prepared;
+}
+
+// Clears anything the reduction stack wrote to the example during a call. Done even for prepared examples.
+void reset_call_output(VW::workspace& ws, VW::example& ex)
+{
+  // Reset these to avoid reuse issues, but make sure keep the label that was passed in.
+  // This is wasteful from a memory perspective but important for correctness at
+  // the moment.
+  VW::polylabel replacement{};
+  switch (ws.l->get_input_label_type())
+  {
+    case VW::label_type_t::SIMPLE:
       replacement.simple = std::move(ex.l.simple);
       break;
     case VW::label_type_t::CB:
@@ -561,247 +1485,1466 @@ void py_unsetup_example(VW::workspace& ws, VW::example& ex)
     default:
       THROW("Unknown label type encountered in py_unsetup_example");
   }
-  ex.l = std::move(replacement);
-  ex.pred = VW::polyprediction{};
+  ex.l = std::move(replacement);
+  ex.pred = VW::polyprediction{};
+}
+
+// The O(features) part of unsetup, which is skipped for prepared examples.
+void unsetup_example_features(VW::workspace& ws, VW::example& ex)
+{
+  if (ws.feature_tweaks_config.add_constant)
+  {
+    if (ex.feature_space[VW::details::CONSTANT_NAMESPACE].size() != 1)
+    {
+      THROW("Constant feature not found. This should not happen.");
+    }
+    ex.feature_space[VW::details::CONSTANT_NAMESPACE].clear();
+    auto num_times = std::count(ex.indices.begin(), ex.indices.end(), VW::details::CONSTANT_NAMESPACE);
+    if (num_times != 1) { THROW("Constant index not found. This should not happen."); }
+    auto it = std::find(ex.indices.begin(), ex.indices.end(), VW::details::CONSTANT_NAMESPACE);
+    ex.indices.erase(it);
+  }
+
+  uint32_t multiplier = ws.reduction_state.total_feature_width << ws.weights.stride_shift();
+  if (multiplier != 1)
+  {
+    for (auto ns : ex.indices)
+    {
+      for (auto& idx : ex.feature_space[ns].indices) { idx /= multiplier; }
+    }
+  }
+
+  if (ex.interactions == nullptr)
+  {
+    THROW("Example has either already been unsetup, or was never setup. This should never happen and is a bug.")
+  }
+
+  ex.interactions = nullptr;
+  ex.extent_interactions = nullptr;
+}
+
+// prepared is the result of py_setup_example.
+void py_unsetup_example(const workspace_with_logger_contexts& workspace, VW::example& ex, bool prepared)
+{
+  auto& ws = *workspace.workspace_ptr;
+  reset_call_output(ws, ex);
+  if (prepared) { return; }
+  unsetup_example_features(ws, ex);
+}
+
+void py_unsetup_example(
+    const workspace_with_logger_contexts& workspace, std::vector<VW::example*>& ex, const std::vector<bool>& prepared)
+{
+  for (size_t i = 0; i < ex.size(); i++) { py_unsetup_example(workspace, *ex[i], prepared[i]); }
+}
+
+// Leaves examples setup for this workspace so that learn and predict skip rewriting the feature indices each call. The
+// setup only depends on options fixed when the workspace is created, so the workspace id is enough to identify it.
+void prepare_examples(workspace_with_logger_contexts& workspace, std::vector<VW::example*>& examples)
+{
+  run_without_gil(workspace,
+      [&]()
+      {
+        for (auto* ex : examples)
+        {
+          if (is_prepared_for(workspace, *ex)) { continue; }
+          setup_example_features(*workspace.workspace_ptr, *ex);
+          vwpy::prepared_examples::mark(*ex, workspace.id);
+        }
+      });
+}
+
+void unprepare_examples(workspace_with_logger_contexts& workspace, std::vector<VW::example*>& examples)
+{
+  run_without_gil(workspace,
+      [&]()
+      {
+        for (auto* ex : examples)
+        {
+          if (!is_prepared_for(workspace, *ex)) { continue; }
+          vwpy::prepared_examples::erase(*ex);
+          unsetup_example_features(*workspace.workspace_ptr, *ex);
+        }
+      });
+}
+
+// Because of the GIL we can use globals here.
+static bool SIGINT_CALLED = false;
+static VW::workspace* CLI_DRIVER_WORKSPACE = nullptr;
+
+// return type is an optional error information (nullopt if success), driver output, list of log messages
+// stdin is not supported
+std::tuple<std::optional<std::string>, std::string, std::vector<std::string>> run_cli_driver(
+    const std::vector<std::string>& args, bool onethread)
+{
+  SIGINT_CALLED = false;
+  CLI_DRIVER_WORKSPACE = nullptr;
+  std::signal(SIGINT,
+      [](int)
+      {
+        if (CLI_DRIVER_WORKSPACE != nullptr) { VW::details::set_done(*CLI_DRIVER_WORKSPACE); }
+        SIGINT_CALLED = true;
+      });
+
+  auto args_copy = args;
+  args_copy.push_back("--no_stdin");
+  auto options = VW::make_unique<VW::config::options_cli>(args_copy);
+  std::stringstream driver_log;
+  std::vector<std::string> log_log;
+
+  auto logger = VW::io::create_custom_sink_logger(&log_log,
+      [](void* context, VW::io::log_level /* unused */, const std::string& message)
+      {
+        auto* log_log = static_cast<std::vector<std::string>*>(context);
+        log_log->push_back(message);
+      });
+
+  auto driver_logger = [](void* context, const std::string& message)
+  {
+    auto* driver_log = static_cast<std::stringstream*>(context);
+    *driver_log << message;
+  };
+
+  try
+  {
+    auto all = VW::initialize_experimental(std::move(options), nullptr, driver_logger, &driver_log, &logger);
+    all->runtime_config.vw_is_main = true;
+    CLI_DRIVER_WORKSPACE = all.get();
+
+    // If sigint was called before we got here, we should avoid running the driver.
+    if (!SIGINT_CALLED)
+    {
+      if (onethread) { VW::LEARNER::generic_driver_onethread(*all); }
+      else
+      {
+        VW::start_parser(*all);
+        VW::LEARNER::generic_driver(*all);
+        VW::end_parser(*all);
+      }
+
+      if (all->parser_runtime.example_parser->exc_ptr)
+      {
+        std::rethrow_exception(all->parser_runtime.example_parser->exc_ptr);
+      }
+      VW::sync_stats(*all);
+      all->finish();
+    }
+  }
+  catch (const std::exception& ex)
+  {
+    return std::make_tuple(ex.what(), driver_log.str(), log_log);
+  }
+  catch (...)
+  {
+    return std::make_tuple("Unknown exception occurred", driver_log.str(), log_log);
+  }
+
+  SIGINT_CALLED = false;
+  CLI_DRIVER_WORKSPACE = nullptr;
+  return std::make_tuple(std::nullopt, driver_log.str(), log_log);
+}
+
+struct dense_weight_holder
+{
+  dense_weight_holder(VW::dense_parameters& weights, size_t total_feature_width, std::shared_ptr<VW::workspace> ws)
+      : total_feature_width(total_feature_width), ws(ws)
+  {
+    this->weights.shallow_copy(weights);
+  }
+
+  // Shares the memory of the workspace's weights, which keeps it alive for arrays viewing it if the workspace later
+  // replaces its weights, as freezing and copying shared weights do.
+  VW::dense_parameters weights;
+  size_t total_feature_width;
+  std::shared_ptr<VW::workspace> ws;
+};
+
+struct python_dict_writer : VW::metric_sink_visitor
+{
+  python_dict_writer(py::dict& dest_dict) : _dest_dict(dest_dict) {}
+  void int_metric(const std::string& key, uint64_t value) override { _dest_dict[key.c_str()] = value; }
+  void float_metric(const std::string& key, float value) override { _dest_dict[key.c_str()] = value; }
+  void string_metric(const std::string& key, const std::string& value) override { _dest_dict[key.c_str()] = value; }
+  void bool_metric(const std::string& key, bool value) override { _dest_dict[key.c_str()] = value; }
+  void sink_metric(const std::string& key, const VW::metric_sink& value) override
+  {
+    py::dict nested;
+    auto nested_py = python_dict_writer(nested);
+    value.visit(nested_py);
+    _dest_dict[key.c_str()] = nested;
+  }
+
+private:
+  py::dict& _dest_dict;
+};
+
+py::dict convert_metrics_to_dict(const VW::metric_sink& metrics)
+{
+  py::dict dictionary;
+  python_dict_writer writer(dictionary);
+  metrics.visit(writer);
+  return dictionary;
+}
+
+// Labels
+
+bool is_shared(const VW::cs_label& label)
+{
+  const auto& costs = label.costs;
+  if (costs.size() != 1) { return false; }
+  if (costs[0].class_index != 0) { return false; }
+  if (costs[0].x != -FLT_MAX) { return false; }
+  return true;
+}
+
+uint64_t count_features(const VW::example& ex) { return ex.num_features; }
+
+uint64_t count_features(const VW::multi_ex& ex)
+{
+  uint64_t total = 0;
+  for (const auto* example : ex) { total += example->num_features; }
+  return total;
+}
+
+uint64_t count_interacted_features(const VW::example& ex) { return ex.num_features_from_interactions; }
+
+uint64_t count_interacted_features(const VW::multi_ex& ex)
+{
+  uint64_t total = 0;
+  for (const auto* example : ex) { total += example->num_features_from_interactions; }
+  return total;
+}
+
+uint64_t elapsed_ns(std::chrono::steady_clock::time_point start)
+{
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+// Returns a scope_exit which records a call that learns from or predicts on example in counters, unless they are null.
+// Nothing is recorded if the scope is left by an exception, since the call didn't happen. It must be destroyed before
+// the example is unsetup, since the reduction stack generates the interacted features.
+template <typename ExampleT>
+auto record_call_on_success(vwpy::workspace_counters* counters, bool is_learn, const ExampleT& example)
+{
+  const auto start = counters != nullptr ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{};
+  const int exceptions_at_start = std::uncaught_exceptions();
+  return VW::scope_exit(
+      [counters, is_learn, start, exceptions_at_start, &example]()
+      {
+        if (counters == nullptr || std::uncaught_exceptions() > exceptions_at_start) { return; }
+        counters->record_call(is_learn, elapsed_ns(start), count_features(example), count_interacted_features(example));
+      });
+}
+
+// TODO: create a version of this that can be used in learn that doesn't involve
+// copying the prediction and then not using the value.
+std::variant<vwpy::prediction_t, std::tuple<vwpy::prediction_t, std::vector<std::shared_ptr<vwpy::debug_node>>>>
+predict_then_learn(workspace_with_logger_contexts& workspace, VW::example& example)
+{
+  own_weights(workspace);
+  const auto prepared = py_setup_example(workspace, example);
+  auto on_exit = VW::scope_exit([&]() { py_unsetup_example(workspace, example, prepared); });
+  auto record = record_call_on_success(workspace.counters.get(), true, example);
+
+  auto* learner = VW::LEARNER::require_singleline(workspace.workspace_ptr->l.get());
+  std::vector<std::shared_ptr<vwpy::debug_node>> debug_info;
+  if (workspace.workspace_ptr->l->learn_returns_prediction)
+  {
+    // Learner is used directly as VW makes decisions about training and
+    // learn returns prediction in the workspace API and ends up calling
+    // potentially the wrong thing.
+    learner->learn(example);
+    if (workspace.debug) { debug_info.push_back(get_and_clear_debug_info(workspace)); }
+  }
+  else
+  {
+    // Learner is used directly as VW makes decisions about training and
+    // learn returns prediction in the workspace API and ends up calling
+    // potentially the wrong thing.
+    // We must save and restore test_only because the library sets this values and does not undo it.
+    bool test_only = example.test_only;
+    learner->predict(example);
+    example.test_only = test_only;
+    if (workspace.debug) { debug_info.push_back(get_and_clear_debug_info(workspace)); }
+
+    learner->learn(example);
+    if (workspace.debug) { debug_info.push_back(get_and_clear_debug_info(workspace)); }
+  }
+
+  // TODO - when updating VW submodule if learn calls update stats then remove this to avoid a double call.
+  update_stats_recursive(*workspace.workspace_ptr, *learner, example);
+  auto prediction = vwpy::to_prediction(example.pred, workspace.workspace_ptr->l->get_output_prediction_type());
+  if (workspace.debug) { return std::make_tuple(prediction, debug_info); }
+  return prediction;
+}
+
+std::variant<vwpy::prediction_t, std::tuple<vwpy::prediction_t, std::vector<std::shared_ptr<vwpy::debug_node>>>>
+predict_then_learn(workspace_with_logger_contexts& workspace, std::vector<VW::example*>& example)
+{
+  own_weights(workspace);
+  const auto prepared = py_setup_example(workspace, example);
+  auto on_exit = VW::scope_exit([&]() { py_unsetup_example(workspace, example, prepared); });
+  auto record = record_call_on_success(workspace.counters.get(), true, example);
+  auto* learner = VW::LEARNER::require_multiline(workspace.workspace_ptr->l.get());
+  std::vector<std::shared_ptr<vwpy::debug_node>> debug_info;
+  if (workspace.workspace_ptr->l->learn_returns_prediction)
+  {
+    // Learner is used directly as VW makes decisions about training and
+    // learn returns prediction in the workspace API and ends up calling
+    // potentially the wrong thing.
+    learner->learn(example);
+    if (workspace.debug) { debug_info.push_back(get_and_clear_debug_info(workspace)); }
+  }
+  else
+  {
+    // Learner is used directly as VW makes decisions about training and
+    // learn returns prediction in the workspace API and ends up calling
+    // potentially the wrong thing.
+    // We must save and restore test_only because the library sets this values and does not undo it.
+    std::vector<bool> test_onlys;
+    test_onlys.reserve(example.size());
+    for (auto ex : example) { test_onlys.push_back(ex->test_only); }
+    learner->predict(example);
+    for (size_t i = 0; i < example.size(); i++) { example[i]->test_only = test_onlys[i]; }
+    if (workspace.debug) { debug_info.push_back(get_and_clear_debug_info(workspace)); }
+    learner->learn(example);
+    if (workspace.debug) { debug_info.push_back(get_and_clear_debug_info(workspace)); }
+  }
+
+  // TODO - when updating VW submodule if learn calls update stats then remove this to avoid a double call.
+  update_stats_recursive(*workspace.workspace_ptr, *learner, example);
+  auto prediction = vwpy::to_prediction(example[0]->pred, workspace.workspace_ptr->l->get_output_prediction_type());
+  if (workspace.debug) { return std::make_tuple(prediction, debug_info); }
+  return prediction;
+}
+
+std::variant<vwpy::prediction_t, std::tuple<vwpy::prediction_t, std::shared_ptr<vwpy::debug_node>>> predict(
+    workspace_with_logger_contexts& workspace, VW::example& example)
+{
+  const auto prepared = py_setup_example(workspace, example);
+  auto on_exit = VW::scope_exit([&]() { py_unsetup_example(workspace, example, prepared); });
+  auto record = record_call_on_success(workspace.counters.get(), false, example);
+  // We must save and restore test_only because the library sets this values and does not undo it.
+  bool test_only = example.test_only;
+
+  // Learner is used directly as VW makes decisions about training and
+  // learn returns prediction in the workspace API and ends up calling
+  // potentially the wrong thing.
+  auto* learner = VW::LEARNER::require_singleline(workspace.workspace_ptr->l.get());
+  learner->predict(example);
+
+  // TODO - when updating VW submodule if learn calls update stats then remove this to avoid a double call.
+  update_stats_recursive(*workspace.workspace_ptr, *learner, example);
+  example.test_only = test_only;
+  auto prediction = vwpy::to_prediction(example.pred, workspace.workspace_ptr->l->get_output_prediction_type());
+  if (workspace.debug)
+  {
+    auto debug_info = get_and_clear_debug_info(workspace);
+    return std::make_tuple(prediction, debug_info);
+  }
+  return prediction;
+}
+
+std::variant<vwpy::prediction_t, std::tuple<vwpy::prediction_t, std::shared_ptr<vwpy::debug_node>>> predict(
+    workspace_with_logger_contexts& workspace, std::vector<VW::example*>& example)
+{
+  const auto prepared = py_setup_example(workspace, example);
+  auto on_exit = VW::scope_exit([&]() { py_unsetup_example(workspace, example, prepared); });
+  auto record = record_call_on_success(workspace.counters.get(), false, example);
+  // We must save and restore test_only because the library sets this values and does not undo it.
+  std::vector<bool> test_onlys;
+  test_onlys.reserve(example.size());
+  for (auto ex : example) { test_onlys.push_back(ex->test_only); }
+
+  // Learner is used directly as VW makes decisions about training and
+  // learn returns prediction in the workspace API and ends up calling
+  // potentially the wrong thing.
+  auto* learner = VW::LEARNER::require_multiline(workspace.workspace_ptr->l.get());
+  learner->predict(example);
+
+  // TODO - when updating VW submodule if learn calls update stats then remove this to avoid a double call.
+  update_stats_recursive(*workspace.workspace_ptr, *learner, example);
+  for (size_t i = 0; i < example.size(); i++) { example[i]->test_only = test_onlys[i]; }
+
+  auto prediction = vwpy::to_prediction(example[0]->pred, workspace.workspace_ptr->l->get_output_prediction_type());
+  if (workspace.debug)
+  {
+    auto debug_info = get_and_clear_debug_info(workspace);
+    return std::make_tuple(prediction, debug_info);
+  }
+  return prediction;
+}
+
+VW::LEARNER::learner* require_learner(VW::workspace& ws, VW::example& /* unused */)
+{
+  return VW::LEARNER::require_singleline(ws.l.get());
+}
+
+VW::LEARNER::learner* require_learner(VW::workspace& ws, VW::multi_ex& /* unused */)
+{
+  return VW::LEARNER::require_multiline(ws.l.get());
+}
+
+VW::example& deref_example(VW::example* ex) { return *ex; }
+VW::multi_ex& deref_example(VW::multi_ex& ex)
+{
+  if (ex.empty()) { throw std::invalid_argument("Multiline examples in a batch must not be empty."); }
+  return ex;
+}
+
+const VW::polyprediction& get_polyprediction(const VW::example& ex) { return ex.pred; }
+const VW::polyprediction& get_polyprediction(const VW::multi_ex& ex) { return ex[0]->pred; }
+VW::polyprediction& get_polyprediction(VW::example& ex) { return ex.pred; }
+VW::polyprediction& get_polyprediction(VW::multi_ex& ex) { return ex[0]->pred; }
+
+// We must save and restore test_only because the library sets this values and does not undo it.
+void save_test_only(const VW::example& ex, std::vector<bool>& test_onlys)
+{
+  test_onlys.clear();
+  test_onlys.push_back(ex.test_only);
+}
+
+void save_test_only(const VW::multi_ex& ex, std::vector<bool>& test_onlys)
+{
+  test_onlys.clear();
+  for (auto* e : ex) { test_onlys.push_back(e->test_only); }
+}
+
+void restore_test_only(VW::example& ex, const std::vector<bool>& test_onlys) { ex.test_only = test_onlys[0]; }
+
+void restore_test_only(VW::multi_ex& ex, const std::vector<bool>& test_onlys)
+{
+  for (size_t i = 0; i < ex.size(); i++) { ex[i]->test_only = test_onlys[i]; }
+}
+
+// As learn_prepared, without updating the shared data.
+template <typename ExampleT>
+void learn_prepared_without_stats(VW::workspace& ws, VW::LEARNER::learner& learner, ExampleT& example,
+    std::vector<bool>& test_onlys, vwpy::workspace_counters* counters)
+{
+  auto record = record_call_on_success(counters, true, example);
+  if (ws.l->learn_returns_prediction) { learner.learn(example); }
+  else
+  {
+    save_test_only(example, test_onlys);
+    learner.predict(example);
+    restore_test_only(example, test_onlys);
+    learner.learn(example);
+  }
+}
+
+// Equivalent to predict_then_learn without debug info or prediction conversion. The example must already be setup.
+template <typename ExampleT>
+void learn_prepared(VW::workspace& ws, VW::LEARNER::learner& learner, ExampleT& example, std::vector<bool>& test_onlys,
+    vwpy::workspace_counters* counters)
+{
+  learn_prepared_without_stats(ws, learner, example, test_onlys, counters);
+  update_stats_recursive(ws, learner, example);
+}
+
+// Equivalent to predict without debug info or prediction conversion. The example must already be setup.
+template <typename ExampleT>
+void predict_prepared(VW::workspace& ws, VW::LEARNER::learner& learner, ExampleT& example,
+    std::vector<bool>& test_onlys, vwpy::workspace_counters* counters)
+{
+  auto record = record_call_on_success(counters, false, example);
+  save_test_only(example, test_onlys);
+  learner.predict(example);
+  update_stats_recursive(ws, learner, example);
+  restore_test_only(example, test_onlys);
+}
+
+// The workspace lock is not needed since a frozen model is read only, callers should release the GIL.
+float predict_frozen(const vwpy::frozen_model& model, VW::example& example, vwpy::workspace_counters* counters)
+{
+  if (counters == nullptr) { return model.predict(example); }
+  const auto start = std::chrono::steady_clock::now();
+  vwpy::feature_counts counts;
+  const auto prediction = model.predict(example, &counts);
+  counters->record_call(false, elapsed_ns(start), counts.features, counts.interacted_features);
+  return prediction;
+}
 
-  if (ws.feature_tweaks_config.add_constant)
+float predict_frozen(
+    const vwpy::frozen_model& /* unused */, VW::multi_ex& /* unused */, vwpy::workspace_counters* /* unused */)
+{
+  THROW("Multiline examples are not supported by a frozen workspace.");
+}
+
+// Must be called from within run_without_gil.
+void set_frozen_model(workspace_with_logger_contexts& workspace, std::unique_ptr<vwpy::frozen_model> model)
+{
+  auto& ws = *workspace.workspace_ptr;
+  workspace.frozen_model = std::move(model);
+  // The replicas would otherwise keep the released weights alive.
+  workspace.hogwild_replicas.clear();
+  workspace.shared_weights.reset();
+  // Only the frozen copy is used from now on, so the full weights and their learning state are released. The
+  // placeholder keeps the stride so the layout of the workspace is unchanged.
+  ws.weights.dense_weights = VW::dense_parameters(1, ws.weights.stride_shift());
+  workspace.frozen.store(workspace.frozen_model.get(), std::memory_order_release);
+}
+
+void freeze(workspace_with_logger_contexts& workspace, vwpy::weight_precision precision)
+{
+  if (workspace.debug) { THROW("Freezing is not supported when the debug tree is enabled."); }
+  run_without_gil(workspace,
+      [&]() { set_frozen_model(workspace, vwpy::frozen_model::create(*workspace.workspace_ptr, precision)); });
+}
+
+// The workspace must have been created from the model data of the file. Its weights were allocated zeroed and never
+// touched, so releasing them here means loading costs the same regardless of the size of the model.
+void attach_frozen(workspace_with_logger_contexts& workspace, const vwpy::frozen_model_file& file)
+{
+  if (workspace.debug) { THROW("Freezing is not supported when the debug tree is enabled."); }
+  run_without_gil(workspace,
+      [&]() { set_frozen_model(workspace, vwpy::frozen_model::attach(*workspace.workspace_ptr, file)); });
+}
+
+void save_frozen(const workspace_with_logger_contexts& workspace, const std::string& path)
+{
+  const auto* frozen = get_frozen_model(workspace);
+  if (frozen == nullptr) { THROW("Only a frozen workspace can be saved as a frozen model file."); }
+
+  // Not run_without_gil, since that rejects frozen workspaces. The weights of the workspace are the empty placeholder
+  // left by freezing, so the saved model holds everything except the weights.
+  py::gil_scoped_release release;
+  std::lock_guard<std::mutex> lock(workspace.mutex);
+  auto backing_vector = std::make_shared<std::vector<char>>();
+  VW::io_buf io_writer;
+  io_writer.add_file(VW::io::create_vector_writer(backing_vector));
+  VW::save_predictor(*workspace.workspace_ptr, io_writer);
+  io_writer.flush();
+  frozen->save(path, backing_vector->data(), backing_vector->size());
+}
+
+// The model is streamed through the io_buf's buffer, so it is never held in memory in full.
+void serialize_to(const workspace_with_logger_contexts& workspace, std::unique_ptr<VW::io::writer> output)
+{
+  VW::io_buf io_writer;
+  io_writer.add_file(std::move(output));
+  // The io_buf outlives the GIL release since a python_writer must be destroyed with the GIL held.
+  run_without_gil(workspace,
+      [&]()
+      {
+        VW::save_predictor(*workspace.workspace_ptr, io_writer);
+        io_writer.flush();
+      });
+}
+
+// The workspace lock is held only while the snapshot is taken, and for how long is recorded in the checkpoint stats.
+std::unique_ptr<vwpy::workspace_snapshot> take_snapshot(workspace_with_logger_contexts& workspace)
+{
+  return run_without_gil(workspace,
+      [&]()
+      {
+        const auto start = std::chrono::steady_clock::now();
+        auto snapshot = vwpy::workspace_snapshot::take(*workspace.workspace_ptr);
+        workspace.checkpoint_stats.record_pause(std::chrono::steady_clock::now() - start);
+        return snapshot;
+      });
+}
+
+// Doesn't need the workspace, so other threads can keep learning while this runs. The file is written next to the
+// destination, synced and renamed into place so that a partially written checkpoint never replaces a complete one.
+void write_snapshot_to_file(const vwpy::workspace_snapshot& snapshot, const std::string& path)
+{
+  py::gil_scoped_release release;
+  vwpy::atomic_file_writer writer(path);
+  snapshot.write(writer);
+  writer.commit();
+}
+
+void restore_checkpoint(workspace_with_logger_contexts& workspace, const vwpy::checkpoint_file& file)
+{
+  run_without_gil(workspace,
+      [&]()
+      {
+        own_weights(workspace);
+        vwpy::restore_checkpoint(*workspace.workspace_ptr, file);
+      });
+}
+
+// The clone is created with the arguments of the workspace from its model without the weights, which restores the
+// learning state kept outside of the weights, and the weights are then copied or shared directly. Everything happens
+// under the workspace lock so the clone matches the workspace at a single point in time.
+std::unique_ptr<workspace_with_logger_contexts> clone_workspace(
+    workspace_with_logger_contexts& workspace, bool share_weights)
+{
+  return run_without_gil(workspace,
+      [&]()
+      {
+        auto& ws = *workspace.workspace_ptr;
+        const auto model = vwpy::save_model_without_weights(ws);
+        std::unique_ptr<workspace_with_logger_contexts> result;
+        {
+          // The lock is held while the GIL is taken, as when logging from a call which holds the lock.
+          py::gil_scoped_acquire acquire;
+          result = create_workspace(workspace.args, VW::io::create_buffer_view(model.data(), model.size()),
+              workspace.record_feature_names, workspace.record_metrics, workspace.counters != nullptr, workspace.debug,
+              workspace.profile != nullptr, workspace.debug_sampling, workspace.debug_fields);
+        }
+
+        auto& source = ws.weights.dense_weights;
+        auto& destination = result->workspace_ptr->weights.dense_weights;
+        if (share_weights)
+        {
+          if (workspace.shared_weights == nullptr) { workspace.shared_weights = std::make_shared<const char>(0); }
+          destination.shallow_copy(source);
+          result->shared_weights = workspace.shared_weights;
+        }
+        else { std::memcpy(destination.first(), source.first(), (source.mask() + 1) * sizeof(float)); }
+        return result;
+      });
+}
+
+// Collects the predictions of a batch call into NumPy arrays. Fixed size predictions are written directly into a
+// preallocated array. Variable length predictions are packed into flat arrays along with an offsets array where the
+// predictions of example i are in the range [offsets[i], offsets[i + 1]).
+class batch_prediction_writer
+{
+public:
+  // Must be called with the GIL held.
+  batch_prediction_writer(VW::prediction_type_t type, size_t num_examples) : _type(type)
   {
-    if (ex.feature_space[VW::details::CONSTANT_NAMESPACE].size() != 1)
+    switch (_type)
     {
-      THROW("Constant feature not found. This should not happen.");
+      case VW::prediction_type_t::SCALAR:
+      case VW::prediction_type_t::PROB:
+        _float_output = py::array_t<float>(num_examples);
+        _float_data = _float_output.mutable_data();
+        break;
+      case VW::prediction_type_t::MULTICLASS:
+        _uint_output = py::array_t<uint32_t>(num_examples);
+        _uint_data = _uint_output.mutable_data();
+        break;
+      case VW::prediction_type_t::SCALARS:
+      case VW::prediction_type_t::ACTION_SCORES:
+      case VW::prediction_type_t::ACTION_PROBS:
+        _offsets.reserve(num_examples + 1);
+        _offsets.push_back(0);
+        break;
+      default:
+        throw std::invalid_argument(
+            fmt::format("Prediction type '{}' is not supported by batch prediction.", VW::to_string(_type)));
     }
-    ex.feature_space[VW::details::CONSTANT_NAMESPACE].clear();
-    auto num_times = std::count(ex.indices.begin(), ex.indices.end(), VW::details::CONSTANT_NAMESPACE);
-    if (num_times != 1) { THROW("Constant index not found. This should not happen."); }
-    auto it = std::find(ex.indices.begin(), ex.indices.end(), VW::details::CONSTANT_NAMESPACE);
-    ex.indices.erase(it);
   }
 
-  uint32_t multiplier = ws.reduction_state.total_feature_width << ws.weights.stride_shift();
-  if (multiplier != 1)
+  // Does not require the GIL. Only valid for Scalar predictions.
+  void write_scalar(size_t i, float value) { _float_data[i] = value; }
+
+  // Does not require the GIL. Must be called for each example in order.
+  void write(size_t i, const VW::polyprediction& pred)
   {
-    for (auto ns : ex.indices)
+    switch (_type)
     {
-      for (auto& idx : ex.feature_space[ns].indices) { idx /= multiplier; }
+      case VW::prediction_type_t::SCALAR:
+        _float_data[i] = pred.scalar;
+        break;
+      case VW::prediction_type_t::PROB:
+        _float_data[i] = pred.prob;
+        break;
+      case VW::prediction_type_t::MULTICLASS:
+        _uint_data[i] = pred.multiclass;
+        break;
+      case VW::prediction_type_t::SCALARS:
+        _values.insert(_values.end(), pred.scalars.begin(), pred.scalars.end());
+        _offsets.push_back(static_cast<int64_t>(_values.size()));
+        break;
+      case VW::prediction_type_t::ACTION_SCORES:
+      case VW::prediction_type_t::ACTION_PROBS:
+        for (const auto& action_score : pred.a_s)
+        {
+          _ids.push_back(action_score.action);
+          _values.push_back(action_score.score);
+        }
+        _offsets.push_back(static_cast<int64_t>(_values.size()));
+        break;
+      default:
+        break;
     }
   }
 
-  if (ex.interactions == nullptr)
+  // Must be called with the GIL held.
+  py::object finish()
   {
-    THROW("Example has either already been unsetup, or was never setup. This should never happen and is a bug.")
+    switch (_type)
+    {
+      case VW::prediction_type_t::SCALAR:
+      case VW::prediction_type_t::PROB:
+        return std::move(_float_output);
+      case VW::prediction_type_t::MULTICLASS:
+        return std::move(_uint_output);
+      case VW::prediction_type_t::SCALARS:
+        return py::make_tuple(py::array_t<int64_t>(_offsets.size(), _offsets.data()),
+            py::array_t<float>(_values.size(), _values.data()));
+      default:
+        return py::make_tuple(py::array_t<int64_t>(_offsets.size(), _offsets.data()),
+            py::array_t<uint32_t>(_ids.size(), _ids.data()), py::array_t<float>(_values.size(), _values.data()));
+    }
   }
 
-  ex.interactions = nullptr;
-  ex.extent_interactions = nullptr;
+private:
+  VW::prediction_type_t _type;
+  py::array_t<float> _float_output;
+  float* _float_data = nullptr;
+  py::array_t<uint32_t> _uint_output;
+  uint32_t* _uint_data = nullptr;
+  std::vector<int64_t> _offsets;
+  std::vector<uint32_t> _ids;
+  std::vector<float> _values;
+};
+
+// Returns an array for n elements of T. If out is given the result is a view of its first n elements, otherwise a new
+// array is allocated. needed_by names what the array is for in the error raised if out is too small. Must be called
+// with the GIL held.
+template <typename T>
+py::array_t<T> make_output_array(const std::optional<py::array>& out, size_t n, const char* needed_by)
+{
+  if (!out.has_value()) { return py::array_t<T>(n); }
+  const auto& buffer = *out;
+  if (!py::isinstance<py::array_t<T, py::array::c_style>>(buffer) || buffer.ndim() != 1)
+  {
+    throw std::invalid_argument(fmt::format("Output buffer must be a contiguous 1-dimensional array of dtype {}.",
+        py::str(py::dtype::of<T>()).cast<std::string>()));
+  }
+  if (!buffer.writeable()) { throw std::invalid_argument("Output buffer must be writeable."); }
+  if (static_cast<size_t>(buffer.shape(0)) < n)
+  {
+    throw std::invalid_argument(
+        fmt::format("Output buffer has {} elements but {} needs {}.", buffer.shape(0), needed_by, n));
+  }
+  return py::array_t<T>(n, static_cast<T*>(const_cast<void*>(buffer.data())), buffer);
 }
 
-void py_unsetup_example(VW::workspace& ws, std::vector<VW::example*>& ex)
+// Must be called with the GIL held.
+template <typename T, typename ContainerT>
+py::array copy_to_prediction_array(const ContainerT& values, const std::optional<py::array>& out)
 {
-  for (auto& example : ex) { py_unsetup_example(ws, *example); }
+  auto result = make_output_array<T>(out, values.size(), "the prediction");
+  std::copy(values.begin(), values.end(), result.mutable_data());
+  return std::move(result);
 }
 
-// Because of the GIL we can use globals here.
-static bool SIGINT_CALLED = false;
-static VW::workspace* CLI_DRIVER_WORKSPACE = nullptr;
+// Converts a prediction into NumPy arrays with a single copy out of the prediction's storage. Must be called with the
+// GIL held.
+py::object to_numpy_prediction(
+    const VW::polyprediction& pred, VW::prediction_type_t type, const std::optional<py::array>& out)
+{
+  switch (type)
+  {
+    case VW::prediction_type_t::SCALAR:
+      return copy_to_prediction_array<float>(std::array<float, 1>{pred.scalar}, out);
+    case VW::prediction_type_t::PROB:
+      return copy_to_prediction_array<float>(std::array<float, 1>{pred.prob}, out);
+    case VW::prediction_type_t::MULTICLASS:
+      return copy_to_prediction_array<uint32_t>(std::array<uint32_t, 1>{pred.multiclass}, out);
+    case VW::prediction_type_t::SCALARS:
+      return copy_to_prediction_array<float>(pred.scalars, out);
+    case VW::prediction_type_t::ACTION_SCORES:
+    case VW::prediction_type_t::ACTION_PROBS:
+      return copy_to_prediction_array<VW::action_score>(pred.a_s, out);
+    case VW::prediction_type_t::PDF:
+      return copy_to_prediction_array<VW::continuous_actions::pdf_segment>(pred.pdf, out);
+    case VW::prediction_type_t::MULTILABELS:
+      return copy_to_prediction_array<uint32_t>(pred.multilabels.label_v, out);
+    case VW::prediction_type_t::DECISION_PROBS:
+    {
+      if (out.has_value()) { throw std::invalid_argument("An output buffer is not supported for DecisionProbs."); }
+      py::array_t<int64_t> offsets(pred.decision_scores.size() + 1);
+      auto* offsets_data = offsets.mutable_data();
+      offsets_data[0] = 0;
+      for (size_t i = 0; i < pred.decision_scores.size(); i++)
+      {
+        offsets_data[i + 1] = offsets_data[i] + static_cast<int64_t>(pred.decision_scores[i].size());
+      }
+      py::array_t<VW::action_score> records(static_cast<size_t>(offsets_data[pred.decision_scores.size()]));
+      auto* records_data = records.mutable_data();
+      for (const auto& decision_scores : pred.decision_scores)
+      {
+        records_data = std::copy(decision_scores.begin(), decision_scores.end(), records_data);
+      }
+      return py::make_tuple(offsets, records);
+    }
+    default:
+      throw std::invalid_argument(
+          fmt::format("Prediction type '{}' is not supported by NumPy prediction.", VW::to_string(type)));
+  }
+}
 
-// return type is an optional error information (nullopt if success), driver output, list of log messages
-// stdin is not supported
-std::tuple<std::optional<std::string>, std::string, std::vector<std::string>> run_cli_driver(
-    const std::vector<std::string>& args, bool onethread)
+// Equivalent to predict but returns the prediction as NumPy arrays, optionally written into out.
+template <typename ExampleT>
+py::object predict_numpy(
+    workspace_with_logger_contexts& workspace, ExampleT& example, const std::optional<py::array>& out)
 {
-  SIGINT_CALLED = false;
-  CLI_DRIVER_WORKSPACE = nullptr;
-  std::signal(SIGINT,
-      [](int)
+  if (workspace.debug) { THROW("NumPy prediction is not supported when the debug tree is enabled."); }
+  const auto type = workspace.workspace_ptr->l->get_output_prediction_type();
+  VW::polyprediction pred;
+  if (const auto* frozen = get_frozen_model(workspace))
+  {
+    {
+      py::gil_scoped_release release;
+      pred.scalar = predict_frozen(*frozen, example, workspace.counters.get());
+    }
+    return to_numpy_prediction(pred, type, out);
+  }
+  run_without_gil(workspace,
+      [&]()
       {
-        if (CLI_DRIVER_WORKSPACE != nullptr) { VW::details::set_done(*CLI_DRIVER_WORKSPACE); }
-        SIGINT_CALLED = true;
+        auto& ws = *workspace.workspace_ptr;
+        auto* learner = require_learner(ws, example);
+        std::vector<bool> test_onlys;
+        const auto prepared = py_setup_example(workspace, example);
+        auto on_exit = VW::scope_exit([&]() { py_unsetup_example(workspace, example, prepared); });
+        predict_prepared(ws, *learner, example, test_onlys, workspace.counters.get());
+        // Unsetup clears the prediction, moving it out keeps its buffers without a copy.
+        pred = std::move(get_polyprediction(example));
       });
+  return to_numpy_prediction(pred, type, out);
+}
 
-  auto args_copy = args;
-  args_copy.push_back("--no_stdin");
-  auto options = VW::make_unique<VW::config::options_cli>(args_copy);
-  std::stringstream driver_log;
-  std::vector<std::string> log_log;
+void check_batch_supported(const workspace_with_logger_contexts& workspace)
+{
+  if (workspace.debug) { THROW("Batch learn and predict are not supported when the debug tree is enabled."); }
+}
 
-  auto logger = VW::io::create_custom_sink_logger(&log_log,
-      [](void* context, VW::io::log_level /* unused */, const std::string& message)
+// BatchT is either std::vector<VW::example*> or std::vector<VW::multi_ex>. The GIL is released and the workspace lock
+// taken once for the entire batch.
+template <typename BatchT>
+void learn_batch(workspace_with_logger_contexts& workspace, BatchT& examples)
+{
+  check_batch_supported(workspace);
+  if (examples.empty()) { return; }
+  run_without_gil(workspace,
+      [&]()
       {
-        auto* log_log = static_cast<std::vector<std::string>*>(context);
-        log_log->push_back(message);
+        own_weights(workspace);
+        auto& ws = *workspace.workspace_ptr;
+        auto* learner = require_learner(ws, deref_example(examples[0]));
+        std::vector<bool> test_onlys;
+        for (auto& item : examples)
+        {
+          auto& example = deref_example(item);
+          const auto prepared = py_setup_example(workspace, example);
+          auto on_exit = VW::scope_exit([&]() { py_unsetup_example(workspace, example, prepared); });
+          learn_prepared(ws, *learner, example, test_onlys, workspace.counters.get());
+        }
       });
+}
 
-  auto driver_logger = [](void* context, const std::string& message)
+template <typename BatchT>
+py::object predict_batch(workspace_with_logger_contexts& workspace, BatchT& examples)
+{
+  check_batch_supported(workspace);
+  batch_prediction_writer writer(workspace.workspace_ptr->l->get_output_prediction_type(), examples.size());
+  if (const auto* frozen = get_frozen_model(workspace))
   {
-    auto* driver_log = static_cast<std::stringstream*>(context);
-    *driver_log << message;
-  };
+    py::gil_scoped_release release;
+    for (size_t i = 0; i < examples.size(); i++)
+    {
+      writer.write_scalar(i, predict_frozen(*frozen, deref_example(examples[i]), workspace.counters.get()));
+    }
+  }
+  else if (!examples.empty())
+  {
+    run_without_gil(workspace,
+        [&]()
+        {
+          auto& ws = *workspace.workspace_ptr;
+          auto* learner = require_learner(ws, deref_example(examples[0]));
+          std::vector<bool> test_onlys;
+          for (size_t i = 0; i < examples.size(); i++)
+          {
+            auto& example = deref_example(examples[i]);
+            const auto prepared = py_setup_example(workspace, example);
+            // Unsetup clears the prediction so it must be written out first.
+            auto on_exit = VW::scope_exit([&]() { py_unsetup_example(workspace, example, prepared); });
+            predict_prepared(ws, *learner, example, test_onlys, workspace.counters.get());
+            writer.write(i, get_polyprediction(example));
+          }
+        });
+  }
+  return writer.finish();
+}
+
+// State shared between train_from_file and its parsing thread. Examples are allocated by the parsing thread, handed to
+// the learning thread through parsed and handed back for reuse through recycled. This acts as a pool local to the
+// parsing thread, so the hand off between the threads needs no locks.
+struct parse_pipeline
+{
+  explicit parse_pipeline(size_t queue_size) : parsed(queue_size), recycled(std::max<size_t>(queue_size * 16, 1024)) {}
+
+  // An empty group marks the end of a pass.
+  vwpy::spsc_queue<VW::multi_ex> parsed;
+  vwpy::spsc_queue<VW::example*> recycled;
+  std::atomic<bool> cancelled{false};
+  std::atomic<bool> producer_failed{false};
+  // Written before producer_failed is set.
+  std::exception_ptr producer_error;
+
+  // Only accessed by the parsing thread until it is joined.
+  std::vector<std::unique_ptr<VW::example>> owned_examples;
+  std::vector<VW::example*> spare_examples;
+};
 
+void run_parse_producer(
+    VW::workspace& ws, parse_pipeline& pipeline, const std::string& path, input_format format, size_t passes)
+{
   try
   {
-    auto all = VW::initialize_experimental(std::move(options), nullptr, driver_logger, &driver_log, &logger);
-    all->runtime_config.vw_is_main = true;
-    CLI_DRIVER_WORKSPACE = all.get();
+    example_allocator allocator{[&pipeline]() -> VW::example*
+        {
+          VW::example* ex = nullptr;
+          if (!pipeline.spare_examples.empty())
+          {
+            ex = pipeline.spare_examples.back();
+            pipeline.spare_examples.pop_back();
+            return ex;
+          }
+          if (pipeline.recycled.try_pop(ex)) { return ex; }
+          pipeline.owned_examples.push_back(VW::make_unique<VW::example>());
+          return pipeline.owned_examples.back().get();
+        },
+        [&pipeline](VW::example* ex)
+        {
+          clean_example(*ex);
+          pipeline.spare_examples.push_back(ex);
+        }};
 
-    // If sigint was called before we got here, we should avoid running the driver.
-    if (!SIGINT_CALLED)
+    for (size_t pass = 0; pass < passes; pass++)
     {
-      if (onethread) { VW::LEARNER::generic_driver_onethread(*all); }
-      else
-      {
-        VW::start_parser(*all);
-        VW::LEARNER::generic_driver(*all);
-        VW::end_parser(*all);
-      }
-
-      if (all->parser_runtime.example_parser->exc_ptr)
+      example_file_parser parser(ws, open_input(path), format, allocator);
+      VW::multi_ex group;
+      while (parser.next(group))
       {
-        std::rethrow_exception(all->parser_runtime.example_parser->exc_ptr);
+        if (!pipeline.parsed.push(std::move(group), pipeline.cancelled)) { return; }
+        group.clear();
       }
-      VW::sync_stats(*all);
-      all->finish();
+      if (!pipeline.parsed.push(VW::multi_ex{}, pipeline.cancelled)) { return; }
     }
   }
-  catch (const std::exception& ex)
+  catch (...)
   {
-    return std::make_tuple(ex.what(), driver_log.str(), log_log);
+    pipeline.producer_error = std::current_exception();
+    pipeline.producer_failed.store(true, std::memory_order_release);
   }
-  catch (...)
+}
+
+// Parses the file on a background thread while learning from the examples on the calling thread, overlapping I/O and
+// parsing with learning. A single parsing thread is used since online learning depends on the order of examples.
+// end_pass is called after each pass. Returns the number of examples, or multiline examples, learned from.
+size_t train_from_file(workspace_with_logger_contexts& workspace, const std::string& path, input_format format,
+    size_t passes, size_t queue_size)
+{
+  if (workspace.debug) { THROW("train_from_file is not supported when the debug tree is enabled."); }
+  if (passes == 0) { throw std::invalid_argument("passes must be at least 1."); }
+  if (queue_size == 0) { throw std::invalid_argument("queue_size must be at least 1."); }
+
+  return run_without_gil(workspace,
+      [&]() -> size_t
+      {
+        own_weights(workspace);
+        auto& ws = *workspace.workspace_ptr;
+        const bool multiline = ws.l->is_multiline();
+        auto* learner = multiline ? VW::LEARNER::require_multiline(ws.l.get())
+                                  : VW::LEARNER::require_singleline(ws.l.get());
+
+        parse_pipeline pipeline(queue_size);
+        std::thread producer([&]() { run_parse_producer(ws, pipeline, path, format, passes); });
+        auto join_producer = VW::scope_exit(
+            [&]()
+            {
+              pipeline.cancelled.store(true, std::memory_order_release);
+              if (producer.joinable()) { producer.join(); }
+            });
+
+        size_t examples_learned = 0;
+        size_t passes_completed = 0;
+        std::vector<bool> test_onlys;
+        VW::multi_ex group;
+        while (passes_completed < passes && pipeline.parsed.pop(group, pipeline.producer_failed))
+        {
+          if (group.empty())
+          {
+            ws.passes_config.current_pass++;
+            ws.l->end_pass();
+            passes_completed++;
+            continue;
+          }
+
+          auto recycle = VW::scope_exit(
+              [&]()
+              {
+                for (auto* ex : group)
+                {
+                  clean_example(*ex);
+                  // If the queue is full the example stays owned by the pipeline and is freed at the end.
+                  pipeline.recycled.try_push(std::move(ex));
+                }
+                group.clear();
+              });
+          if (multiline)
+          {
+            const auto prepared = py_setup_example(workspace, group);
+            auto on_exit = VW::scope_exit([&]() { py_unsetup_example(workspace, group, prepared); });
+            learn_prepared(ws, *learner, group, test_onlys, workspace.counters.get());
+          }
+          else
+          {
+            auto& ex = *group[0];
+            const auto prepared = py_setup_example(workspace, ex);
+            auto on_exit = VW::scope_exit([&]() { py_unsetup_example(workspace, ex, prepared); });
+            learn_prepared(ws, *learner, ex, test_onlys, workspace.counters.get());
+          }
+          examples_learned++;
+        }
+
+        producer.join();
+        if (pipeline.producer_failed.load(std::memory_order_acquire))
+        {
+          std::rethrow_exception(pipeline.producer_error);
+        }
+        return examples_learned;
+      });
+}
+
+// Examples are handed to the learning threads of learn_parallel in batches of this size.
+constexpr size_t HOGWILD_BATCH_SIZE = 64;
+
+// Only the linear learners tolerate unsynchronized updates of their weights from many threads. The caller must hold the
+// workspace lock.
+void check_hogwild_supported(const workspace_with_logger_contexts& workspace, size_t num_threads)
+{
+  if (workspace.debug) { THROW("learn_parallel is not supported when the debug tree is enabled."); }
+  if (num_threads == 0) { throw std::invalid_argument("threads must be at least 1."); }
+  auto& ws = *workspace.workspace_ptr;
+  if (ws.weights.sparse) { throw std::invalid_argument("learn_parallel is only supported for dense weights."); }
+  std::vector<std::string> enabled_learners;
+  ws.l->get_enabled_learners(enabled_learners);
+  for (const auto& name : enabled_learners)
   {
-    return std::make_tuple("Unknown exception occurred", driver_log.str(), log_log);
+    if (name == "gd" || name == "count_label" || name.rfind("scorer-", 0) == 0) { continue; }
+    throw std::invalid_argument(
+        "learn_parallel only supports linear models, but the reduction '" + name + "' is enabled.");
   }
+}
 
-  SIGINT_CALLED = false;
-  CLI_DRIVER_WORKSPACE = nullptr;
-  return std::make_tuple(std::nullopt, driver_log.str(), log_log);
+// The same example on two threads at once would be a data race.
+void check_distinct_examples(std::vector<VW::example*> examples, const std::string& function_name)
+{
+  std::sort(examples.begin(), examples.end());
+  if (std::adjacent_find(examples.begin(), examples.end()) != examples.end())
+  {
+    throw std::invalid_argument("Each example may only be given once to " + function_name + ".");
+  }
 }
 
-struct dense_weight_holder
+// The shared data updates of the examples one thread of learn_parallel learned from. The replicas share the shared data
+// of the workspace, so instead of each thread updating it the threads count their own and the counts are added to it
+// once they are joined. Padded to a cache line so the counts of different threads don't share one.
+struct alignas(64) hogwild_stats
 {
-  dense_weight_holder(VW::dense_parameters* weights, size_t total_feature_width, std::shared_ptr<VW::workspace> ws)
-      : weights(weights), total_feature_width(total_feature_width), ws(ws)
+  double weight = 0.;
+  double weighted_labeled_examples = 0.;
+  double weighted_unlabeled_examples = 0.;
+  double weighted_labels = 0.;
+  double sum_loss = 0.;
+  double weighted_holdout_examples = 0.;
+  double holdout_sum_loss = 0.;
+  uint64_t example_number = 0;
+  uint64_t total_features = 0;
+
+  // Equivalent to the update_stats of the simple label reductions learn_parallel supports.
+  void record(const VW::example& ex)
   {
+    const auto& label = ex.l.simple;
+    const bool labeled = label.label != FLT_MAX;
+    weight += ex.weight;
+    if (ex.test_only && labeled)
+    {
+      weighted_holdout_examples += ex.weight;
+      holdout_sum_loss += ex.loss;
+      return;
+    }
+    if (labeled)
+    {
+      weighted_labeled_examples += ex.weight;
+      weighted_labels += label.label * ex.weight;
+    }
+    else { weighted_unlabeled_examples += ex.weight; }
+    sum_loss += ex.loss;
+    total_features += ex.get_num_features();
+    example_number++;
   }
 
-  VW::dense_parameters* weights;
-  size_t total_feature_width;
-  std::shared_ptr<VW::workspace> ws;
+  void add_to(VW::shared_data& sd) const
+  {
+    sd.t += weight;
+    sd.weighted_labeled_examples += weighted_labeled_examples;
+    sd.weighted_unlabeled_examples += weighted_unlabeled_examples;
+    sd.weighted_labels += weighted_labels;
+    sd.sum_loss += sum_loss;
+    sd.sum_loss_since_last_dump += sum_loss;
+    sd.weighted_holdout_examples += weighted_holdout_examples;
+    sd.weighted_holdout_examples_since_last_dump += weighted_holdout_examples;
+    sd.weighted_holdout_examples_since_last_pass += weighted_holdout_examples;
+    sd.holdout_sum_loss += holdout_sum_loss;
+    sd.holdout_sum_loss_since_last_dump += holdout_sum_loss;
+    sd.holdout_sum_loss_since_last_pass += holdout_sum_loss;
+    sd.example_number += example_number;
+    sd.total_features += total_features;
+  }
 };
 
-struct python_dict_writer : VW::metric_sink_visitor
+// Learns from an example on a thread of run_hogwild. If stats is null there are no other threads, so the shared data is
+// updated as it is by learn_batch. Otherwise the update is counted in stats.
+void learn_hogwild(VW::workspace& ws, VW::LEARNER::learner& learner, VW::example& ex, std::vector<bool>& test_onlys,
+    vwpy::workspace_counters* counters, hogwild_stats* stats)
 {
-  python_dict_writer(py::dict& dest_dict) : _dest_dict(dest_dict) {}
-  void int_metric(const std::string& key, uint64_t value) override { _dest_dict[key.c_str()] = value; }
-  void float_metric(const std::string& key, float value) override { _dest_dict[key.c_str()] = value; }
-  void string_metric(const std::string& key, const std::string& value) override { _dest_dict[key.c_str()] = value; }
-  void bool_metric(const std::string& key, bool value) override { _dest_dict[key.c_str()] = value; }
-  void sink_metric(const std::string& key, const VW::metric_sink& value) override
+  if (stats == nullptr)
   {
-    py::dict nested;
-    auto nested_py = python_dict_writer(nested);
-    value.visit(nested_py);
-    _dest_dict[key.c_str()] = nested;
+    learn_prepared(ws, learner, ex, test_onlys, counters);
+    return;
+  }
+  learn_prepared_without_stats(ws, learner, ex, test_onlys, counters);
+  stats->record(ex);
+}
+
+// Runs worker(ws, stats) on the calling thread with the workspace itself and on num_threads - 1 more threads with its
+// replicas, then rethrows the first error. An error sets stop, which workers check between batches. Workers learn with
+// learn_hogwild, the counts in stats are added to the workspace's shared data once all threads are joined. The caller
+// must hold the workspace lock.
+template <typename WorkerT>
+void run_hogwild(
+    workspace_with_logger_contexts& workspace, size_t num_threads, std::atomic<bool>& stop, WorkerT&& worker)
+{
+  // Each replica shares the weights and shared data of the workspace but has its own reduction stack, so the state
+  // learners keep for a call is never shared between threads. They are kept for later calls since creating one
+  // initializes a workspace.
+  auto null_logger = VW::io::create_null_logger();
+  while (workspace.hogwild_replicas.size() < num_threads - 1)
+  {
+    workspace.hogwild_replicas.push_back(
+        VW::seed_vw_model(*workspace.workspace_ptr, {"--quiet"}, nullptr, nullptr, &null_logger));
   }
 
-private:
-  py::dict& _dest_dict;
-};
+  std::vector<std::exception_ptr> errors(num_threads);
+  std::vector<hogwild_stats> stats(num_threads);
+  const auto run_worker = [&](size_t i, VW::workspace& ws)
+  {
+    try
+    {
+      worker(ws, num_threads == 1 ? nullptr : &stats[i]);
+    }
+    catch (...)
+    {
+      errors[i] = std::current_exception();
+      stop.store(true, std::memory_order_release);
+    }
+  };
+
+  {
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads - 1);
+    auto join_threads = VW::scope_exit(
+        [&]()
+        {
+          // Only reached with unfinished workers if starting a thread failed.
+          if (threads.size() < num_threads - 1) { stop.store(true, std::memory_order_release); }
+          for (auto& thread : threads) { thread.join(); }
+        });
+    for (size_t i = 1; i < num_threads; i++)
+    {
+      threads.emplace_back(run_worker, i, std::ref(*workspace.hogwild_replicas[i - 1]));
+    }
+    run_worker(0, *workspace.workspace_ptr);
+  }
+  // Examples learned from before an error still changed the weights, so they are counted either way.
+  for (const auto& thread_stats : stats) { thread_stats.add_to(*workspace.workspace_ptr->sd); }
+  for (const auto& error : errors)
+  {
+    if (error != nullptr) { std::rethrow_exception(error); }
+  }
+}
+
+// Learns from examples on num_threads threads which update the same weights without synchronization, as in Hogwild!.
+// Examples are setup for the workspace itself, its replicas use the same options so they share the feature layout.
+size_t learn_parallel(
+    workspace_with_logger_contexts& workspace, std::vector<VW::example*>& examples, size_t num_threads)
+{
+  check_distinct_examples(examples, "learn_parallel");
+  return run_without_gil(workspace,
+      [&]() -> size_t
+      {
+        check_hogwild_supported(workspace, num_threads);
+        own_weights(workspace);
+        std::atomic<size_t> next{0};
+        std::atomic<bool> stop{false};
+        run_hogwild(workspace, num_threads, stop,
+            [&](VW::workspace& ws, hogwild_stats* stats)
+            {
+              auto* learner = VW::LEARNER::require_singleline(ws.l.get());
+              std::vector<bool> test_onlys;
+              while (!stop.load(std::memory_order_acquire))
+              {
+                const size_t begin = next.fetch_add(HOGWILD_BATCH_SIZE, std::memory_order_relaxed);
+                if (begin >= examples.size()) { return; }
+                const size_t end = std::min(begin + HOGWILD_BATCH_SIZE, examples.size());
+                for (size_t i = begin; i < end; i++)
+                {
+                  auto& ex = *examples[i];
+                  const auto prepared = py_setup_example(workspace, ex);
+                  auto on_exit = VW::scope_exit([&]() { py_unsetup_example(workspace, ex, prepared); });
+                  learn_hogwild(ws, *learner, ex, test_onlys, workspace.counters.get(), stats);
+                }
+              }
+            });
+        return examples.size();
+      });
+}
+
+// As learn_parallel, reading examples from a file. The parser is shared by the learning threads, each takes the lock to
+// parse its next batch while the others keep learning. Returns the number of examples learned from.
+size_t learn_parallel_from_file(
+    workspace_with_logger_contexts& workspace, const std::string& path, input_format format, size_t num_threads)
+{
+  return run_without_gil(workspace,
+      [&]() -> size_t
+      {
+        check_hogwild_supported(workspace, num_threads);
+        own_weights(workspace);
+
+        // Examples are only allocated and returned for reuse under parser_mutex.
+        std::mutex parser_mutex;
+        std::vector<std::unique_ptr<VW::example>> owned_examples;
+        std::vector<VW::example*> spare_examples;
+        const auto allocator = reusing_allocator(owned_examples, spare_examples);
+        example_file_parser parser(*workspace.workspace_ptr, open_input(path), format, allocator);
+        bool end_of_input = false;
+
+        std::atomic<size_t> examples_learned{0};
+        std::atomic<bool> stop{false};
+        run_hogwild(workspace, num_threads, stop,
+            [&](VW::workspace& ws, hogwild_stats* stats)
+            {
+              auto* learner = VW::LEARNER::require_singleline(ws.l.get());
+              std::vector<bool> test_onlys;
+              std::vector<VW::example*> batch;
+              VW::multi_ex group;
+              auto return_batch = [&]()
+              {
+                for (auto* ex : batch) { allocator.release(ex); }
+                batch.clear();
+              };
+              while (!stop.load(std::memory_order_acquire))
+              {
+                {
+                  std::lock_guard<std::mutex> lock(parser_mutex);
+                  return_batch();
+                  while (batch.size() < HOGWILD_BATCH_SIZE && !end_of_input)
+                  {
+                    end_of_input = !parser.next(group);
+                    if (!end_of_input) { batch.push_back(group[0]); }
+                    group.clear();
+                  }
+                }
+                if (batch.empty()) { return; }
+                for (auto* ex : batch)
+                {
+                  const auto prepared = py_setup_example(workspace, *ex);
+                  auto on_exit = VW::scope_exit([&]() { py_unsetup_example(workspace, *ex, prepared); });
+                  learn_hogwild(ws, *learner, *ex, test_onlys, workspace.counters.get(), stats);
+                }
+                examples_learned.fetch_add(batch.size(), std::memory_order_relaxed);
+              }
+            });
+        return examples_learned.load();
+      });
+}
 
-py::dict convert_metrics_to_dict(const VW::metric_sink& metrics)
+void check_data_parallel_supported(
+    const workspace_with_logger_contexts& workspace, size_t num_replicas, size_t sync_interval)
 {
-  py::dict dictionary;
-  python_dict_writer writer(dictionary);
-  metrics.visit(writer);
-  return dictionary;
+  if (workspace.debug) { THROW("train_data_parallel is not supported when the debug tree is enabled."); }
+  if (num_replicas == 0) { throw std::invalid_argument("replicas must be at least 1."); }
+  if (sync_interval == 0) { throw std::invalid_argument("sync_interval must be at least 1."); }
+  if (workspace.workspace_ptr->weights.sparse)
+  {
+    throw std::invalid_argument("train_data_parallel is only supported for dense weights.");
+  }
 }
 
-// Labels
-
-bool is_shared(const VW::cs_label& label)
+// Copies all the dense weights of one workspace into another with the same layout.
+void copy_dense_weights(VW::workspace& from, VW::workspace& to)
 {
-  const auto& costs = label.costs;
-  if (costs.size() != 1) { return false; }
-  if (costs[0].class_index != 0) { return false; }
-  if (costs[0].x != -FLT_MAX) { return false; }
-  return true;
+  auto& source = from.weights.dense_weights;
+  std::memcpy(to.weights.dense_weights.first(), source.first(), (source.mask() + 1) * sizeof(float));
 }
 
-// TODO: create a version of this that can be used in learn that doesn't involve
-// copying the prediction and then not using the value.
-std::variant<vwpy::prediction_t, std::tuple<vwpy::prediction_t, std::vector<std::shared_ptr<vwpy::debug_node>>>>
-predict_then_learn(workspace_with_logger_contexts& workspace, VW::example& example)
+// Trains num_replicas copies of the workspace, each on its own thread, on interleaved shards of each round of examples.
+// next_round fills its argument with the groups of examples of the next round and returns false once there are none.
+// The replicas are created once. After each round the sparse deltas of their weights are merged as VW::merge_deltas
+// would and the changed weights are copied back into every replica, so a round costs the weights which changed rather
+// than a copy of the whole model per replica. The rest of the state of each replica, such as its statistics, only
+// covers what it learned itself. It is combined with VW's model delta operators at the end, so any reduction VW can
+// merge is supported. The caller must hold the workspace lock.
+template <typename NextRoundT>
+std::unique_ptr<VW::workspace> train_replicas(
+    const workspace_with_logger_contexts& workspace, size_t num_replicas, NextRoundT&& next_round)
 {
-  py_setup_example(*workspace.workspace_ptr, example);
-  auto on_exit = VW::scope_exit([&]() { py_unsetup_example(*workspace.workspace_ptr, example); });
-
-  auto* learner = VW::LEARNER::require_singleline(workspace.workspace_ptr->l.get());
-  std::vector<std::shared_ptr<vwpy::debug_node>> debug_info;
-  if (workspace.workspace_ptr->l->learn_returns_prediction)
-  {
-    // Learner is used directly as VW makes decisions about training and
-    // learn returns prediction in the workspace API and ends up calling
-    // potentially the wrong thing.
-    learner->learn(example);
-    if (workspace.debug) { debug_info.push_back(get_and_clear_debug_info(workspace)); }
-  }
-  else
+  const auto& original = *workspace.workspace_ptr;
+  const bool multiline = original.l->is_multiline();
+  // Adding an empty delta to a workspace is how VW copies one.
+  const auto empty_delta = original - original;
+  // Holds the merged weights, the rest of its state is unused.
+  std::unique_ptr<VW::workspace> merged;
+  std::vector<std::unique_ptr<VW::workspace>> replicas;
+  std::vector<VW::multi_ex> round;
+  while (next_round(round))
   {
-    // Learner is used directly as VW makes decisions about training and
-    // learn returns prediction in the workspace API and ends up calling
-    // potentially the wrong thing.
-    // We must save and restore test_only because the library sets this values and does not undo it.
-    bool test_only = example.test_only;
-    learner->predict(example);
-    example.test_only = test_only;
-    if (workspace.debug) { debug_info.push_back(get_and_clear_debug_info(workspace)); }
+    if (merged == nullptr) { merged = original + empty_delta; }
+    const size_t num_active = std::min(num_replicas, round.size());
+    while (replicas.size() < num_active)
+    {
+      replicas.push_back(original + empty_delta);
+      copy_dense_weights(*merged, *replicas.back());
+    }
+    std::vector<double> start_examples(num_active);
+    for (size_t k = 0; k < num_active; k++) { start_examples[k] = replicas[k]->sd->weighted_labeled_examples; }
 
-    learner->learn(example);
-    if (workspace.debug) { debug_info.push_back(get_and_clear_debug_info(workspace)); }
-  }
+    std::vector<std::exception_ptr> errors(num_active);
+    const auto train_replica = [&](size_t k)
+    {
+      try
+      {
+        auto& ws = *replicas[k];
+        std::vector<bool> test_onlys;
+        for (size_t i = k; i < round.size(); i += num_active)
+        {
+          auto& group = round[i];
+          if (multiline)
+          {
+            const auto prepared = py_setup_example(workspace, group);
+            auto on_exit = VW::scope_exit([&]() { py_unsetup_example(workspace, group, prepared); });
+            learn_prepared(
+                ws, *VW::LEARNER::require_multiline(ws.l.get()), group, test_onlys, workspace.counters.get());
+          }
+          else
+          {
+            auto& ex = *group[0];
+            const auto prepared = py_setup_example(workspace, ex);
+            auto on_exit = VW::scope_exit([&]() { py_unsetup_example(workspace, ex, prepared); });
+            learn_prepared(ws, *VW::LEARNER::require_singleline(ws.l.get()), ex, test_onlys, workspace.counters.get());
+          }
+        }
+      }
+      catch (...)
+      {
+        errors[k] = std::current_exception();
+      }
+    };
+    {
+      std::vector<std::thread> threads;
+      threads.reserve(num_active - 1);
+      auto join_threads = VW::scope_exit(
+          [&]()
+          {
+            for (auto& thread : threads) { thread.join(); }
+          });
+      for (size_t k = 1; k < num_active; k++) { threads.emplace_back(train_replica, k); }
+      train_replica(0);
+    }
+    for (const auto& error : errors)
+    {
+      if (error != nullptr) { std::rethrow_exception(error); }
+    }
 
-  // TODO - when updating VW submodule if learn calls update stats then remove this to avoid a double call.
-  update_stats_recursive(*workspace.workspace_ptr, *learner, example);
-  auto prediction = vwpy::to_prediction(example.pred, workspace.workspace_ptr->l->get_output_prediction_type());
-  if (workspace.debug) { return std::make_tuple(prediction, debug_info); }
-  return prediction;
+    std::vector<vwpy::sparse_delta> deltas;
+    deltas.reserve(num_active);
+    for (size_t k = 0; k < num_active; k++)
+    {
+      deltas.push_back(vwpy::calculate_sparse_delta(*merged, *replicas[k], 0));
+      // The statistics of merged are never updated, each replica's examples are those since the round started.
+      deltas.back().weighted_examples = replicas[k]->sd->weighted_labeled_examples - start_examples[k];
+    }
+    std::vector<const vwpy::sparse_delta*> delta_ptrs;
+    for (const auto& delta : deltas) { delta_ptrs.push_back(&delta); }
+    const auto merged_delta = vwpy::merge_sparse_deltas(delta_ptrs, 0);
+    vwpy::apply_sparse_delta(*merged, merged_delta);
+    // Each replica only differs from merged at the indices of its own delta, which the merged delta includes.
+    for (auto& replica : replicas) { vwpy::copy_delta_weights(*merged, *replica, merged_delta); }
+  }
+  if (merged == nullptr) { return original + empty_delta; }
+
+  std::vector<VW::model_delta> deltas;
+  deltas.reserve(replicas.size());
+  for (const auto& replica : replicas) { deltas.push_back(*replica - original); }
+  std::vector<const VW::model_delta*> delta_ptrs;
+  for (const auto& delta : deltas) { delta_ptrs.push_back(&delta); }
+  auto result = original + VW::merge_deltas(delta_ptrs);
+  // VW's merge combines the rest of the state, but the weights were already merged round by round.
+  copy_dense_weights(*merged, *result);
+  return result;
 }
 
-std::variant<vwpy::prediction_t, std::tuple<vwpy::prediction_t, std::vector<std::shared_ptr<vwpy::debug_node>>>>
-predict_then_learn(workspace_with_logger_contexts& workspace, std::vector<VW::example*>& example)
+// Multiline examples are given as groups, other examples as groups of one.
+std::unique_ptr<workspace_with_logger_contexts> train_data_parallel(const workspace_with_logger_contexts& workspace,
+    std::vector<VW::multi_ex>& groups, size_t num_replicas, size_t sync_interval)
 {
-  py_setup_example(*workspace.workspace_ptr, example);
-  auto on_exit = VW::scope_exit([&]() { py_unsetup_example(*workspace.workspace_ptr, example); });
-  auto* learner = VW::LEARNER::require_multiline(workspace.workspace_ptr->l.get());
-  std::vector<std::shared_ptr<vwpy::debug_node>> debug_info;
-  if (workspace.workspace_ptr->l->learn_returns_prediction)
-  {
-    // Learner is used directly as VW makes decisions about training and
-    // learn returns prediction in the workspace API and ends up calling
-    // potentially the wrong thing.
-    learner->learn(example);
-    if (workspace.debug) { debug_info.push_back(get_and_clear_debug_info(workspace)); }
-  }
-  else
+  check_data_parallel_supported(workspace, num_replicas, sync_interval);
+  std::vector<VW::example*> examples;
+  for (auto& group : groups)
   {
-    // Learner is used directly as VW makes decisions about training and
-    // learn returns prediction in the workspace API and ends up calling
-    // potentially the wrong thing.
-    // We must save and restore test_only because the library sets this values and does not undo it.
-    std::vector<bool> test_onlys;
-    test_onlys.reserve(example.size());
-    for (auto ex : example) { test_onlys.push_back(ex->test_only); }
-    learner->predict(example);
-    for (size_t i = 0; i < example.size(); i++) { example[i]->test_only = test_onlys[i]; }
-    if (workspace.debug) { debug_info.push_back(get_and_clear_debug_info(workspace)); }
-    learner->learn(example);
-    if (workspace.debug) { debug_info.push_back(get_and_clear_debug_info(workspace)); }
+    auto& checked = deref_example(group);
+    examples.insert(examples.end(), checked.begin(), checked.end());
   }
+  check_distinct_examples(std::move(examples), "train_data_parallel");
 
-  // TODO - when updating VW submodule if learn calls update stats then remove this to avoid a double call.
-  update_stats_recursive(*workspace.workspace_ptr, *learner, example);
-  auto prediction = vwpy::to_prediction(example[0]->pred, workspace.workspace_ptr->l->get_output_prediction_type());
-  if (workspace.debug) { return std::make_tuple(prediction, debug_info); }
-  return prediction;
+  auto trained = run_without_gil(workspace,
+      [&]()
+      {
+        size_t next = 0;
+        return train_replicas(workspace, num_replicas,
+            [&](std::vector<VW::multi_ex>& round)
+            {
+              const size_t end = std::min(next + sync_interval, groups.size());
+              round.assign(groups.begin() + next, groups.begin() + end);
+              next = end;
+              return !round.empty();
+            });
+      });
+  return make_derived_workspace(workspace, std::move(trained));
+}
+
+// As train_data_parallel, parsing each round of examples from a file on the calling thread.
+std::unique_ptr<workspace_with_logger_contexts> train_data_parallel_from_file(
+    const workspace_with_logger_contexts& workspace, const std::string& path, input_format format, size_t num_replicas,
+    size_t sync_interval)
+{
+  check_data_parallel_supported(workspace, num_replicas, sync_interval);
+  auto trained = run_without_gil(workspace,
+      [&]()
+      {
+        std::vector<std::unique_ptr<VW::example>> owned_examples;
+        std::vector<VW::example*> spare_examples;
+        const auto allocator = reusing_allocator(owned_examples, spare_examples);
+        example_file_parser parser(*workspace.workspace_ptr, open_input(path), format, allocator);
+        return train_replicas(workspace, num_replicas,
+            [&](std::vector<VW::multi_ex>& round)
+            {
+              for (auto& group : round) { release_examples(allocator, group); }
+              round.clear();
+              VW::multi_ex group;
+              while (round.size() < sync_interval && parser.next(group))
+              {
+                round.push_back(std::move(group));
+                group.clear();
+              }
+              return !round.empty();
+            });
+      });
+  return make_derived_workspace(workspace, std::move(trained));
 }
 
 size_t count_non_zero_weights(const VW::parameters& weights)
@@ -818,6 +2961,15 @@ size_t count_non_zero_weights(const VW::parameters& weights)
   }
 }
 
+// Prepared examples hold feature indices already scaled for a workspace, so new features would be inconsistent.
+void check_features_mutable(const VW::example& ex)
+{
+  if (ex.interactions != nullptr)
+  {
+    throw std::invalid_argument("Features of a prepared example cannot be modified. Call Workspace.unprepare first.");
+  }
+}
+
 struct feat_group_ref
 {
   VW::example* _example;
@@ -871,24 +3023,46 @@ PYBIND11_MODULE(_core, m)
   py::options options;
   options.disable_enum_members_docstring();
 
+  PYBIND11_NUMPY_DTYPE(VW::action_score, action, score);
+  PYBIND11_NUMPY_DTYPE(VW::continuous_actions::pdf_segment, left, right, pdf_value);
+
   py::class_<dense_weight_holder>(m, "DenseParameters", py::buffer_protocol())
       .def_buffer(
           [](dense_weight_holder& m) -> py::buffer_info
           {
-            auto length = (m.weights->mask() + 1) >> m.weights->stride_shift();
-            return py::buffer_info(m.weights->first(),  /* Pointer to buffer */
+            auto length = (m.weights.mask() + 1) >> m.weights.stride_shift();
+            return py::buffer_info(m.weights.first(),   /* Pointer to buffer */
                 sizeof(float),                          /* Size of one scalar */
                 py::format_descriptor<float>::format(), /* Python struct-style format descriptor */
                 3,                                      /* Number of dimensions */
                 {static_cast<ssize_t>(length), static_cast<ssize_t>(m.total_feature_width),
-                    static_cast<ssize_t>(m.weights->stride())}, /* Buffer dimensions */
+                    static_cast<ssize_t>(m.weights.stride())}, /* Buffer dimensions */
                 {sizeof(float) * static_cast<ssize_t>(m.total_feature_width) *
-                        static_cast<ssize_t>(m.weights->stride()),
-                    sizeof(float) * static_cast<ssize_t>(m.weights->stride()), sizeof(float)}
+                        static_cast<ssize_t>(m.weights.stride()),
+                    sizeof(float) * static_cast<ssize_t>(m.weights.stride()), sizeof(float)}
                 /* Strides (in bytes) for each index */
             );
           });
 
+  py::enum_<vwpy::weight_precision>(m, "_WeightPrecision")
+      .value("Float32", vwpy::weight_precision::FLOAT32)
+      .value("Float16", vwpy::weight_precision::FLOAT16)
+      .value("Int8", vwpy::weight_precision::INT8);
+
+  py::class_<vwpy::workspace_snapshot>(m, "_WorkspaceSnapshot")
+      .def("write_to_file", &::write_snapshot_to_file, py::arg("path"))
+      .def_property_readonly("weights_bytes", &vwpy::workspace_snapshot::weights_bytes);
+
+  py::class_<vwpy::checkpoint_file>(m, "_CheckpointFile")
+      .def(py::init([](const std::string& path) { return vwpy::checkpoint_file::open(path); }), py::arg("path"))
+      .def_property_readonly("model_data",
+          [](const vwpy::checkpoint_file& file) { return py::bytes(file.model_data, file.model_size); });
+
+  py::class_<vwpy::frozen_model_file>(m, "_FrozenModelFile")
+      .def(py::init([](const std::string& path) { return vwpy::frozen_model_file::open(path); }), py::arg("path"))
+      .def_property_readonly("model_data",
+          [](const vwpy::frozen_model_file& file) { return py::bytes(file.model_data, file.model_size); });
+
   py::enum_<VW::label_type_t>(m, "LabelType")
       .value("Simple", VW::label_type_t::SIMPLE)
       .value("CB", VW::label_type_t::CB)
@@ -1311,30 +3485,52 @@ PYBIND11_MODULE(_core, m)
   py::class_<vwpy::debug_node, std::shared_ptr<vwpy::debug_node>>(m, "DebugNode", R"docstring(
     A node in the computation tree of a single learn/predict call. This represents the state of the example as it is entering a given reduction.
 
+    The example fields which were not selected by the `debug_tree_fields` argument of the workspace are None.
+
     .. warning::
       This is a highly experimental feature.
 
 )docstring")
       .def_property_readonly(
           "children",
-          [](const vwpy::debug_node& d) -> std::vector<std::shared_ptr<vwpy::debug_node>> { return d.children; },
+          [](const std::shared_ptr<vwpy::debug_node>& d) -> std::vector<std::shared_ptr<vwpy::debug_node>>
+          {
+            // The children share ownership of the arena which holds the tree.
+            std::vector<std::shared_ptr<vwpy::debug_node>> children;
+            children.reserve(d->children.size());
+            for (auto* child : d->children) { children.emplace_back(d, child); }
+            return children;
+          },
           "The child computations that this node processed. This represents traversal of the stack.")
       .def_property_readonly(
           "name", [](const vwpy::debug_node& d) -> std::string { return d.name; },
           "Name of the reduction being called.")
       .def_property_readonly(
-          "output_prediction", [](const vwpy::debug_node& d) -> vwpy::prediction_t { return d.output_prediction; },
+          "output_prediction",
+          [](const vwpy::debug_node& d) -> std::optional<vwpy::prediction_t>
+          { return get_debug_field(d, vwpy::DEBUG_FIELD_OUTPUT_PREDICTION, d.output_prediction); },
           "The prediction that this reduction produced.")
       .def_property_readonly(
           "input_labels",
-          [](const vwpy::debug_node& d) -> std::variant<vwpy::label_variant_t, std::vector<vwpy::label_variant_t>>
-          { return d.input_labels; },
+          [](const vwpy::debug_node& d)
+              -> std::optional<std::variant<vwpy::label_variant_t, std::vector<vwpy::label_variant_t>>>
+          { return get_debug_field(d, vwpy::DEBUG_FIELD_INPUT_LABELS, d.input_labels); },
           "The label that was passed into this reduction. Or, list of labels if this reduction is a multi-example "
           "reduction.")
       .def_property_readonly(
           "interactions",
-          [](const vwpy::debug_node& d) -> std::variant<std::vector<std::string>, std::vector<std::vector<std::string>>>
-          { return d.interactions; },
+          [](const vwpy::debug_node& d)
+              -> std::optional<std::variant<std::vector<std::string>, std::vector<std::vector<std::string>>>>
+          {
+            if (!(d.fields & vwpy::DEBUG_FIELD_INTERACTIONS)) { return std::nullopt; }
+            if (!d.is_multiline) { return *std::get<vwpy::interaction_names>(d.interactions); }
+            std::vector<std::vector<std::string>> interactions;
+            for (const auto& names : std::get<std::vector<vwpy::interaction_names>>(d.interactions))
+            {
+              interactions.push_back(*names);
+            }
+            return interactions;
+          },
           "The interactions that were used to generate the features for this reduction. Or, list of interactions if "
           "this reduction is a multi-example reduction.")
       .def_property_readonly(
@@ -1348,20 +3544,25 @@ PYBIND11_MODULE(_core, m)
           "The number of examples that were processed by this reduction. This is always 1 for single example "
           "reductions.")
       .def_property_readonly(
-          "weight", [](const vwpy::debug_node& d) -> std::variant<float, std::vector<float>> { return d.weight; },
+          "weight", [](const vwpy::debug_node& d) -> std::optional<std::variant<float, std::vector<float>>>
+          { return get_debug_field(d, vwpy::DEBUG_FIELD_WEIGHT, d.weight); },
           "The weight of the example. Or, list of weights if this reduction is a multi-example reduction.")
       .def_property_readonly(
           "updated_prediction",
-          [](const vwpy::debug_node& d) -> std::variant<float, std::vector<float>> { return d.updated_prediction; },
+          [](const vwpy::debug_node& d) -> std::optional<std::variant<float, std::vector<float>>>
+          { return get_debug_field(d, vwpy::DEBUG_FIELD_UPDATED_PREDICTION, d.updated_prediction); },
           "The partial prediction on the example after this reduction ran. Or, list of partial predictions if this "
           "reduction is a multi-example reduction. This is generally only set by the bottom of the stack.")
       .def_property_readonly(
           "partial_prediction",
-          [](const vwpy::debug_node& d) -> std::variant<float, std::vector<float>> { return d.partial_prediction; },
+          [](const vwpy::debug_node& d) -> std::optional<std::variant<float, std::vector<float>>>
+          { return get_debug_field(d, vwpy::DEBUG_FIELD_PARTIAL_PREDICTION, d.partial_prediction); },
           "The partial prediction on the example after this reduction ran. Or, list of partial predictions if this "
           "reduction is a multi-example reduction. This is generally only set by the bottom of the stack.")
       .def_property_readonly(
-          "offset", [](const vwpy::debug_node& d) -> std::variant<uint64_t, std::vector<uint64_t>> { return d.offset; },
+          "offset",
+          [](const vwpy::debug_node& d) -> std::optional<std::variant<uint64_t, std::vector<uint64_t>>>
+          { return get_debug_field(d, vwpy::DEBUG_FIELD_OFFSET, d.offset); },
           "The offset of the example. Or, list of offsets if this reduction is a multi-example reduction. This also "
           "includes the stride of the bottom learner.")
       .def_property_readonly(
@@ -1400,6 +3601,7 @@ PYBIND11_MODULE(_core, m)
           "push_feature",
           [](feat_group_ref& fg_ref, uint64_t index, float value) -> void
           {
+            check_features_mutable(*fg_ref._example);
             fg_ref._example->reset_total_sum_feat_sq();
             fg_ref._features->push_back(value, index);
           },
@@ -1414,15 +3616,13 @@ PYBIND11_MODULE(_core, m)
             {
               throw std::invalid_argument("indices and values must be the same size");
             }
+            check_features_mutable(*fg_ref._example);
             fg_ref._example->reset_total_sum_feat_sq();
             fg_ref._features->values.reserve(fg_ref._features->values.size() + values.size());
             fg_ref._features->indices.reserve(fg_ref._features->indices.size() + indices.size());
             fg_ref._features->values.insert(fg_ref._features->values.end(), values.data(), values.data() + values.size());
             fg_ref._features->indices.insert(fg_ref._features->indices.end(), indices.data(), indices.data() + indices.size());
-            for(size_t i = 0; i < indices.size(); i++)
-            {
-              fg_ref._features->sum_feat_sq += values.data()[i] * values.data()[i];
-            }
+            fg_ref._features->sum_feat_sq += vwpy::sum_of_squares(values.data(), values.size());
           },
           py::arg("indices"), py::arg("values"),
           "Push many features into this group. This is an advanced function. Specifically, to ensure consistency with "
@@ -1435,6 +3635,7 @@ PYBIND11_MODULE(_core, m)
             {
               throw std::invalid_argument("i must be less than the size of the feature group");
             }
+            check_features_mutable(*fg_ref._example);
             fg_ref._example->reset_total_sum_feat_sq();
             fg_ref._features->truncate_to(i);
           }, py::arg("i"),
@@ -1446,7 +3647,7 @@ PYBIND11_MODULE(_core, m)
           []()
           {
             // shared ptr which returns to the pool upon deletion
-            return get_example_from_pool();
+            return DEFAULT_EXAMPLE_POOL->acquire_shared();
           }))
       .def("_is_newline", [](VW::example& ex) -> bool { return ex.is_newline; })
       .def("_get_label",
@@ -1476,6 +3677,7 @@ PYBIND11_MODULE(_core, m)
       .def("__delitem__",
           [](VW::example* ex, VW::namespace_index ns)
           {
+            check_features_mutable(*ex);
             auto found = std::find(ex->indices.begin(), ex->indices.end(), ns);
             if (found == ex->indices.end()) { throw py::key_error("Namespace not found"); }
 
@@ -1500,23 +3702,49 @@ PYBIND11_MODULE(_core, m)
   py::class_<workspace_with_logger_contexts>(m, "Workspace")
       .def(py::init(
                [](const std::vector<std::string>& args, const std::optional<py::bytes>& bytes,
-                   bool record_feature_names, bool record_metrics, bool debug)
+                   const std::optional<std::string>& model_path, const std::optional<py::object>& model_file,
+                   bool record_feature_names, bool record_metrics, bool record_counters, bool debug, bool profile,
+                   std::optional<uint64_t> debug_sample_every, std::optional<float> debug_sample_probability,
+                   size_t debug_sample_buffer_size, const std::optional<std::vector<std::string>>& debug_tree_fields)
                {
-                 auto opts = std::make_unique<VW::config::options_cli>(args);
-                 if (record_metrics)
+                 if (int(bytes.has_value()) + int(model_path.has_value()) + int(model_file.has_value()) > 1)
                  {
-                   // VW enables metrics by passing a file to write the metrics to.
-                   opts->insert("extra_metrics", "THIS_FILE_SHOULD_NOT_EXIST1");
+                   throw std::invalid_argument("Only one of model_data, model_path and model_file can be given.");
                  }
 
-                 if (record_feature_names)
+                 std::optional<vwpy::debug_sampling> debug_sampling;
+                 if (debug_sample_every.has_value() || debug_sample_probability.has_value())
                  {
-                   // We need to ensure hash_inv is enabled during initialize for things to work correctly.
-                   // The only way to do that is via an option. We're using this one
-                   opts->insert("dump_json_weights_experimental", "THIS_FILE_SHOULD_NOT_EXIST2");
-                   opts->insert("dump_json_weights_include_feature_names_experimental", "");
+                   if (debug_sample_every.has_value() == debug_sample_probability.has_value())
+                   {
+                     throw std::invalid_argument(
+                         "Only one of debug_sample_every and debug_sample_probability can be given.");
+                   }
+                   if (debug_sample_every.has_value() && *debug_sample_every == 0)
+                   {
+                     throw std::invalid_argument("debug_sample_every must be at least 1.");
+                   }
+                   if (debug_sample_probability.has_value() &&
+                       !(*debug_sample_probability > 0.f && *debug_sample_probability <= 1.f))
+                   {
+                     throw std::invalid_argument("debug_sample_probability must be in (0, 1].");
+                   }
+                   if (debug_sample_buffer_size == 0)
+                   {
+                     throw std::invalid_argument("debug_sample_buffer_size must be at least 1.");
+                   }
+                   debug_sampling = vwpy::debug_sampling{debug_sample_every.value_or(0),
+                       debug_sample_probability.value_or(0.f), debug_sample_buffer_size};
                  }
 
+                 if (debug_tree_fields.has_value() && !debug && !debug_sampling.has_value())
+                 {
+                   throw std::invalid_argument(
+                       "debug_tree_fields can only be given when the debug tree or debug tree sampling is enabled.");
+                 }
+                 const uint32_t debug_fields =
+                     debug_tree_fields.has_value() ? to_debug_fields(*debug_tree_fields) : vwpy::DEBUG_FIELD_ALL;
+
                  std::unique_ptr<VW::io::reader> model_reader = nullptr;
                  std::string_view bytes_view;
                  if (bytes.has_value())
@@ -1524,66 +3752,36 @@ PYBIND11_MODULE(_core, m)
                    bytes_view = *bytes;
                    model_reader = VW::io::create_buffer_view(bytes_view.data(), bytes_view.size());
                  }
-
-                 auto wrapped_object = std::make_unique<workspace_with_logger_contexts>();
-                 wrapped_object->logger_context_ptr = std::make_unique<logger_context>();
-                 py::object get_logger = py::module::import("logging").attr("getLogger");
-                 wrapped_object->logger_context_ptr->driver_logger = get_logger("vowpal_wabbit_next.driver");
-                 wrapped_object->logger_context_ptr->log_logger = get_logger("vowpal_wabbit_next.log");
-                 auto logger = VW::io::create_custom_sink_logger(wrapped_object->logger_context_ptr.get(), log_log);
-
-                 std::unique_ptr<vwpy::debug_stack_builder> stack = nullptr;
-                 if (debug)
-                 {
-                   wrapped_object->debug = true;
-                   stack = std::make_unique<vwpy::debug_stack_builder>();
-                 }
-                 wrapped_object->workspace_ptr = std::shared_ptr<VW::workspace>(
-                     VW::initialize_experimental(std::move(opts), std::move(model_reader), driver_log,
-                         wrapped_object->logger_context_ptr.get(), &logger, std::move(stack)));
-                 // This should cause parsing failures to be thrown instead of just logged.
-                 wrapped_object->workspace_ptr->parser_runtime.example_parser->strict_parse = true;
-
-                 // Check for unsupported features.
-                 // The main reason for this is we want to remove the concept of "setup_example" in the python bindings
-                 // This is achieved by performing necessary steps in the learn/predict call and undoing them on the way
-                 // out.
-                 if (wrapped_object->workspace_ptr->parser_runtime.example_parser->sort_features)
-                 {
-                   THROW("The command line option 'sort_features' is not supported in py-vowpal-wabbit-next.");
-                 }
-
-                 if (wrapped_object->workspace_ptr->feature_tweaks_config.ignore_some)
-                 {
-                   THROW("The command line option 'ignore' is not supported in py-vowpal-wabbit-next.");
-                 }
-
-                 if (wrapped_object->workspace_ptr->feature_tweaks_config.skip_gram_transformer != nullptr)
-                 {
-                   THROW("The command line option 'ngram' is not supported in py-vowpal-wabbit-next.");
-                 }
-
-                 if (!wrapped_object->workspace_ptr->feature_tweaks_config.limit_strings.empty())
+                 // The model is deserialized as it is read, through the fixed size buffer of VW's io_buf, so the
+                 // whole file is never held in memory at once.
+                 else if (model_path.has_value())
                  {
-                   THROW("The command line option 'feature_limit' is not supported in py-vowpal-wabbit-next.");
+                   model_reader = VW::make_unique<gil_releasing_reader>(open_file_input(*model_path));
                  }
+                 else if (model_file.has_value()) { model_reader = VW::make_unique<python_reader>(*model_file); }
 
-                 return wrapped_object;
+                 return create_workspace(args, std::move(model_reader), record_feature_names, record_metrics,
+                     record_counters, debug, profile, debug_sampling, debug_fields);
                }),
-          py::arg("args"), py::kw_only(), py::arg("model_data") = std::nullopt, py::arg("record_feature_names") = false,
-          py::arg("record_metrics") = false, py::arg("debug") = false)
+          py::arg("args"), py::kw_only(), py::arg("model_data") = std::nullopt, py::arg("model_path") = std::nullopt,
+          py::arg("model_file") = std::nullopt, py::arg("record_feature_names") = false,
+          py::arg("record_metrics") = false, py::arg("record_counters") = false, py::arg("debug") = false,
+          py::arg("profile") = false, py::arg("debug_sample_every") = std::nullopt,
+          py::arg("debug_sample_probability") = std::nullopt, py::arg("debug_sample_buffer_size") = 100,
+          py::arg("debug_tree_fields") = std::nullopt)
       .def(
           "learn_one",
           [](workspace_with_logger_contexts& workspace,
               VW::example& example) -> std::variant<std::monostate, std::vector<std::shared_ptr<vwpy::debug_node>>>
           {
-            // If debug then we need to get out the debug info otherwise we can ignore the result.
-            if (workspace.debug) { return std::get<1>(std::get<1>(predict_then_learn(workspace, example))); }
-            else
-            {
-              predict_then_learn(workspace, example);
-              return std::monostate{};
-            }
+            return run_without_gil(workspace,
+                [&]() -> std::variant<std::monostate, std::vector<std::shared_ptr<vwpy::debug_node>>>
+                {
+                  // If debug then we need to get out the debug info otherwise we can ignore the result.
+                  if (workspace.debug) { return std::get<1>(std::get<1>(predict_then_learn(workspace, example))); }
+                  predict_then_learn(workspace, example);
+                  return std::monostate{};
+                });
           },
           py::arg("examples"), py::kw_only())
       .def(
@@ -1592,13 +3790,14 @@ PYBIND11_MODULE(_core, m)
               -> std::variant<std::monostate, std::vector<std::shared_ptr<vwpy::debug_node>>>
           {
             assert(!example.empty());
-            // If debug then we need to get out the debug info otherwise we can ignore the result.
-            if (workspace.debug) { return std::get<1>(std::get<1>(predict_then_learn(workspace, example))); }
-            else
-            {
-              predict_then_learn(workspace, example);
-              return std::monostate{};
-            }
+            return run_without_gil(workspace,
+                [&]() -> std::variant<std::monostate, std::vector<std::shared_ptr<vwpy::debug_node>>>
+                {
+                  // If debug then we need to get out the debug info otherwise we can ignore the result.
+                  if (workspace.debug) { return std::get<1>(std::get<1>(predict_then_learn(workspace, example))); }
+                  predict_then_learn(workspace, example);
+                  return std::monostate{};
+                });
           },
           py::arg("examples"), py::kw_only())
       .def(
@@ -1606,28 +3805,12 @@ PYBIND11_MODULE(_core, m)
           [](workspace_with_logger_contexts& workspace, VW::example& example)
               -> std::variant<vwpy::prediction_t, std::tuple<vwpy::prediction_t, std::shared_ptr<vwpy::debug_node>>>
           {
-            py_setup_example(*workspace.workspace_ptr, example);
-            auto on_exit = VW::scope_exit([&]() { py_unsetup_example(*workspace.workspace_ptr, example); });
-            // We must save and restore test_only because the library sets this values and does not undo it.
-            bool test_only = example.test_only;
-
-            // Learner is used directly as VW makes decisions about training and
-            // learn returns prediction in the workspace API and ends up calling
-            // potentially the wrong thing.
-            auto* learner = VW::LEARNER::require_singleline(workspace.workspace_ptr->l.get());
-            learner->predict(example);
-
-            // TODO - when updating VW submodule if learn calls update stats then remove this to avoid a double call.
-            update_stats_recursive(*workspace.workspace_ptr, *learner, example);
-            example.test_only = test_only;
-            auto prediction =
-                vwpy::to_prediction(example.pred, workspace.workspace_ptr->l->get_output_prediction_type());
-            if (workspace.debug)
+            if (const auto* frozen = get_frozen_model(workspace))
             {
-              auto debug_info = get_and_clear_debug_info(workspace);
-              return std::make_tuple(prediction, debug_info);
+              py::gil_scoped_release release;
+              return vwpy::prediction_t{predict_frozen(*frozen, example, workspace.counters.get())};
             }
-            return prediction;
+            return run_without_gil(workspace, [&]() { return predict(workspace, example); });
           },
           py::arg("examples"), py::kw_only())
       .def(
@@ -1636,52 +3819,86 @@ PYBIND11_MODULE(_core, m)
               -> std::variant<vwpy::prediction_t, std::tuple<vwpy::prediction_t, std::shared_ptr<vwpy::debug_node>>>
           {
             assert(!example.empty());
-            py_setup_example(*workspace.workspace_ptr, example);
-            auto on_exit = VW::scope_exit([&]() { py_unsetup_example(*workspace.workspace_ptr, example); });
-            // We must save and restore test_only because the library sets this values and does not undo it.
-            std::vector<bool> test_onlys;
-            test_onlys.reserve(example.size());
-            for (auto ex : example) { test_onlys.push_back(ex->test_only); }
-
-            // Learner is used directly as VW makes decisions about training and
-            // learn returns prediction in the workspace API and ends up calling
-            // potentially the wrong thing.
-            auto* learner = VW::LEARNER::require_multiline(workspace.workspace_ptr->l.get());
-            learner->predict(example);
-
-            // TODO - when updating VW submodule if learn calls update stats then remove this to avoid a double call.
-            update_stats_recursive(*workspace.workspace_ptr, *learner, example);
-            for (size_t i = 0; i < example.size(); i++) { example[i]->test_only = test_onlys[i]; }
-
-            auto prediction =
-                vwpy::to_prediction(example[0]->pred, workspace.workspace_ptr->l->get_output_prediction_type());
-            if (workspace.debug)
-            {
-              auto debug_info = get_and_clear_debug_info(workspace);
-              return std::make_tuple(prediction, debug_info);
-            }
-            return prediction;
+            return run_without_gil(workspace, [&]() { return predict(workspace, example); });
           },
           py::arg("examples"), py::kw_only())
+      .def(
+          "predict_one_numpy",
+          [](workspace_with_logger_contexts& workspace, VW::example& example, std::optional<py::array> out)
+              -> py::object { return predict_numpy(workspace, example, out); },
+          py::arg("example"), py::kw_only(), py::arg("out") = std::nullopt)
+      .def(
+          "predict_multi_ex_one_numpy",
+          [](workspace_with_logger_contexts& workspace, std::vector<VW::example*>& example,
+              std::optional<py::array> out) -> py::object
+          {
+            if (example.empty()) { throw std::invalid_argument("Multiline example must not be empty."); }
+            return predict_numpy(workspace, example, out);
+          },
+          py::arg("example"), py::kw_only(), py::arg("out") = std::nullopt)
       .def(
           "predict_then_learn_one",
           [](workspace_with_logger_contexts& workspace,
               VW::example& example) -> std::variant<vwpy::prediction_t,
                                         std::tuple<vwpy::prediction_t, std::vector<std::shared_ptr<vwpy::debug_node>>>>
-          { return predict_then_learn(workspace, example); },
+          { return run_without_gil(workspace, [&]() { return predict_then_learn(workspace, example); }); },
           py::arg("examples"), py::kw_only())
       .def(
           "predict_then_learn_multi_ex_one",
           [](workspace_with_logger_contexts& workspace, std::vector<VW::example*>& example)
               -> std::variant<vwpy::prediction_t,
                   std::tuple<vwpy::prediction_t, std::vector<std::shared_ptr<vwpy::debug_node>>>>
-          { return predict_then_learn(workspace, example); },
+          { return run_without_gil(workspace, [&]() { return predict_then_learn(workspace, example); }); },
           py::arg("examples"), py::kw_only())
+      .def(
+          "learn_batch",
+          [](workspace_with_logger_contexts& workspace, std::vector<VW::example*>& examples)
+          { learn_batch(workspace, examples); },
+          py::arg("examples"))
+      .def(
+          "learn_multi_ex_batch",
+          [](workspace_with_logger_contexts& workspace, std::vector<VW::multi_ex>& examples)
+          { learn_batch(workspace, examples); },
+          py::arg("examples"))
+      .def(
+          "predict_batch",
+          [](workspace_with_logger_contexts& workspace, std::vector<VW::example*>& examples) -> py::object
+          { return predict_batch(workspace, examples); },
+          py::arg("examples"))
+      .def(
+          "predict_multi_ex_batch",
+          [](workspace_with_logger_contexts& workspace, std::vector<VW::multi_ex>& examples) -> py::object
+          { return predict_batch(workspace, examples); },
+          py::arg("examples"))
+      .def("prepare", &::prepare_examples, py::arg("examples"))
+      .def("unprepare", &::unprepare_examples, py::arg("examples"))
+      .def("train_from_file", &::train_from_file, py::arg("path"), py::kw_only(), py::arg("format"),
+          py::arg("passes"), py::arg("queue_size"))
+      .def("learn_parallel", &::learn_parallel, py::arg("examples"), py::kw_only(), py::arg("threads"))
+      .def("learn_parallel_from_file", &::learn_parallel_from_file, py::arg("path"), py::kw_only(), py::arg("format"),
+          py::arg("threads"))
+      .def("freeze", &::freeze, py::arg("precision"))
+      .def("attach_frozen", &::attach_frozen, py::arg("file"))
+      .def("save_frozen", &::save_frozen, py::arg("path"))
+      .def("get_is_frozen",
+          [](const workspace_with_logger_contexts& workspace) { return get_frozen_model(workspace) != nullptr; })
+      .def("get_frozen_weights_bytes",
+          [](const workspace_with_logger_contexts& workspace) -> std::optional<size_t>
+          {
+            const auto* frozen = get_frozen_model(workspace);
+            if (frozen == nullptr) { return std::nullopt; }
+            return frozen->weights_bytes();
+          })
       .def("end_pass",
           [](workspace_with_logger_contexts& workspace)
           {
-            workspace.workspace_ptr->passes_config.current_pass++;
-            workspace.workspace_ptr->l->end_pass();
+            run_without_gil(workspace,
+                [&]()
+                {
+                  own_weights(workspace);
+                  workspace.workspace_ptr->passes_config.current_pass++;
+                  workspace.workspace_ptr->l->end_pass();
+                });
           })
       .def("get_is_multiline",
           [](const workspace_with_logger_contexts& workspace) { return workspace.workspace_ptr->l->is_multiline(); })
@@ -1693,11 +3910,98 @@ PYBIND11_MODULE(_core, m)
               throw std::runtime_error(
                   "Metrics are not enabled. Pass records_metrics=True to Workspace constructor to enable.");
             }
-            py::dict metrics;
-            auto collected_metrics = workspace.workspace_ptr->output_runtime.global_metrics.collect_metrics(
-                workspace.workspace_ptr->l.get());
+            VW::metric_sink collected_metrics;
+            {
+              // Not run_without_gil, since that rejects frozen workspaces which still have the metrics they recorded.
+              py::gil_scoped_release release;
+              std::lock_guard<std::mutex> lock(workspace.mutex);
+              collected_metrics = workspace.workspace_ptr->output_runtime.global_metrics.collect_metrics(
+                  workspace.workspace_ptr->l.get());
+            }
             return convert_metrics_to_dict(collected_metrics);
           })
+      .def(
+          "read_counters",
+          [](const workspace_with_logger_contexts& workspace, const std::optional<py::array>& out) -> py::array
+          {
+            const auto& counters = get_counters(workspace);
+            auto result = make_output_array<uint64_t>(out, vwpy::workspace_counters::NUM_VALUES, "read_counters");
+            // The counters are atomic, so neither the lock nor releasing the GIL is needed to read them.
+            counters.export_to(result.mutable_data());
+            return std::move(result);
+          },
+          py::arg("out") = std::nullopt)
+      .def("reset_counters", [](workspace_with_logger_contexts& workspace) { get_counters(workspace).reset(); })
+      .def_static("get_counter_names", &vwpy::workspace_counters::names)
+      .def(
+          "get_sampled_debug_trees",
+          [](workspace_with_logger_contexts& workspace, bool clear) -> std::vector<std::shared_ptr<vwpy::debug_node>>
+          {
+            if (!workspace.debug_sampling.has_value())
+            {
+              throw std::invalid_argument(
+                  "Debug tree sampling is not enabled. Pass debug_sample_every or debug_sample_probability to the "
+                  "Workspace constructor.");
+            }
+            return run_without_gil(workspace,
+                [&]()
+                {
+                  auto& debug_data = get_debug_data(workspace);
+                  auto trees = debug_data.get_captured();
+                  if (clear) { debug_data.clear_captured(); }
+                  return trees;
+                });
+          },
+          py::kw_only(), py::arg("clear") = false)
+      .def("get_reduction_profile",
+          [](workspace_with_logger_contexts& workspace) -> py::tuple
+          {
+            if (workspace.profile == nullptr)
+            {
+              throw std::invalid_argument("Profiling is not enabled. Pass profile=True to the Workspace constructor.");
+            }
+            std::vector<std::string> names;
+            const auto counters = run_without_gil(workspace,
+                [&]()
+                {
+                  for (const auto& reduction : workspace.profile->reductions) { names.push_back(reduction.name); }
+                  return workspace.profile->export_counters();
+                });
+            py::array_t<uint64_t> array(
+                {static_cast<py::ssize_t>(names.size()), static_cast<py::ssize_t>(2),
+                    static_cast<py::ssize_t>(vwpy::profile_counters::NUM_VALUES)},
+                counters.data());
+            return py::make_tuple(names, array);
+          })
+      .def("reset_reduction_profile",
+          [](workspace_with_logger_contexts& workspace)
+          {
+            if (workspace.profile == nullptr)
+            {
+              throw std::invalid_argument("Profiling is not enabled. Pass profile=True to the Workspace constructor.");
+            }
+            run_without_gil(workspace, [&]() { workspace.profile->reset(); });
+          })
+      .def("get_example_pool_stats",
+          [](const workspace_with_logger_contexts& workspace) -> py::dict
+          {
+            const auto stats = workspace.example_pool->stats();
+            py::dict result;
+            result["hits"] = stats.hits;
+            result["misses"] = stats.misses;
+            result["discarded"] = stats.discarded;
+            result["in_use"] = stats.in_use;
+            result["retained"] = stats.retained;
+            result["retained_bytes"] = stats.retained_bytes;
+            result["high_water_mark"] = stats.high_water_mark;
+            result["max_retained"] = stats.max_retained;
+            return result;
+          })
+      .def("trim_example_pool", [](workspace_with_logger_contexts& workspace) { workspace.example_pool->trim(); })
+      .def(
+          "set_example_pool_max_retained", [](workspace_with_logger_contexts& workspace, size_t max_retained)
+          { workspace.example_pool->set_max_retained(max_retained); },
+          py::arg("max_retained"))
       .def("get_prediction_type",
           [](const workspace_with_logger_contexts& workspace)
           { return workspace.workspace_ptr->l->get_output_prediction_type(); })
@@ -1708,132 +4012,271 @@ PYBIND11_MODULE(_core, m)
           [](const workspace_with_logger_contexts& workspace) -> py::bytes
           {
             auto backing_vector = std::make_shared<std::vector<char>>();
-            // Determine size estimate by counting non-zero weights.
-            const auto non_zero_weights = count_non_zero_weights(workspace.workspace_ptr->weights);
-            const auto size_estimate_for_weights =
-                non_zero_weights * sizeof(float) * workspace.workspace_ptr->weights.stride();
-            const auto size_estimate_overall = size_estimate_for_weights + 1024;  // Add 1KB for other info
-            // Best effort reserve of likely final size to avoid reallocations.
-            backing_vector->reserve(size_estimate_overall);
-
-            VW::io_buf io_writer;
-            io_writer.add_file(VW::io::create_vector_writer(backing_vector));
-            VW::save_predictor(*workspace.workspace_ptr, io_writer);
-            io_writer.flush();
+            run_without_gil(workspace,
+                [&]()
+                {
+                  // Determine size estimate by counting non-zero weights.
+                  const auto non_zero_weights = count_non_zero_weights(workspace.workspace_ptr->weights);
+                  const auto size_estimate_for_weights =
+                      non_zero_weights * sizeof(float) * workspace.workspace_ptr->weights.stride();
+                  const auto size_estimate_overall = size_estimate_for_weights + 1024;  // Add 1KB for other info
+                  // Best effort reserve of likely final size to avoid reallocations.
+                  backing_vector->reserve(size_estimate_overall);
+
+                  VW::io_buf io_writer;
+                  io_writer.add_file(VW::io::create_vector_writer(backing_vector));
+                  VW::save_predictor(*workspace.workspace_ptr, io_writer);
+                  io_writer.flush();
+                });
             return py::bytes(backing_vector->data(), backing_vector->size());  // Return the data without transcoding
           })
-      .def("serialize_to_file",
-          [](const workspace_with_logger_contexts& workspace, const std::string& filename)
+      .def("serialize_to_file", [](const workspace_with_logger_contexts& workspace, const std::string& filename)
+          { serialize_to(workspace, open_file_output(filename)); })
+      .def(
+          "serialize_to", [](const workspace_with_logger_contexts& workspace, py::object file)
+          { serialize_to(workspace, VW::make_unique<python_writer>(file)); },
+          py::arg("file"))
+      .def("take_snapshot", &::take_snapshot)
+      .def("get_checkpoint_stats",
+          [](const workspace_with_logger_contexts& workspace) -> py::dict
           {
-            VW::save_predictor(*workspace.workspace_ptr, filename);
+            const auto& stats = workspace.checkpoint_stats;
+            const auto to_seconds = [](const std::atomic<uint64_t>& ns)
+            { return static_cast<double>(ns.load(std::memory_order_relaxed)) / 1e9; };
+            py::dict result;
+            result["checkpoints"] = stats.count.load(std::memory_order_relaxed);
+            result["last_pause_seconds"] = to_seconds(stats.last_pause_ns);
+            result["max_pause_seconds"] = to_seconds(stats.max_pause_ns);
+            result["total_pause_seconds"] = to_seconds(stats.total_pause_ns);
+            return result;
           })
+      .def("restore_checkpoint", &::restore_checkpoint, py::arg("file"))
+      .def("clone", &::clone_workspace, py::kw_only(), py::arg("share_weights") = false)
       .def(
           "get_index_for_scalar_feature",
           [](const workspace_with_logger_contexts& workspace, std::string_view feature_name,
               std::optional<std::string_view> feature_value, std::string_view namespace_name) -> uint64_t
           {
-            auto& ws = *workspace.workspace_ptr;
-
-            const auto ns_hash = ws.parser_runtime.example_parser->hasher(
-                namespace_name.data(), namespace_name.size(), ws.runtime_config.hash_seed);
-            const auto feature_hash =
-                ws.parser_runtime.example_parser->hasher(feature_name.data(), feature_name.size(), ns_hash);
-            uint32_t raw_index = 0;
-            if (feature_value.has_value())
-            {
-              raw_index = ws.parser_runtime.example_parser->hasher(
-                  feature_value.value().data(), feature_value.value().size(), feature_hash);
-            }
-            else { raw_index = feature_hash; }
+            // The options read here are fixed, but freezing replaces the weights whose mask is read.
+            return run_without_gil(workspace,
+                [&]() -> uint64_t
+                {
+                  auto& ws = *workspace.workspace_ptr;
+
+                  const auto ns_hash = ws.parser_runtime.example_parser->hasher(
+                      namespace_name.data(), namespace_name.size(), ws.runtime_config.hash_seed);
+                  const auto feature_hash =
+                      ws.parser_runtime.example_parser->hasher(feature_name.data(), feature_name.size(), ns_hash);
+                  uint32_t raw_index = 0;
+                  if (feature_value.has_value())
+                  {
+                    raw_index = ws.parser_runtime.example_parser->hasher(
+                        feature_value.value().data(), feature_value.value().size(), feature_hash);
+                  }
+                  else { raw_index = feature_hash; }
 
-            // Apply parse mask.
-            raw_index = raw_index & ws.runtime_state.parse_mask;
+                  // Apply parse mask.
+                  raw_index = raw_index & ws.runtime_state.parse_mask;
 
-            // Now we need to handle if the multiplier were to cause truncation.
-            const auto weight_mask = ws.weights.mask();
-            const auto multiplier = static_cast<uint64_t>(ws.reduction_state.total_feature_width)
-                << static_cast<uint64_t>(ws.weights.stride_shift());
+                  // Now we need to handle if the multiplier were to cause truncation.
+                  const auto weight_mask = ws.weights.mask();
+                  const auto multiplier = static_cast<uint64_t>(ws.reduction_state.total_feature_width)
+                      << static_cast<uint64_t>(ws.weights.stride_shift());
 
-            // We essentially do what setup_example does by expanding the weight space then masking based on the weight
-            // mask and then undo the multiplier.
-            const auto final_index = ((static_cast<uint64_t>(raw_index) * multiplier) & weight_mask) / multiplier;
-            return final_index;
+                  // We essentially do what setup_example does by expanding the weight space then masking based on the
+                  // weight mask and then undo the multiplier.
+                  const auto final_index =
+                      ((static_cast<uint64_t>(raw_index) * multiplier) & weight_mask) / multiplier;
+                  return final_index;
+                });
           },
           py::arg("feature_name"), py::arg("feature_value") = std::nullopt, py::arg("namespace_name") = " ")
       .def("weights",
-          [](const workspace_with_logger_contexts& workspace) -> std::unique_ptr<dense_weight_holder>
+          [](workspace_with_logger_contexts& workspace) -> std::unique_ptr<dense_weight_holder>
           {
             if (workspace.workspace_ptr->weights.sparse) { THROW("weights are sparse, cannot return dense weights"); }
-            return std::make_unique<dense_weight_holder>(&workspace.workspace_ptr->weights.dense_weights,
-                workspace.workspace_ptr->reduction_state.total_feature_width, workspace.workspace_ptr);
+            // The returned view can change the weights, so they must not be shared with a clone.
+            return run_without_gil(workspace,
+                [&]()
+                {
+                  own_weights(workspace);
+                  return std::make_unique<dense_weight_holder>(workspace.workspace_ptr->weights.dense_weights,
+                      workspace.workspace_ptr->reduction_state.total_feature_width, workspace.workspace_ptr);
+                });
           })
       .def(
           "json_weights",
           [](const workspace_with_logger_contexts& workspace, bool include_feature_names,
               bool include_online_state) -> std::string
           {
-            // Invert hash is enabled with "--invert_hash"
-            auto old_dump_json_weights_include_feature_names =
-                workspace.workspace_ptr->output_model_config.dump_json_weights_include_feature_names;
-            workspace.workspace_ptr->output_model_config.dump_json_weights_include_feature_names =
-                include_feature_names;
-            auto old_dump_json_weights_include_extra_online_state =
-                workspace.workspace_ptr->output_model_config.dump_json_weights_include_extra_online_state;
-            workspace.workspace_ptr->output_model_config.dump_json_weights_include_extra_online_state =
-                include_online_state;
-            auto on_exit = VW::scope_exit(
+            return run_without_gil(workspace,
                 [&]()
                 {
+                  // Invert hash is enabled with "--invert_hash"
+                  auto old_dump_json_weights_include_feature_names =
+                      workspace.workspace_ptr->output_model_config.dump_json_weights_include_feature_names;
                   workspace.workspace_ptr->output_model_config.dump_json_weights_include_feature_names =
-                      old_dump_json_weights_include_feature_names;
+                      include_feature_names;
+                  auto old_dump_json_weights_include_extra_online_state =
+                      workspace.workspace_ptr->output_model_config.dump_json_weights_include_extra_online_state;
                   workspace.workspace_ptr->output_model_config.dump_json_weights_include_extra_online_state =
-                      old_dump_json_weights_include_extra_online_state;
+                      include_online_state;
+                  auto on_exit = VW::scope_exit(
+                      [&]()
+                      {
+                        workspace.workspace_ptr->output_model_config.dump_json_weights_include_feature_names =
+                            old_dump_json_weights_include_feature_names;
+                        workspace.workspace_ptr->output_model_config.dump_json_weights_include_extra_online_state =
+                            old_dump_json_weights_include_extra_online_state;
+                      });
+                  return workspace.workspace_ptr->dump_weights_to_json_experimental();
                 });
-            return workspace.workspace_ptr->dump_weights_to_json_experimental();
           },
           py::kw_only(), py::arg("include_feature_names") = false, py::arg("include_online_state") = false)
       .def(
           "readable_model",
           [](const workspace_with_logger_contexts& workspace, bool include_feature_names) -> std::string
           {
-            auto& all = *workspace.workspace_ptr;
-            if (include_feature_names)
-            {
-              if (!all.output_config.hash_inv)
-              {
-                THROW(
-                    "record_feature_names must be enabled (from Workspace constructor) to use "
-                    "include_feature_names=True");
-              }
-            }
+            return run_without_gil(workspace,
+                [&]()
+                {
+                  auto& all = *workspace.workspace_ptr;
+                  if (include_feature_names)
+                  {
+                    if (!all.output_config.hash_inv)
+                    {
+                      THROW(
+                          "record_feature_names must be enabled (from Workspace constructor) to use "
+                          "include_feature_names=True");
+                    }
+                  }
 
-            auto print_invert_guard = VW::swap_guard(all.output_config.print_invert, include_feature_names);
-            VW::io_buf buffer;
-            auto vec_buffer = std::make_shared<std::vector<char>>();
-            buffer.add_file(VW::io::create_vector_writer(vec_buffer));
-            VW::details::dump_regressor(all, buffer, true);
-            buffer.flush();
-            return std::string(vec_buffer->data(), vec_buffer->size());
+                  auto print_invert_guard = VW::swap_guard(all.output_config.print_invert, include_feature_names);
+                  VW::io_buf buffer;
+                  auto vec_buffer = std::make_shared<std::vector<char>>();
+                  buffer.add_file(VW::io::create_vector_writer(vec_buffer));
+                  VW::details::dump_regressor(all, buffer, true);
+                  buffer.flush();
+                  return std::string(vec_buffer->data(), vec_buffer->size());
+                });
           },
           py::kw_only(), py::arg("include_feature_names") = false);
 
-  m.def("_parse_line_text", &::parse_text_line, py::arg("workspace"), py::arg("line"));
-  m.def("_parse_line_dsjson", &::parse_dsjson_line, py::arg("workspace"), py::arg("line"));
-  m.def("_parse_line_json", &::parse_json_line, py::arg("workspace"), py::arg("line"));
-  m.def("_write_cache_header", &::write_cache_header, py::arg("workspace"), py::arg("file"));
-  m.def("_write_cache_example", &::write_cache_example, py::arg("workspace"), py::arg("example"), py::arg("file"));
+  m.def(
+      "_parse_line_text",
+      [](workspace_with_logger_contexts& workspace, std::string_view line)
+      {
+        return count_parse_errors(
+            workspace, [&]() { return parse_text_line(*workspace.workspace_ptr, workspace.example_pool, line); });
+      },
+      py::arg("workspace"), py::arg("line"));
+  m.def(
+      "_parse_line_dsjson",
+      [](workspace_with_logger_contexts& workspace, std::string_view line)
+      {
+        return count_parse_errors(
+            workspace, [&]() { return parse_dsjson_line(*workspace.workspace_ptr, workspace.example_pool, line); });
+      },
+      py::arg("workspace"), py::arg("line"));
+  m.def(
+      "_parse_line_json",
+      [](workspace_with_logger_contexts& workspace, std::string_view line)
+      {
+        return count_parse_errors(
+            workspace, [&]() { return parse_json_line(*workspace.workspace_ptr, workspace.example_pool, line); });
+      },
+      py::arg("workspace"), py::arg("line"));
   m.def("_run_cli_driver", &::run_cli_driver, py::arg("args"), py::kw_only(), py::arg("onethread") = false);
 
   py::class_<cache_reader>(m, "_CacheReader")
       .def(py::init([](workspace_with_logger_contexts& workspace, py::object file)
-          { return std::make_unique<cache_reader>(workspace.workspace_ptr, file); }))
+          { return std::make_unique<cache_reader>(workspace.workspace_ptr, workspace.example_pool, file); }))
       .def("_get_next",
           [](cache_reader& reader) -> std::optional<std::shared_ptr<VW::example>>
           {
             auto next_example = reader.read_cache_example();
             if (next_example == nullptr) { return std::nullopt; }
             return next_example;
-          });
+          })
+      .def("_tell", &cache_reader::tell)
+      .def("_seek", &cache_reader::seek, py::arg("offset"));
+
+  m.def(
+      "_open_mapped_cache_reader",
+      [](workspace_with_logger_contexts& workspace, const std::string& path)
+      {
+        return std::make_unique<cache_reader>(
+            workspace.workspace_ptr, workspace.example_pool, vwpy::mapped_file::open(path));
+      },
+      py::arg("workspace"), py::arg("path"));
+
+  m.def(
+      "_parse_csr",
+      [](workspace_with_logger_contexts& workspace,
+          const py::array_t<int64_t, py::array::c_style | py::array::forcecast>& indptr,
+          const py::array_t<int64_t, py::array::c_style | py::array::forcecast>& indices, const float_array& data,
+          const std::optional<float_array>& labels, const std::string& namespace_name, bool hash_columns)
+      {
+        return parse_csr_matrix(*workspace.workspace_ptr, workspace.example_pool, indptr, indices, data, labels,
+            namespace_name, hash_columns);
+      },
+      py::arg("workspace"), py::arg("indptr"), py::arg("indices"), py::arg("data"), py::kw_only(), py::arg("labels"),
+      py::arg("namespace_name"), py::arg("hash_columns"));
+
+  m.def(
+      "_parse_dense",
+      [](workspace_with_logger_contexts& workspace, const float_array& matrix, const std::optional<float_array>& labels,
+          const std::string& namespace_name, bool hash_columns)
+      {
+        return parse_dense_matrix(
+            *workspace.workspace_ptr, workspace.example_pool, matrix, labels, namespace_name, hash_columns);
+      },
+      py::arg("workspace"), py::arg("matrix"), py::kw_only(), py::arg("labels"), py::arg("namespace_name"),
+      py::arg("hash_columns"));
+
+  py::class_<cache_writer>(m, "_CacheWriter")
+      .def(py::init(
+               [](workspace_with_logger_contexts& workspace, py::object file) {
+                 return std::make_unique<cache_writer>(
+                     workspace.workspace_ptr, VW::make_unique<python_writer>(file), true);
+               }),
+          py::arg("workspace"), py::arg("file"))
+      .def(
+          "write_many", [](cache_writer& writer, std::vector<VW::example*>& examples) { writer.write_many(examples); },
+          py::arg("examples"))
+      .def(
+          "write_many_multi_ex", [](cache_writer& writer, std::vector<VW::multi_ex>& examples)
+          { writer.write_many(examples); },
+          py::arg("examples"))
+      .def("flush", &cache_writer::flush)
+      .def("close", &cache_writer::close);
+
+  m.def(
+      "_open_cache_file_writer",
+      [](workspace_with_logger_contexts& workspace, const std::string& path)
+      { return std::make_unique<cache_writer>(workspace.workspace_ptr, VW::io::open_file_writer(path), false); },
+      py::arg("workspace"), py::arg("path"));
+
+  py::enum_<input_format>(m, "_InputFormat")
+      .value("Text", input_format::TEXT)
+      .value("DSJson", input_format::DSJSON)
+      .value("Json", input_format::JSON)
+      .value("Cache", input_format::CACHE);
+
+  py::class_<file_reader>(m, "_FileReader")
+      .def(py::init(
+               [](workspace_with_logger_contexts& workspace, const std::variant<std::string, int>& source,
+                   input_format format)
+               {
+                 return std::make_unique<file_reader>(
+                     workspace.workspace_ptr, workspace.example_pool, open_input(source), format);
+               }),
+          py::arg("workspace"), py::arg("source"), py::arg("format"))
+      .def("_get_next", [](file_reader& reader) -> std::optional<file_reader::item_t> { return reader.read_next(); })
+      .def(
+          "_get_batch", [](file_reader& reader, size_t max_items) -> std::vector<file_reader::item_t>
+          { return reader.read_batch(max_items); },
+          py::arg("max_items"));
 
   py::class_<VW::model_delta>(m, "ModelDelta")
       .def(py::init(
@@ -1855,9 +4298,42 @@ PYBIND11_MODULE(_core, m)
             return py::bytes(backing_vector->data(), backing_vector->size());  // Return the data without transcoding
           });
 
+  py::class_<vwpy::sparse_delta>(m, "SparseModelDelta")
+      .def("__len__", [](const vwpy::sparse_delta& delta) { return delta.indices.size(); })
+      .def_property_readonly("indices",
+          [](const vwpy::sparse_delta& delta)
+          {
+            return make_readonly_view<uint64_t>(
+                {static_cast<py::ssize_t>(delta.indices.size())}, delta.indices.data(), py::cast(&delta));
+          })
+      .def_property_readonly("values",
+          [](const vwpy::sparse_delta& delta)
+          {
+            return make_readonly_view<float>(
+                {static_cast<py::ssize_t>(delta.indices.size()), static_cast<py::ssize_t>(delta.stride())},
+                delta.values.data(), py::cast(&delta));
+          })
+      .def_readonly("num_weights", &vwpy::sparse_delta::num_weights)
+      .def_readonly("weighted_examples", &vwpy::sparse_delta::weighted_examples)
+      .def("serialize", &::serialize_sparse_delta, py::kw_only(), py::arg("precision"), py::arg("compress"))
+      .def("serialize_to", &::serialize_sparse_delta_to, py::arg("file"), py::kw_only(), py::arg("precision"),
+          py::arg("compress"))
+      .def_static("deserialize", &::deserialize_sparse_delta, py::arg("data"))
+      .def_static("deserialize_from", &::deserialize_sparse_delta_from, py::arg("file"));
+
   m.def("_merge_deltas", &::merge_deltas, py::arg("deltas"));
   m.def("_calculate_delta", &::calculate_delta, py::arg("base_workspace"), py::arg("derived_workspace"));
   m.def("_apply_delta", &::apply_delta, py::arg("base_workspace"), py::arg("delta"));
+  m.def("_calculate_sparse_delta", &::calculate_sparse_delta, py::arg("base_workspace"), py::arg("derived_workspace"),
+      py::kw_only(), py::arg("num_threads"));
+  m.def("_merge_sparse_deltas", &::merge_sparse_deltas, py::arg("deltas"), py::kw_only(), py::arg("num_threads"));
+  m.def("_apply_delta_inplace", &::apply_delta_inplace, py::arg("workspace"), py::arg("delta"));
+  m.def("_train_data_parallel", &::train_data_parallel, py::arg("workspace"), py::arg("examples"), py::kw_only(),
+      py::arg("replicas"), py::arg("sync_interval"));
+  m.def("_train_data_parallel_from_file", &::train_data_parallel_from_file, py::arg("workspace"), py::arg("path"),
+      py::kw_only(), py::arg("format"), py::arg("replicas"), py::arg("sync_interval"));
+  m.def("_debug_trees_to_collapsed_stacks", &::debug_trees_to_collapsed_stacks, py::arg("trees"));
+  m.def("_debug_trees_to_chrome_trace", &::debug_trees_to_chrome_trace, py::arg("trees"));
 
 #ifdef VERSION_INFO
   m.attr("__version__") = MACRO_STRINGIFY(VERSION_INFO);
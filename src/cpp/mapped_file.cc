@@ -0,0 +1,128 @@
+#include "mapped_file.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#ifdef _WIN32
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  include <windows.h>
+
+#  include <filesystem>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+
+#  include <cerrno>
+#endif
+
+namespace
+{
+#ifndef _WIN32
+std::runtime_error make_error(const std::string& what, const std::string& path)
+{
+  return std::runtime_error(what + " '" + path + "': " + std::strerror(errno));
+}
+#endif
+}  // namespace
+
+#ifdef _WIN32
+std::shared_ptr<vwpy::mapped_file> vwpy::mapped_file::open(const std::string& path)
+{
+  std::shared_ptr<mapped_file> result(new mapped_file());
+  const auto wide_path = std::filesystem::u8path(path).wstring();
+  HANDLE file = CreateFileW(wide_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+      FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if (file == INVALID_HANDLE_VALUE) { throw std::runtime_error("Failed to open '" + path + "'"); }
+  result->_file_handle = file;
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size)) { throw std::runtime_error("Failed to get the size of '" + path + "'"); }
+  result->_size = static_cast<size_t>(size.QuadPart);
+  // Mapping an empty file is an error on Windows.
+  if (result->_size == 0) { return result; }
+
+  HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (mapping == nullptr) { throw std::runtime_error("Failed to map '" + path + "'"); }
+  result->_mapping_handle = mapping;
+
+  result->_data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+  if (result->_data == nullptr) { throw std::runtime_error("Failed to map '" + path + "'"); }
+  return result;
+}
+
+vwpy::mapped_file::~mapped_file()
+{
+  if (_data != nullptr) { UnmapViewOfFile(_data); }
+  if (_mapping_handle != nullptr) { CloseHandle(_mapping_handle); }
+  if (_file_handle != nullptr) { CloseHandle(_file_handle); }
+}
+
+// Windows has no equivalent of madvise for file mappings, FILE_FLAG_SEQUENTIAL_SCAN is set when opening instead.
+void vwpy::mapped_file::advise_sequential() const {}
+void vwpy::mapped_file::advise_random() const {}
+#else
+std::shared_ptr<vwpy::mapped_file> vwpy::mapped_file::open(const std::string& path)
+{
+  std::shared_ptr<mapped_file> result(new mapped_file());
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd == -1) { throw make_error("Failed to open", path); }
+
+  struct stat file_stat;
+  if (::fstat(fd, &file_stat) == -1)
+  {
+    auto error = make_error("Failed to get the size of", path);
+    ::close(fd);
+    throw error;
+  }
+  result->_size = static_cast<size_t>(file_stat.st_size);
+
+  // The mapping stays valid after the descriptor is closed. Mapping an empty file is an error.
+  if (result->_size != 0)
+  {
+    void* data = ::mmap(nullptr, result->_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED)
+    {
+      auto error = make_error("Failed to map", path);
+      ::close(fd);
+      throw error;
+    }
+    result->_data = static_cast<const char*>(data);
+  }
+  ::close(fd);
+  return result;
+}
+
+vwpy::mapped_file::~mapped_file()
+{
+  if (_data != nullptr) { ::munmap(const_cast<char*>(_data), _size); }
+}
+
+void vwpy::mapped_file::advise_sequential() const
+{
+  if (_data != nullptr) { ::madvise(const_cast<char*>(_data), _size, MADV_SEQUENTIAL); }
+}
+
+void vwpy::mapped_file::advise_random() const
+{
+  if (_data != nullptr) { ::madvise(const_cast<char*>(_data), _size, MADV_RANDOM); }
+}
+#endif
+
+vwpy::mapped_file_reader::mapped_file_reader(std::shared_ptr<const mapped_file> file, size_t offset)
+    : VW::io::reader(true), _file(std::move(file)), _start(offset), _position(offset)
+{
+  if (_start > _file->size()) { throw std::out_of_range("Offset is past the end of the file"); }
+}
+
+ssize_t vwpy::mapped_file_reader::read(char* buffer, size_t num_bytes)
+{
+  const auto num_to_copy = std::min(num_bytes, _file->size() - _position);
+  if (num_to_copy > 0) { std::memcpy(buffer, _file->data() + _position, num_to_copy); }
+  _position += num_to_copy;
+  return static_cast<ssize_t>(num_to_copy);
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "vw/io/io_adapter.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace vwpy
+{
+
+// A read only memory mapping of an entire file. The mapping is released when this is destroyed.
+class mapped_file
+{
+public:
+  static std::shared_ptr<mapped_file> open(const std::string& path);
+
+  mapped_file(const mapped_file&) = delete;
+  mapped_file& operator=(const mapped_file&) = delete;
+  ~mapped_file();
+
+  const char* data() const { return _data; }
+  size_t size() const { return _size; }
+
+  // Hints to the OS about the upcoming access pattern. These are advisory and a no-op where unsupported.
+  void advise_sequential() const;
+  void advise_random() const;
+
+private:
+  mapped_file() = default;
+
+  const char* _data = nullptr;
+  size_t _size = 0;
+#ifdef _WIN32
+  void* _file_handle = nullptr;
+  void* _mapping_handle = nullptr;
+#endif
+};
+
+// Reads from a mapped file starting at the given offset. Each read is a single copy from the mapping into the caller's
+// buffer and does not touch Python.
+class mapped_file_reader : public VW::io::reader
+{
+public:
+  mapped_file_reader(std::shared_ptr<const mapped_file> file, size_t offset);
+
+  ssize_t read(char* buffer, size_t num_bytes) override;
+  void reset() override { _position = _start; }
+
+  size_t position() const { return _position; }
+
+private:
+  std::shared_ptr<const mapped_file> _file;
+  size_t _start;
+  size_t _position;
+};
+
+}  // namespace vwpy
@@ -0,0 +1,114 @@
+#include "matrix_parser.h"
+
+#include "vw/common/hash.h"
+#include "vw/core/global_data.h"
+#include "vw/core/parser.h"
+
+#include <algorithm>
+#include <charconv>
+#include <stdexcept>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define VWPY_SUM_OF_SQUARES_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#  include <arm_neon.h>
+#  define VWPY_SUM_OF_SQUARES_NEON
+#endif
+
+namespace
+{
+// Text format feature indices are masked by the parse mask, hashed columns must be too for them to be equivalent.
+uint64_t hash_column(const VW::workspace& ws, const vwpy::matrix_feature_options& options, uint64_t column)
+{
+  char buffer[24];
+  const auto result = std::to_chars(buffer, buffer + sizeof(buffer), column);
+  const auto length = static_cast<size_t>(result.ptr - buffer);
+  return ws.parser_runtime.example_parser->hasher(buffer, length, options.ns_hash) & ws.runtime_state.parse_mask;
+}
+
+template <typename ColumnFunc>
+void push_row(const VW::workspace& ws, const vwpy::matrix_feature_options& options, VW::example& ex,
+    const float* values, size_t n, ColumnFunc&& column_at)
+{
+  auto& fs = ex.feature_space[options.ns_index];
+  fs.values.reserve(fs.values.size() + n);
+  fs.indices.reserve(fs.indices.size() + n);
+  for (size_t i = 0; i < n; i++)
+  {
+    // Zero valued features are dropped, as in the text format.
+    if (values[i] == 0.f) { continue; }
+    const uint64_t column = column_at(i);
+    fs.values.push_back(values[i]);
+    fs.indices.push_back(options.hash_columns ? hash_column(ws, options, column) : column);
+  }
+  // Zeros don't contribute, so the whole row can be summed without gathering the pushed values.
+  fs.sum_feat_sq += vwpy::sum_of_squares(values, n);
+  ex.reset_total_sum_feat_sq();
+
+  if (!fs.empty() && std::find(ex.indices.begin(), ex.indices.end(), options.ns_index) == ex.indices.end())
+  {
+    ex.indices.push_back(options.ns_index);
+  }
+}
+}  // namespace
+
+float vwpy::sum_of_squares(const float* values, size_t n)
+{
+  size_t i = 0;
+  float result = 0.f;
+#if defined(VWPY_SUM_OF_SQUARES_SSE2)
+  __m128 acc0 = _mm_setzero_ps();
+  __m128 acc1 = _mm_setzero_ps();
+  for (; i + 8 <= n; i += 8)
+  {
+    const __m128 v0 = _mm_loadu_ps(values + i);
+    const __m128 v1 = _mm_loadu_ps(values + i + 4);
+    acc0 = _mm_add_ps(acc0, _mm_mul_ps(v0, v0));
+    acc1 = _mm_add_ps(acc1, _mm_mul_ps(v1, v1));
+  }
+  alignas(16) float lanes[4];
+  _mm_store_ps(lanes, _mm_add_ps(acc0, acc1));
+  result = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#elif defined(VWPY_SUM_OF_SQUARES_NEON)
+  float32x4_t acc0 = vdupq_n_f32(0.f);
+  float32x4_t acc1 = vdupq_n_f32(0.f);
+  for (; i + 8 <= n; i += 8)
+  {
+    const float32x4_t v0 = vld1q_f32(values + i);
+    const float32x4_t v1 = vld1q_f32(values + i + 4);
+    acc0 = vmlaq_f32(acc0, v0, v0);
+    acc1 = vmlaq_f32(acc1, v1, v1);
+  }
+  const float32x4_t acc = vaddq_f32(acc0, acc1);
+  result = (vgetq_lane_f32(acc, 0) + vgetq_lane_f32(acc, 1)) + (vgetq_lane_f32(acc, 2) + vgetq_lane_f32(acc, 3));
+#endif
+  for (; i < n; i++) { result += values[i] * values[i]; }
+  return result;
+}
+
+vwpy::matrix_feature_options vwpy::make_matrix_feature_options(
+    const VW::workspace& ws, const char* namespace_name, size_t namespace_name_size, bool hash_columns)
+{
+  if (namespace_name_size == 0) { throw std::invalid_argument("Namespace name must not be empty."); }
+  matrix_feature_options options{};
+  options.ns_index = static_cast<VW::namespace_index>(namespace_name[0]);
+  const auto hash_seed = ws.runtime_config.hash_seed;
+  // The text parser doesn't hash the name of the default namespace, it only depends on the seed.
+  if (namespace_name[0] == ' ') { options.ns_hash = hash_seed == 0 ? 0 : VW::uniform_hash("", 0, hash_seed); }
+  else { options.ns_hash = ws.parser_runtime.example_parser->hasher(namespace_name, namespace_name_size, hash_seed); }
+  options.hash_columns = hash_columns;
+  return options;
+}
+
+void vwpy::push_sparse_row(const VW::workspace& ws, const matrix_feature_options& options, VW::example& ex,
+    const int64_t* columns, const float* values, size_t n)
+{
+  push_row(ws, options, ex, values, n, [columns](size_t i) { return static_cast<uint64_t>(columns[i]); });
+}
+
+void vwpy::push_dense_row(const VW::workspace& ws, const matrix_feature_options& options, VW::example& ex,
+    const float* values, size_t num_columns)
+{
+  push_row(ws, options, ex, values, num_columns, [](size_t i) { return static_cast<uint64_t>(i); });
+}
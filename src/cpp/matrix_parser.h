@@ -0,0 +1,41 @@
+#pragma once
+
+#include "vw/core/example.h"
+#include "vw/core/vw_fwd.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace vwpy
+{
+
+// Sum of the squares of n values. Vectorized where the platform supports it, so the result may differ from a sequential
+// sum in the last bits.
+float sum_of_squares(const float* values, size_t n);
+
+// Where and how the columns of a matrix are turned into features.
+struct matrix_feature_options
+{
+  VW::namespace_index ns_index;
+  // Used only when hashing columns.
+  uint64_t ns_hash;
+  // If true each column id is hashed as if it were a feature name in the text format. Otherwise column ids are used as
+  // feature indices as is.
+  bool hash_columns;
+};
+
+// Returns options equivalent to the namespace named namespace_name in the text format. A name starting with a space is
+// the default namespace, which is written without a name in the text format.
+matrix_feature_options make_matrix_feature_options(
+    const VW::workspace& ws, const char* namespace_name, size_t namespace_name_size, bool hash_columns);
+
+// Appends the non zero entries of a sparse row to an example. columns and values are n long, columns must not be
+// negative.
+void push_sparse_row(const VW::workspace& ws, const matrix_feature_options& options, VW::example& ex,
+    const int64_t* columns, const float* values, size_t n);
+
+// Appends the non zero entries of a dense row to an example. The column ids are the positions in the row.
+void push_dense_row(const VW::workspace& ws, const matrix_feature_options& options, VW::example& ex,
+    const float* values, size_t num_columns);
+
+}  // namespace vwpy
@@ -55,6 +55,6 @@ vwpy::prediction_t vwpy::to_prediction(const VW::polyprediction& polypred, VW::p
               polypred.active_multiclass.more_info_required_for_classes.end()));
     case VW::prediction_type_t::NOPRED:
     default:
-      return py::none();
+      return std::monostate{};
   }
 }
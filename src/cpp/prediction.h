@@ -3,13 +3,9 @@
 #include "vw/core/example.h"
 #include "vw/core/prediction_type.h"
 
-#include <pybind11/pytypes.h>
-
 #include <vector>
 #include <variant>
 
-namespace py = pybind11;
-
 namespace vwpy
 {
 
@@ -25,7 +21,9 @@ using active_multiclass_pred_t = std::tuple<uint32_t, std::vector<uint32_t>>;
 
 using prediction_t = std::variant<scalar_pred_t, scalars_pred_t, action_scores_pred_t, decision_scores_pred_t,
     multiclass_pred_t, multilabels_pred_t, prob_density_func_pred_t, prob_density_func_value_pred_t,
-    active_multiclass_pred_t, py::none>;
+    active_multiclass_pred_t, std::monostate>;
 
+// Conversion does not touch any Python objects so it is safe to call without holding the GIL. std::monostate is
+// converted to None by pybind11.
 prediction_t to_prediction(const VW::polyprediction& polypred, VW::prediction_type_t type);
 }  // namespace vwpy
@@ -0,0 +1,123 @@
+#include "profile_reduction.h"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+// The profile data owns the interceptors, see below, so they refer to it without owning it.
+struct profile_interceptor
+{
+  profile_interceptor(vwpy::profile_data& profile, vwpy::reduction_profile& counters)
+      : profile(profile), counters(counters)
+  {
+  }
+  vwpy::profile_data& profile;
+  vwpy::reduction_profile& counters;
+};
+
+template <typename ExampleT, bool is_learn>
+void profile_transform(profile_interceptor& data, VW::LEARNER::learner& base, ExampleT& ex)
+{
+  auto& profile = data.profile;
+  // The calls below this one add their time to child_ns, which is then restored for the caller with this call's time
+  // added. If a call throws the value is stale, but every call resets it before calling down.
+  const uint64_t sibling_ns = profile.child_ns;
+  profile.child_ns = 0;
+  const auto start = std::chrono::steady_clock::now();
+  if constexpr (is_learn) { base.learn(ex); }
+  else { base.predict(ex); }
+  const auto total_ns = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+
+  auto& counters = is_learn ? data.counters.learn : data.counters.predict;
+  counters.record(total_ns, total_ns - std::min(profile.child_ns, total_ns));
+  profile.child_ns = sibling_ns + total_ns;
+}
+
+void export_function(const vwpy::profile_counters& counters, uint64_t* output)
+{
+  output[0] = counters.calls;
+  output[1] = counters.total_ns;
+  output[2] = counters.self_ns;
+  std::copy(counters.histogram.begin(), counters.histogram.end(), output + 3);
+}
+}  // namespace
+
+std::vector<uint64_t> vwpy::profile_data::export_counters() const
+{
+  std::vector<uint64_t> result(reductions.size() * 2 * profile_counters::NUM_VALUES);
+  uint64_t* output = result.data();
+  for (const auto& reduction : reductions)
+  {
+    export_function(reduction.learn, output);
+    export_function(reduction.predict, output + profile_counters::NUM_VALUES);
+    output += 2 * profile_counters::NUM_VALUES;
+  }
+  return result;
+}
+
+void vwpy::profile_data::reset()
+{
+  for (auto& reduction : reductions)
+  {
+    reduction.learn = profile_counters{};
+    reduction.predict = profile_counters{};
+  }
+}
+
+std::shared_ptr<VW::LEARNER::learner> vwpy::profile_reduction_setup(VW::setup_base_i& stack_builder)
+{
+  auto base = stack_builder.setup_base_learner();
+  if (base == nullptr) { return nullptr; }
+
+  // We only want to insert the profile interceptor if the next reduction is not the profile reduction.
+  if (base->get_name().find("-profile") != std::string::npos) { return base; }
+
+  // The stack is set up by the builder passing itself to each setup function, so the builder holds the state shared by
+  // the interceptors.
+  auto* builder = dynamic_cast<vwpy::profile_stack_builder*>(&stack_builder);
+  if (builder == nullptr) { throw std::runtime_error("The profile reduction requires profile_stack_builder."); }
+
+  // The reductions below were set up first, so this one goes in front of them.
+  auto& counters = builder->profile->reductions.emplace_front();
+  counters.name = base->get_name();
+  auto data = std::make_unique<profile_interceptor>(*builder->profile, counters);
+
+  auto reduction_name = fmt::format("{}-profile", base->get_name());
+  std::shared_ptr<VW::LEARNER::learner> learner = nullptr;
+  if (base->is_multiline())
+  {
+    learner = VW::LEARNER::make_reduction_learner(std::move(data), base, profile_transform<VW::multi_ex, true>,
+        profile_transform<VW::multi_ex, false>, reduction_name)
+                  .set_learn_returns_prediction(base->learn_returns_prediction)
+                  .set_input_label_type(base->get_input_label_type())
+                  .set_output_label_type(base->get_input_label_type())
+                  .set_input_prediction_type(base->get_output_prediction_type())
+                  .set_output_prediction_type(base->get_output_prediction_type())
+                  .build();
+  }
+  else
+  {
+    learner = VW::LEARNER::make_reduction_learner(std::move(data), base, profile_transform<VW::example, true>,
+        profile_transform<VW::example, false>, reduction_name)
+                  .set_learn_returns_prediction(base->learn_returns_prediction)
+                  .set_input_label_type(base->get_input_label_type())
+                  .set_output_label_type(base->get_input_label_type())
+                  .set_input_prediction_type(base->get_output_prediction_type())
+                  .set_output_prediction_type(base->get_output_prediction_type())
+                  .build();
+  }
+  // As in the debug reduction, the learner exposes the data of the reduction it wraps, so its own data is kept alive
+  // by the profile data.
+  builder->profile->kept_around_reduction_state.push_back(
+      learner->get_internal_type_erased_data_pointer_test_use_only_shared());
+  learner->set_internal_type_erased_data_pointer_does_not_override_funcs(
+      base->get_internal_type_erased_data_pointer_test_use_only_shared());
+  return learner;
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "vw/core/learner.h"
+#include "vw/core/reduction_stack.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace vwpy
+{
+
+// Counts the calls of one function of a reduction. Times are in nanoseconds, measured with std::chrono::steady_clock.
+struct profile_counters
+{
+  static constexpr size_t NUM_BUCKETS = 32;
+  // Number of values exported per function by profile_data::export_counters.
+  static constexpr size_t NUM_VALUES = 3 + NUM_BUCKETS;
+
+  uint64_t calls = 0;
+  // Time spent in the reduction and the reductions below it.
+  uint64_t total_ns = 0;
+  // Time spent in the reduction itself.
+  uint64_t self_ns = 0;
+  // Bucket i counts the calls whose total time was in [2^i, 2^(i+1)) nanoseconds. The first bucket also counts calls
+  // shorter than a nanosecond and the last also counts longer calls.
+  std::array<uint64_t, NUM_BUCKETS> histogram{};
+
+  void record(uint64_t call_total_ns, uint64_t call_self_ns)
+  {
+    calls++;
+    total_ns += call_total_ns;
+    self_ns += call_self_ns;
+    size_t bucket = 0;
+    while (call_total_ns > 1 && bucket < NUM_BUCKETS - 1)
+    {
+      call_total_ns >>= 1;
+      bucket++;
+    }
+    histogram[bucket]++;
+  }
+};
+
+struct reduction_profile
+{
+  std::string name;
+  profile_counters learn;
+  profile_counters predict;
+};
+
+// Shared by the profiling interceptors of a workspace. The counters are updated without synchronization, so they must
+// only be used with the workspace lock held.
+struct profile_data
+{
+  // From the top of the stack down. The interceptors point at their element, which a deque never moves.
+  std::deque<reduction_profile> reductions;
+  // Total time of the calls made by the innermost active call to the reductions below it.
+  uint64_t child_ns = 0;
+  std::vector<std::shared_ptr<void>> kept_around_reduction_state;
+
+  // Writes the counters as a row major array of shape (reductions.size(), 2, profile_counters::NUM_VALUES). The second
+  // axis is learn then predict, and the values are calls, total_ns, self_ns and then the histogram.
+  std::vector<uint64_t> export_counters() const;
+  void reset();
+};
+
+std::shared_ptr<VW::LEARNER::learner> profile_reduction_setup(VW::setup_base_i& stack_builder);
+
+// Like debug_stack_builder this inserts an interceptor between every reduction, but the interceptors only time and
+// count each call into counters allocated while the workspace is set up, which keeps the overhead low enough to leave
+// profiling on in production.
+struct profile_stack_builder : public VW::default_reduction_stack_setup
+{
+  profile_stack_builder() : VW::default_reduction_stack_setup()
+  {
+    auto it = _reduction_stack.begin() + 1;
+    auto tuple_to_insert = std::make_tuple("profile", profile_reduction_setup);
+    // Insert the tuple in between each existing element
+    while (it <= _reduction_stack.end())
+    {
+      it = _reduction_stack.insert(it, tuple_to_insert);
+      it += 2;
+    }
+
+    _setup_name_map[profile_reduction_setup] = "profile";
+  }
+
+  // Read by the interceptors while the workspace is set up, and kept by the caller to read the counters.
+  std::shared_ptr<profile_data> profile = std::make_shared<profile_data>();
+};
+}  // namespace vwpy
@@ -0,0 +1,243 @@
+#include "sparse_delta.h"
+
+#include "vw/core/array_parameters.h"
+#include "vw/core/array_parameters_dense.h"
+#include "vw/core/global_data.h"
+#include "vw/core/shared_data.h"
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace
+{
+// Ranges smaller than this are not worth a thread of their own.
+constexpr uint64_t MIN_WEIGHTS_PER_THREAD = 1 << 16;
+
+struct delta_part
+{
+  std::vector<uint64_t> indices;
+  std::vector<float> values;
+};
+
+// Splits the weight indices [0, num_weights) into contiguous ranges and calls func(begin, end, part) for each range on
+// its own thread. The parts are in the order of their ranges.
+template <typename FuncT>
+std::vector<delta_part> for_each_range(uint64_t num_weights, size_t num_threads, FuncT&& func)
+{
+  if (num_threads == 0) { num_threads = std::max(1u, std::thread::hardware_concurrency()); }
+  num_threads = static_cast<size_t>(
+      std::max<uint64_t>(1, std::min<uint64_t>(num_threads, num_weights / MIN_WEIGHTS_PER_THREAD)));
+
+  std::vector<delta_part> parts(num_threads);
+  std::vector<std::exception_ptr> errors(num_threads);
+  const auto run_range = [&](size_t i)
+  {
+    try
+    {
+      func(num_weights * i / num_threads, num_weights * (i + 1) / num_threads, parts[i]);
+    }
+    catch (...)
+    {
+      errors[i] = std::current_exception();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads - 1);
+  for (size_t i = 1; i < num_threads; i++) { threads.emplace_back(run_range, i); }
+  run_range(0);
+  for (auto& thread : threads) { thread.join(); }
+  for (const auto& error : errors)
+  {
+    if (error != nullptr) { std::rethrow_exception(error); }
+  }
+  return parts;
+}
+
+void concatenate_parts(std::vector<delta_part>& parts, vwpy::sparse_delta& delta)
+{
+  size_t num_indices = 0;
+  for (const auto& part : parts) { num_indices += part.indices.size(); }
+  delta.indices.reserve(num_indices);
+  delta.values.reserve(num_indices << delta.stride_shift);
+  for (auto& part : parts)
+  {
+    delta.indices.insert(delta.indices.end(), part.indices.begin(), part.indices.end());
+    delta.values.insert(delta.values.end(), part.values.begin(), part.values.end());
+    part = delta_part{};
+  }
+}
+
+VW::dense_parameters& get_dense_weights(VW::workspace& ws)
+{
+  if (ws.weights.sparse) { throw std::invalid_argument("Sparse deltas are only supported for dense weights."); }
+  return ws.weights.dense_weights;
+}
+
+void check_matches(const VW::dense_parameters& weights, const vwpy::sparse_delta& delta)
+{
+  if (weights.stride_shift() != delta.stride_shift ||
+      ((weights.mask() + 1) >> weights.stride_shift()) != delta.num_weights)
+  {
+    throw std::invalid_argument("The delta does not match the size of the workspace's weights.");
+  }
+}
+}  // namespace
+
+vwpy::sparse_delta vwpy::calculate_sparse_delta(VW::workspace& base, VW::workspace& derived, size_t num_threads)
+{
+  auto& base_weights = get_dense_weights(base);
+  auto& derived_weights = get_dense_weights(derived);
+  if (base_weights.mask() != derived_weights.mask() || base_weights.stride_shift() != derived_weights.stride_shift())
+  {
+    throw std::invalid_argument(
+        "The weights of the workspaces differ in size, they must use the same number of bits and reductions.");
+  }
+
+  sparse_delta delta;
+  delta.stride_shift = derived_weights.stride_shift();
+  delta.num_weights = (derived_weights.mask() + 1) >> delta.stride_shift;
+  delta.adaptive = derived.weights.adaptive && delta.stride() > 1;
+  delta.weighted_examples = derived.sd->weighted_labeled_examples - base.sd->weighted_labeled_examples;
+
+  const size_t stride = delta.stride();
+  const float* base_values = base_weights.first();
+  const float* derived_values = derived_weights.first();
+  auto parts = for_each_range(delta.num_weights, num_threads,
+      [&](uint64_t begin, uint64_t end, delta_part& part)
+      {
+        for (uint64_t i = begin; i < end; i++)
+        {
+          const float* from = base_values + (i << delta.stride_shift);
+          const float* to = derived_values + (i << delta.stride_shift);
+          // Most weights are untouched between rounds, so compare the raw bytes of the whole stride first.
+          if (std::memcmp(from, to, stride * sizeof(float)) == 0) { continue; }
+          part.indices.push_back(i);
+          for (size_t j = 0; j < stride; j++) { part.values.push_back(to[j] - from[j]); }
+        }
+      });
+  concatenate_parts(parts, delta);
+  return delta;
+}
+
+vwpy::sparse_delta vwpy::merge_sparse_deltas(const std::vector<const sparse_delta*>& deltas, size_t num_threads)
+{
+  if (deltas.empty()) { throw std::invalid_argument("At least one delta is required to merge."); }
+  const auto& first = *deltas.front();
+  double total_examples = 0.;
+  for (const auto* delta : deltas)
+  {
+    if (delta->stride_shift != first.stride_shift || delta->num_weights != first.num_weights ||
+        delta->adaptive != first.adaptive)
+    {
+      throw std::invalid_argument("The deltas must all come from the same base model.");
+    }
+    total_examples += delta->weighted_examples;
+  }
+
+  sparse_delta merged;
+  merged.stride_shift = first.stride_shift;
+  merged.num_weights = first.num_weights;
+  merged.adaptive = first.adaptive;
+  merged.weighted_examples = total_examples;
+
+  std::vector<float> delta_weighting(deltas.size());
+  for (size_t k = 0; k < deltas.size(); k++)
+  {
+    delta_weighting[k] = total_examples > 0.
+        ? static_cast<float>(deltas[k]->weighted_examples / total_examples)
+        : 1.f / static_cast<float>(deltas.size());
+  }
+
+  const size_t stride = merged.stride();
+  auto parts = for_each_range(merged.num_weights, num_threads,
+      [&](uint64_t begin, uint64_t end, delta_part& part)
+      {
+        // A k-way merge of the part of each delta within this range, ordered by weight index.
+        std::vector<size_t> positions(deltas.size());
+        std::vector<size_t> ends(deltas.size());
+        using entry = std::pair<uint64_t, size_t>;
+        std::priority_queue<entry, std::vector<entry>, std::greater<entry>> next;
+        for (size_t k = 0; k < deltas.size(); k++)
+        {
+          const auto& indices = deltas[k]->indices;
+          positions[k] = std::lower_bound(indices.begin(), indices.end(), begin) - indices.begin();
+          ends[k] = std::lower_bound(indices.begin() + positions[k], indices.end(), end) - indices.begin();
+          if (positions[k] < ends[k]) { next.emplace(indices[positions[k]], k); }
+        }
+
+        std::vector<size_t> contributors;
+        while (!next.empty())
+        {
+          const uint64_t index = next.top().first;
+          contributors.clear();
+          while (!next.empty() && next.top().first == index)
+          {
+            contributors.push_back(next.top().second);
+            next.pop();
+          }
+
+          const auto source = [&](size_t k)
+          { return deltas[k]->values.data() + (positions[k] << merged.stride_shift); };
+          float adaptive_total = 0.f;
+          if (merged.adaptive)
+          {
+            for (const auto k : contributors) { adaptive_total += source(k)[1]; }
+          }
+
+          part.indices.push_back(index);
+          const size_t offset = part.values.size();
+          part.values.resize(offset + stride, 0.f);
+          float* destination = part.values.data() + offset;
+          for (const auto k : contributors)
+          {
+            const float* values = source(k);
+            float weighting = delta_weighting[k];
+            if (merged.adaptive) { weighting = adaptive_total > 0.f ? values[1] / adaptive_total : 0.f; }
+            for (size_t j = 0; j < stride; j++) { destination[j] += values[j] * weighting; }
+
+            positions[k]++;
+            if (positions[k] < ends[k]) { next.emplace(deltas[k]->indices[positions[k]], k); }
+          }
+        }
+      });
+  concatenate_parts(parts, merged);
+  return merged;
+}
+
+void vwpy::apply_sparse_delta(VW::workspace& ws, const sparse_delta& delta)
+{
+  auto& weights = get_dense_weights(ws);
+  check_matches(weights, delta);
+
+  float* values = weights.first();
+  for (size_t n = 0; n < delta.indices.size(); n++)
+  {
+    float* destination = values + (delta.indices[n] << delta.stride_shift);
+    const float* source = delta.values.data() + (n << delta.stride_shift);
+    for (size_t j = 0; j < delta.stride(); j++) { destination[j] += source[j]; }
+  }
+}
+
+void vwpy::copy_delta_weights(VW::workspace& from, VW::workspace& to, const sparse_delta& delta)
+{
+  auto& from_weights = get_dense_weights(from);
+  auto& to_weights = get_dense_weights(to);
+  check_matches(from_weights, delta);
+  check_matches(to_weights, delta);
+
+  const float* source = from_weights.first();
+  float* destination = to_weights.first();
+  const size_t stride_bytes = delta.stride() * sizeof(float);
+  for (const auto index : delta.indices)
+  {
+    const auto offset = index << delta.stride_shift;
+    std::memcpy(destination + offset, source + offset, stride_bytes);
+  }
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "vw/core/vw_fwd.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace vwpy
+{
+
+// The difference between the dense weights of two workspaces, holding only the weights which changed. Unlike
+// VW::model_delta the cost of merging and applying one scales with the number of changed weights rather than with the
+// size of the model. Only the weights are included, not the rest of the model state such as the reported statistics.
+struct sparse_delta
+{
+  // Each changed weight has 1 << stride_shift values, the weight followed by its learning state.
+  uint32_t stride_shift = 0;
+  // Number of weights in the model, used to check a delta matches the workspace it is applied to.
+  uint64_t num_weights = 0;
+  // Whether the second value of each stride is the adaptive sum of squared gradients, which weights merging.
+  bool adaptive = false;
+  // Sum of the weights of the labeled examples the delta was learned from, which weights merging if not adaptive.
+  double weighted_examples = 0.;
+  // Weight indices in ascending order, not multiplied by the stride.
+  std::vector<uint64_t> indices;
+  // indices.size() << stride_shift values.
+  std::vector<float> values;
+
+  size_t stride() const { return static_cast<size_t>(1) << stride_shift; }
+};
+
+// Work is split across num_threads threads, or one per hardware thread if num_threads is 0. The caller must hold the
+// locks of both workspaces.
+sparse_delta calculate_sparse_delta(VW::workspace& base, VW::workspace& derived, size_t num_threads);
+
+// Combines deltas from the same base model as VW::merge_deltas combines their weights. With adaptive updates each value
+// is weighted by its share of the total adaptive sum, otherwise each delta is weighted by its share of the examples.
+sparse_delta merge_sparse_deltas(const std::vector<const sparse_delta*>& deltas, size_t num_threads);
+
+// Adds the delta to the weights of the workspace in place. The caller must hold the workspace lock.
+void apply_sparse_delta(VW::workspace& ws, const sparse_delta& delta);
+
+// Copies the weights at the indices of delta from one workspace to another of the same size. If a merged delta was
+// applied to from, this makes to equal to it at the cost of the changed weights, provided the two were equal at every
+// index the merged deltas don't include. The caller must hold the locks of both workspaces.
+void copy_delta_weights(VW::workspace& from, VW::workspace& to, const sparse_delta& delta);
+
+}  // namespace vwpy
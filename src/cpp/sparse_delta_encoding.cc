@@ -0,0 +1,392 @@
+#include "sparse_delta_encoding.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+constexpr char DELTA_MAGIC[8] = {'V', 'W', 'P', 'Y', 'S', 'D', 'L', 'T'};
+constexpr uint32_t DELTA_VERSION = 1;
+constexpr size_t DELTA_HEADER_SIZE = 40;
+constexpr uint8_t DELTA_FLAG_ADAPTIVE = 1;
+constexpr uint8_t DELTA_FLAG_COMPRESSED = 2;
+// Only guards against corrupt input, the weights of every reduction stack have a much smaller stride.
+constexpr uint8_t MAX_STRIDE_SHIFT = 16;
+constexpr size_t INT8_BLOCK_SIZE = 64;
+// Size of the chunks the body is written and read in, before and after compression.
+constexpr size_t BUFFER_SIZE = 1 << 16;
+
+// Header fields are stored in native byte order, which is little endian on every supported platform.
+template <typename T>
+void write_header_field(char* header, size_t offset, T value)
+{
+  std::memcpy(header + offset, &value, sizeof(T));
+}
+
+template <typename T>
+T read_header_field(const char* header, size_t offset)
+{
+  T value;
+  std::memcpy(&value, header + offset, sizeof(T));
+  return value;
+}
+
+// Returns the number of bytes read, which is only less than size at the end of the input.
+size_t read_input(VW::io::reader& input, char* data, size_t size)
+{
+  size_t total = 0;
+  while (total < size)
+  {
+    const auto num_read = input.read(data + total, size - total);
+    if (num_read < 0) { throw std::runtime_error("Failed to read the encoded delta."); }
+    if (num_read == 0) { break; }
+    total += static_cast<size_t>(num_read);
+  }
+  return total;
+}
+
+[[noreturn]] void throw_truncated() { throw std::invalid_argument("The encoded delta is truncated."); }
+
+// Buffers the body of an encoded delta and writes it in chunks, deflating it first if it is compressed.
+class body_writer
+{
+public:
+  body_writer(VW::io::writer& output, bool compress) : _output(output), _compress(compress)
+  {
+    _buffer.reserve(BUFFER_SIZE);
+    if (_compress)
+    {
+      if (deflateInit(&_stream, Z_DEFAULT_COMPRESSION) != Z_OK)
+      {
+        throw std::runtime_error("Failed to initialize zlib compression.");
+      }
+      _compressed.resize(BUFFER_SIZE);
+    }
+  }
+
+  ~body_writer()
+  {
+    if (_compress) { deflateEnd(&_stream); }
+  }
+
+  body_writer(const body_writer&) = delete;
+  body_writer& operator=(const body_writer&) = delete;
+
+  void write(const void* data, size_t size)
+  {
+    const auto* bytes = static_cast<const char*>(data);
+    _buffer.insert(_buffer.end(), bytes, bytes + size);
+    if (_buffer.size() >= BUFFER_SIZE) { write_buffer(Z_NO_FLUSH); }
+  }
+
+  // LEB128, 7 bits per byte with the high bit set on every byte but the last.
+  void write_varint(uint64_t value)
+  {
+    char bytes[10];
+    size_t size = 0;
+    while (value >= 0x80)
+    {
+      bytes[size++] = static_cast<char>((value & 0x7f) | 0x80);
+      value >>= 7;
+    }
+    bytes[size++] = static_cast<char>(value);
+    write(bytes, size);
+  }
+
+  void finish()
+  {
+    write_buffer(Z_FINISH);
+    _output.flush();
+  }
+
+private:
+  void write_buffer(int flush)
+  {
+    if (!_compress)
+    {
+      if (!_buffer.empty()) { _output.write(_buffer.data(), _buffer.size()); }
+      _buffer.clear();
+      return;
+    }
+
+    _stream.next_in = reinterpret_cast<Bytef*>(_buffer.data());
+    _stream.avail_in = static_cast<uInt>(_buffer.size());
+    do
+    {
+      _stream.next_out = reinterpret_cast<Bytef*>(_compressed.data());
+      _stream.avail_out = static_cast<uInt>(_compressed.size());
+      if (deflate(&_stream, flush) == Z_STREAM_ERROR) { throw std::runtime_error("Failed to compress the delta."); }
+      const size_t num_compressed = _compressed.size() - _stream.avail_out;
+      if (num_compressed > 0) { _output.write(_compressed.data(), num_compressed); }
+    } while (_stream.avail_out == 0);
+    _buffer.clear();
+  }
+
+  VW::io::writer& _output;
+  bool _compress;
+  z_stream _stream{};
+  std::vector<char> _buffer;
+  std::vector<char> _compressed;
+};
+
+// Reads the body of an encoded delta from the input in chunks, inflating it if it is compressed.
+class body_reader
+{
+public:
+  body_reader(VW::io::reader& input, bool compressed) : _input(input), _compressed(compressed), _buffer(BUFFER_SIZE)
+  {
+    if (_compressed)
+    {
+      if (inflateInit(&_stream) != Z_OK) { throw std::runtime_error("Failed to initialize zlib decompression."); }
+      _input_buffer.resize(BUFFER_SIZE);
+    }
+  }
+
+  ~body_reader()
+  {
+    if (_compressed) { inflateEnd(&_stream); }
+  }
+
+  body_reader(const body_reader&) = delete;
+  body_reader& operator=(const body_reader&) = delete;
+
+  void read(void* data, size_t size)
+  {
+    auto* bytes = static_cast<char*>(data);
+    while (size > 0)
+    {
+      if (_position == _end) { fill(); }
+      const size_t num_copied = std::min(size, _end - _position);
+      std::memcpy(bytes, _buffer.data() + _position, num_copied);
+      _position += num_copied;
+      bytes += num_copied;
+      size -= num_copied;
+    }
+  }
+
+  uint64_t read_varint()
+  {
+    uint64_t value = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7)
+    {
+      uint8_t byte;
+      read(&byte, 1);
+      value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if ((byte & 0x80) == 0) { return value; }
+    }
+    throw std::invalid_argument("The encoded delta is corrupt.");
+  }
+
+  // Checks the compressed body ends where the delta does, which also verifies its checksum. Anything after an
+  // uncompressed body is left unchecked, since the input may continue past the delta.
+  void finish()
+  {
+    if (!_compressed) { return; }
+    if (_position != _end || inflate_some() != 0)
+    {
+      throw std::invalid_argument("The encoded delta has unexpected data at its end.");
+    }
+  }
+
+private:
+  void fill()
+  {
+    _position = 0;
+    _end = _compressed ? inflate_some() : read_input(_input, _buffer.data(), _buffer.size());
+    if (_end == 0) { throw_truncated(); }
+  }
+
+  // Returns the number of bytes inflated into the buffer, which is 0 only at the end of the compressed stream.
+  size_t inflate_some()
+  {
+    if (_stream_ended) { return 0; }
+    _stream.next_out = reinterpret_cast<Bytef*>(_buffer.data());
+    _stream.avail_out = static_cast<uInt>(_buffer.size());
+    while (_stream.avail_out == _buffer.size())
+    {
+      if (_stream.avail_in == 0)
+      {
+        _stream.next_in = reinterpret_cast<Bytef*>(_input_buffer.data());
+        _stream.avail_in = static_cast<uInt>(read_input(_input, _input_buffer.data(), _input_buffer.size()));
+        if (_stream.avail_in == 0) { throw_truncated(); }
+      }
+      const int result = inflate(&_stream, Z_NO_FLUSH);
+      if (result == Z_STREAM_END)
+      {
+        _stream_ended = true;
+        break;
+      }
+      if (result != Z_OK) { throw std::invalid_argument("The compressed delta is corrupt."); }
+    }
+    return _buffer.size() - _stream.avail_out;
+  }
+
+  VW::io::reader& _input;
+  bool _compressed;
+  bool _stream_ended = false;
+  z_stream _stream{};
+  std::vector<char> _buffer;
+  std::vector<char> _input_buffer;
+  size_t _position = 0;
+  size_t _end = 0;
+};
+
+void write_column(body_writer& body, const vwpy::sparse_delta& delta, size_t column, vwpy::weight_precision precision)
+{
+  const size_t count = delta.indices.size();
+  const auto value = [&](size_t n) { return delta.values[(n << delta.stride_shift) + column]; };
+  switch (precision)
+  {
+    case vwpy::weight_precision::FLOAT32:
+      for (size_t n = 0; n < count; n++)
+      {
+        const float single = value(n);
+        body.write(&single, sizeof(single));
+      }
+      break;
+    case vwpy::weight_precision::FLOAT16:
+      for (size_t n = 0; n < count; n++)
+      {
+        const uint16_t half = vwpy::float_to_half(value(n));
+        body.write(&half, sizeof(half));
+      }
+      break;
+    case vwpy::weight_precision::INT8:
+      // Each block is preceded by its scale, as the weights of a frozen model are quantized.
+      for (size_t begin = 0; begin < count; begin += INT8_BLOCK_SIZE)
+      {
+        const size_t end = std::min(begin + INT8_BLOCK_SIZE, count);
+        float max_abs = 0.f;
+        for (size_t n = begin; n < end; n++) { max_abs = std::max(max_abs, std::fabs(value(n))); }
+        const float scale = max_abs > 0.f ? max_abs / 127.f : 1.f;
+        int8_t block[INT8_BLOCK_SIZE];
+        for (size_t n = begin; n < end; n++)
+        {
+          const float quantized = std::round(value(n) / scale);
+          block[n - begin] = static_cast<int8_t>(std::max(-127.f, std::min(127.f, quantized)));
+        }
+        body.write(&scale, sizeof(scale));
+        body.write(block, end - begin);
+      }
+      break;
+  }
+}
+
+void read_column(body_reader& body, vwpy::sparse_delta& delta, size_t column, vwpy::weight_precision precision)
+{
+  const size_t count = delta.indices.size();
+  const auto value = [&](size_t n) -> float& { return delta.values[(n << delta.stride_shift) + column]; };
+  switch (precision)
+  {
+    case vwpy::weight_precision::FLOAT32:
+      for (size_t n = 0; n < count; n++) { body.read(&value(n), sizeof(float)); }
+      break;
+    case vwpy::weight_precision::FLOAT16:
+      for (size_t n = 0; n < count; n++)
+      {
+        uint16_t half;
+        body.read(&half, sizeof(half));
+        value(n) = vwpy::half_to_float(half);
+      }
+      break;
+    case vwpy::weight_precision::INT8:
+      for (size_t begin = 0; begin < count; begin += INT8_BLOCK_SIZE)
+      {
+        const size_t end = std::min(begin + INT8_BLOCK_SIZE, count);
+        float scale;
+        int8_t block[INT8_BLOCK_SIZE];
+        body.read(&scale, sizeof(scale));
+        body.read(block, end - begin);
+        for (size_t n = begin; n < end; n++) { value(n) = static_cast<float>(block[n - begin]) * scale; }
+      }
+      break;
+  }
+}
+}  // namespace
+
+void vwpy::write_sparse_delta(
+    const sparse_delta& delta, VW::io::writer& output, weight_precision precision, bool compress)
+{
+  char header[DELTA_HEADER_SIZE] = {};
+  std::memcpy(header, DELTA_MAGIC, sizeof(DELTA_MAGIC));
+  write_header_field(header, 8, DELTA_VERSION);
+  write_header_field(header, 12, static_cast<uint8_t>(precision));
+  write_header_field(header, 13,
+      static_cast<uint8_t>((delta.adaptive ? DELTA_FLAG_ADAPTIVE : 0) | (compress ? DELTA_FLAG_COMPRESSED : 0)));
+  write_header_field(header, 14, static_cast<uint8_t>(delta.stride_shift));
+  write_header_field(header, 16, delta.num_weights);
+  write_header_field(header, 24, delta.weighted_examples);
+  write_header_field(header, 32, static_cast<uint64_t>(delta.indices.size()));
+  output.write(header, sizeof(header));
+
+  // The indices are ascending, so the gaps between them are small and mostly fit in a byte or two.
+  body_writer body(output, compress);
+  uint64_t previous = 0;
+  for (const auto index : delta.indices)
+  {
+    body.write_varint(index - previous);
+    previous = index;
+  }
+  // Values are grouped by column so each int8 block shares a scale with values of the same kind, and similar bytes
+  // sit next to each other for compression.
+  for (size_t column = 0; column < delta.stride(); column++) { write_column(body, delta, column, precision); }
+  body.finish();
+}
+
+vwpy::sparse_delta vwpy::read_sparse_delta(VW::io::reader& input)
+{
+  char header[DELTA_HEADER_SIZE];
+  const size_t header_size = read_input(input, header, sizeof(header));
+  if (header_size < sizeof(DELTA_MAGIC) || std::memcmp(header, DELTA_MAGIC, sizeof(DELTA_MAGIC)) != 0)
+  {
+    throw std::invalid_argument("The data is not an encoded sparse delta.");
+  }
+  if (header_size < sizeof(header)) { throw_truncated(); }
+  if (read_header_field<uint32_t>(header, 8) != DELTA_VERSION)
+  {
+    throw std::invalid_argument("The delta was encoded by an unsupported version.");
+  }
+  const auto precision = read_header_field<uint8_t>(header, 12);
+  const auto flags = read_header_field<uint8_t>(header, 13);
+  const auto stride_shift = read_header_field<uint8_t>(header, 14);
+  if (precision > static_cast<uint8_t>(weight_precision::INT8) ||
+      (flags & ~(DELTA_FLAG_ADAPTIVE | DELTA_FLAG_COMPRESSED)) != 0 || stride_shift > MAX_STRIDE_SHIFT)
+  {
+    throw std::invalid_argument("The encoded delta has an invalid header.");
+  }
+
+  sparse_delta delta;
+  delta.stride_shift = stride_shift;
+  delta.adaptive = (flags & DELTA_FLAG_ADAPTIVE) != 0;
+  delta.num_weights = read_header_field<uint64_t>(header, 16);
+  delta.weighted_examples = read_header_field<double>(header, 24);
+  const auto count = read_header_field<uint64_t>(header, 32);
+  if (count > delta.num_weights) { throw std::invalid_argument("The encoded delta has an invalid header."); }
+
+  // Storage grows as indices are read rather than trusting the count, so a corrupt count can't exhaust memory.
+  body_reader body(input, (flags & DELTA_FLAG_COMPRESSED) != 0);
+  delta.indices.reserve(static_cast<size_t>(std::min<uint64_t>(count, BUFFER_SIZE)));
+  uint64_t index = 0;
+  for (uint64_t n = 0; n < count; n++)
+  {
+    const uint64_t gap = body.read_varint();
+    if ((n > 0 && gap == 0) || gap > delta.num_weights - 1 - index)
+    {
+      throw std::invalid_argument("The encoded delta has indices which are out of range or not ascending.");
+    }
+    index += gap;
+    delta.indices.push_back(index);
+  }
+  delta.values.resize(delta.indices.size() << delta.stride_shift);
+  for (size_t column = 0; column < delta.stride(); column++)
+  {
+    read_column(body, delta, column, static_cast<weight_precision>(precision));
+  }
+  body.finish();
+  return delta;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "sparse_delta.h"
+#include "vw/io/io_adapter.h"
+#include "weight_precision.h"
+
+namespace vwpy
+{
+
+// Writes a compact encoding of a sparse delta, whose size scales with the number of changed weights. The indices are
+// stored as varint encoded gaps, and the values column by column in the given precision. float16 and int8 values are
+// rounded, with int8 values scaled per block of 64 values of a column. The encoding after the header can be compressed
+// with zlib.
+void write_sparse_delta(
+    const sparse_delta& delta, VW::io::writer& output, weight_precision precision, bool compress);
+
+// Reads a delta written by write_sparse_delta. The input is read incrementally, so the encoded delta is never held in
+// memory as a whole. Throws std::invalid_argument if the input is not a valid encoded delta.
+sparse_delta read_sparse_delta(VW::io::reader& input);
+
+}  // namespace vwpy
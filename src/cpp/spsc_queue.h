@@ -0,0 +1,87 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace vwpy
+{
+
+// Bounded lock free queue for exactly one producer thread and one consumer thread. The head is only written by the
+// producer and the tail only by the consumer so each side needs a single acquire load to see the other's progress.
+template <typename T>
+class spsc_queue
+{
+public:
+  // One slot is left empty to distinguish a full queue from an empty one.
+  explicit spsc_queue(size_t capacity) : _slots(capacity + 1) {}
+
+  spsc_queue(const spsc_queue&) = delete;
+  spsc_queue& operator=(const spsc_queue&) = delete;
+
+  // Producer only.
+  bool try_push(T&& item)
+  {
+    const auto head = _head.load(std::memory_order_relaxed);
+    const auto next = advance(head);
+    if (next == _tail.load(std::memory_order_acquire)) { return false; }
+    _slots[head] = std::move(item);
+    _head.store(next, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer only.
+  bool try_pop(T& item)
+  {
+    const auto tail = _tail.load(std::memory_order_relaxed);
+    if (tail == _head.load(std::memory_order_acquire)) { return false; }
+    item = std::move(_slots[tail]);
+    _tail.store(advance(tail), std::memory_order_release);
+    return true;
+  }
+
+  // Blocks until the item is pushed. Returns false without pushing if stop becomes true while the queue is full.
+  bool push(T&& item, const std::atomic<bool>& stop)
+  {
+    size_t attempt = 0;
+    while (!try_push(std::move(item)))
+    {
+      if (stop.load(std::memory_order_acquire)) { return false; }
+      backoff(attempt++);
+    }
+    return true;
+  }
+
+  // Blocks until an item is popped. Returns false if stop becomes true and the queue is empty, items pushed before stop
+  // was set are still returned.
+  bool pop(T& item, const std::atomic<bool>& stop)
+  {
+    size_t attempt = 0;
+    while (!try_pop(item))
+    {
+      if (stop.load(std::memory_order_acquire)) { return try_pop(item); }
+      backoff(attempt++);
+    }
+    return true;
+  }
+
+private:
+  size_t advance(size_t index) const { return index + 1 == _slots.size() ? 0 : index + 1; }
+
+  // Spin briefly since the other side is usually only a few microseconds behind, then sleep so a stalled side does not
+  // burn a core.
+  static void backoff(size_t attempt)
+  {
+    if (attempt < 64) { std::this_thread::yield(); }
+    else { std::this_thread::sleep_for(std::chrono::microseconds(50)); }
+  }
+
+  std::vector<T> _slots;
+  // Separate cache lines so the producer and consumer do not contend on the same line.
+  alignas(64) std::atomic<size_t> _head{0};
+  alignas(64) std::atomic<size_t> _tail{0};
+};
+
+}  // namespace vwpy
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+namespace vwpy
+{
+
+enum class weight_precision
+{
+  FLOAT32,
+  FLOAT16,
+  INT8
+};
+
+// IEEE half precision conversion with round to nearest even. Denormals, infinities and NaN are preserved.
+inline uint16_t float_to_half(float value)
+{
+  const uint32_t f16_max = (127u + 16u) << 23;
+  const uint32_t denorm_magic_bits = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  const uint32_t sign = bits & 0x80000000u;
+  bits ^= sign;
+
+  uint16_t result;
+  if (bits >= f16_max) { result = bits > (255u << 23) ? 0x7e00 : 0x7c00; }
+  else if (bits < (113u << 23))
+  {
+    // Too small to be normal in half precision, let the float addition do the rounding.
+    float magic;
+    float abs_value;
+    std::memcpy(&magic, &denorm_magic_bits, sizeof(magic));
+    std::memcpy(&abs_value, &bits, sizeof(abs_value));
+    abs_value += magic;
+    std::memcpy(&bits, &abs_value, sizeof(bits));
+    result = static_cast<uint16_t>(bits - denorm_magic_bits);
+  }
+  else
+  {
+    const uint32_t mantissa_odd = (bits >> 13) & 1u;
+    bits -= 112u << 23;
+    bits += 0xfffu + mantissa_odd;
+    result = static_cast<uint16_t>(bits >> 13);
+  }
+  return static_cast<uint16_t>(result | (sign >> 16));
+}
+
+inline float half_to_float(uint16_t value)
+{
+  const uint32_t shifted_exponent = 0x7c00u << 13;
+  uint32_t bits = (value & 0x7fffu) << 13;
+  const uint32_t exponent = bits & shifted_exponent;
+  bits += 112u << 23;
+  if (exponent == shifted_exponent) { bits += 112u << 23; }
+  else if (exponent == 0)
+  {
+    bits += 1u << 23;
+    const uint32_t magic_bits = 113u << 23;
+    float magic;
+    float result;
+    std::memcpy(&magic, &magic_bits, sizeof(magic));
+    std::memcpy(&result, &bits, sizeof(result));
+    result -= magic;
+    std::memcpy(&bits, &result, sizeof(bits));
+  }
+  bits |= static_cast<uint32_t>(value & 0x8000u) << 16;
+  float result;
+  std::memcpy(&result, &bits, sizeof(result));
+  return result;
+}
+
+}  // namespace vwpy
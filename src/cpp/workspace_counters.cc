@@ -0,0 +1,87 @@
+#include "workspace_counters.h"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+// No other memory is published through the counters, they only need to eventually become visible to a reader polling
+// them, so relaxed ordering is enough.
+constexpr auto ORDER = std::memory_order_relaxed;
+
+void add(std::atomic<uint64_t>& counter, uint64_t value) { counter.fetch_add(value, ORDER); }
+
+uint64_t* export_histogram(const vwpy::latency_histogram& histogram, uint64_t* output)
+{
+  for (const auto& bucket : histogram.buckets) { *output++ = bucket.load(ORDER); }
+  return output;
+}
+
+void reset_histogram(vwpy::latency_histogram& histogram)
+{
+  histogram.total_ns.store(0, ORDER);
+  for (auto& bucket : histogram.buckets) { bucket.store(0, ORDER); }
+}
+}  // namespace
+
+void vwpy::latency_histogram::record(uint64_t call_ns)
+{
+  add(total_ns, call_ns);
+  size_t bucket = 0;
+  while (call_ns > 1 && bucket < NUM_BUCKETS - 1)
+  {
+    call_ns >>= 1;
+    bucket++;
+  }
+  add(buckets[bucket], 1);
+}
+
+void vwpy::workspace_counters::record_call(
+    bool is_learn, uint64_t call_ns, uint64_t call_features, uint64_t call_interacted_features)
+{
+  add(is_learn ? examples_learned : examples_predicted, 1);
+  add(features, call_features);
+  add(interacted_features, call_interacted_features);
+  (is_learn ? learn_latency : predict_latency).record(call_ns);
+}
+
+std::vector<std::string> vwpy::workspace_counters::names()
+{
+  std::vector<std::string> result = {"examples_learned", "examples_predicted", "features", "interacted_features",
+      "parse_errors", "learn_latency_total_ns", "predict_latency_total_ns"};
+  for (const auto* kind : {"learn", "predict"})
+  {
+    for (size_t i = 0; i < latency_histogram::NUM_BUCKETS; i++)
+    {
+      result.push_back(std::string(kind) + "_latency_bucket_" + std::to_string(i));
+    }
+  }
+  return result;
+}
+
+void vwpy::workspace_counters::export_to(uint64_t* output) const
+{
+  *output++ = examples_learned.load(ORDER);
+  *output++ = examples_predicted.load(ORDER);
+  *output++ = features.load(ORDER);
+  *output++ = interacted_features.load(ORDER);
+  *output++ = parse_errors.load(ORDER);
+  *output++ = learn_latency.total_ns.load(ORDER);
+  *output++ = predict_latency.total_ns.load(ORDER);
+  output = export_histogram(learn_latency, output);
+  export_histogram(predict_latency, output);
+}
+
+void vwpy::workspace_counters::reset()
+{
+  examples_learned.store(0, ORDER);
+  examples_predicted.store(0, ORDER);
+  features.store(0, ORDER);
+  interacted_features.store(0, ORDER);
+  parse_errors.store(0, ORDER);
+  reset_histogram(learn_latency);
+  reset_histogram(predict_latency);
+}
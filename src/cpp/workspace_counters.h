@@ -0,0 +1,56 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace vwpy
+{
+
+// Latencies of one kind of call into the reduction stack, in nanoseconds measured with std::chrono::steady_clock.
+struct latency_histogram
+{
+  static constexpr size_t NUM_BUCKETS = 32;
+
+  std::atomic<uint64_t> total_ns{0};
+  // Bucket i counts the calls which took [2^i, 2^(i+1)) nanoseconds. The first bucket also counts calls shorter than a
+  // nanosecond and the last also counts longer calls.
+  std::array<std::atomic<uint64_t>, NUM_BUCKETS> buckets{};
+
+  void record(uint64_t call_ns);
+};
+
+// Counts the examples a workspace learned from and predicted on. learn_parallel and frozen workspaces record calls from
+// many threads at once and the counters are read without the workspace lock, so each counter is updated atomically on
+// its own. A reader may see one counter of a call updated before another.
+struct workspace_counters
+{
+  // Number of values written by export_to.
+  static constexpr size_t NUM_VALUES = 7 + 2 * latency_histogram::NUM_BUCKETS;
+
+  // Multiline examples count once.
+  std::atomic<uint64_t> examples_learned{0};
+  std::atomic<uint64_t> examples_predicted{0};
+  // Features of the examples before interactions, including the constant feature.
+  std::atomic<uint64_t> features{0};
+  // Features generated by interactions.
+  std::atomic<uint64_t> interacted_features{0};
+  std::atomic<uint64_t> parse_errors{0};
+  latency_histogram learn_latency;
+  latency_histogram predict_latency;
+
+  void record_call(bool is_learn, uint64_t call_ns, uint64_t call_features, uint64_t call_interacted_features);
+
+  // Names of the values written by export_to, in order. The histogram buckets are named after the kind of call and the
+  // bucket index.
+  static std::vector<std::string> names();
+  // Writes NUM_VALUES values: the counters in the order they are declared, the total learn and predict latencies and
+  // then the learn and predict histograms.
+  void export_to(uint64_t* output) const;
+  void reset();
+};
+
+}  // namespace vwpy
@@ -1,11 +1,23 @@
 from ._core import __version__, _vw_version, _vw_commit
 from .example import Example
 from .workspace import Workspace, DebugNode
+from .debug_export import write_chrome_trace, write_flamegraph
 from .text_format import TextFormatParser, TextFormatReader
 from .json_format import JsonFormatParser, JsonFormatReader
 from .dsjson_format import DSJsonFormatParser, DSJsonFormatReader
 from .cache_format import CacheFormatWriter, CacheFormatReader
-from .delta import ModelDelta, calculate_delta, apply_delta, merge_deltas
+from .matrix_format import MatrixFormatParser
+from .delta import (
+    ModelDelta,
+    SparseModelDelta,
+    calculate_delta,
+    calculate_sparse_delta,
+    apply_delta,
+    apply_delta_inplace,
+    merge_deltas,
+    merge_sparse_deltas,
+    train_data_parallel,
+)
 from .cli_driver import CLIError, run_cli_driver
 from .prediction_type import PredictionType
 from .labels import (
@@ -27,9 +39,11 @@ VW_VERSION: str = _vw_version
 __all__ = [
     "__version__",
     "apply_delta",
+    "apply_delta_inplace",
     "CacheFormatReader",
     "CacheFormatWriter",
     "calculate_delta",
+    "calculate_sparse_delta",
     "CBLabel",
     "CLIError",
     "CSLabel",
@@ -42,15 +56,21 @@ __all__ = [
     "JsonFormatParser",
     "JsonFormatReader",
     "LabelType",
+    "MatrixFormatParser",
     "merge_deltas",
+    "merge_sparse_deltas",
     "ModelDelta",
     "MulticlassLabel",
     "PredictionType",
     "run_cli_driver",
     "SimpleLabel",
+    "SparseModelDelta",
     "TextFormatParser",
     "TextFormatReader",
+    "train_data_parallel",
     "VW_COMMIT",
     "VW_VERSION",
     "Workspace",
+    "write_chrome_trace",
+    "write_flamegraph",
 ]
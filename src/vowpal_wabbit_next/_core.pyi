@@ -18,6 +18,7 @@ __all__ = [
     "MulticlassLabel",
     "PredictionType",
     "SimpleLabel",
+    "SparseModelDelta",
     "Workspace"
 ]
 
@@ -161,6 +162,8 @@ class DebugNode():
     """
     A node in the computation tree of a single learn/predict call. This represents the state of the example as it is entering a given reduction.
 
+    The example fields which were not selected by the `debug_tree_fields` argument of the workspace are None.
+
     .. warning::
       This is a highly experimental feature.
     """
@@ -179,18 +182,18 @@ class DebugNode():
         :type: str
         """
     @property
-    def input_labels(self) -> typing.Union[typing.Union[SimpleLabel, MulticlassLabel, CBLabel, CSLabel, CCBLabel, None], typing.List[typing.Union[SimpleLabel, MulticlassLabel, CBLabel, CSLabel, CCBLabel, None]]]:
+    def input_labels(self) -> typing.Optional[typing.Union[typing.Union[SimpleLabel, MulticlassLabel, CBLabel, CSLabel, CCBLabel, None], typing.List[typing.Union[SimpleLabel, MulticlassLabel, CBLabel, CSLabel, CCBLabel, None]]]]:
         """
         The label that was passed into this reduction. Or, list of labels if this reduction is a multi-example reduction.
 
-        :type: typing.Union[typing.Union[SimpleLabel, MulticlassLabel, CBLabel, CSLabel, CCBLabel, None], typing.List[typing.Union[SimpleLabel, MulticlassLabel, CBLabel, CSLabel, CCBLabel, None]]]
+        :type: typing.Optional[typing.Union[typing.Union[SimpleLabel, MulticlassLabel, CBLabel, CSLabel, CCBLabel, None], typing.List[typing.Union[SimpleLabel, MulticlassLabel, CBLabel, CSLabel, CCBLabel, None]]]]
         """
     @property
-    def interactions(self) -> typing.Union[typing.List[str], typing.List[typing.List[str]]]:
+    def interactions(self) -> typing.Optional[typing.Union[typing.List[str], typing.List[typing.List[str]]]]:
         """
         The interactions that were used to generate the features for this reduction. Or, list of interactions if this reduction is a multi-example reduction.
 
-        :type: typing.Union[typing.List[str], typing.List[typing.List[str]]]
+        :type: typing.Optional[typing.Union[typing.List[str], typing.List[typing.List[str]]]]
         """
     @property
     def is_multiline(self) -> bool:
@@ -214,25 +217,25 @@ class DebugNode():
         :type: int
         """
     @property
-    def offset(self) -> typing.Union[int, typing.List[int]]:
+    def offset(self) -> typing.Optional[typing.Union[int, typing.List[int]]]:
         """
         The offset of the example. Or, list of offsets if this reduction is a multi-example reduction. This also includes the stride of the bottom learner.
 
-        :type: typing.Union[int, typing.List[int]]
+        :type: typing.Optional[typing.Union[int, typing.List[int]]]
         """
     @property
-    def output_prediction(self) -> typing.Union[float, typing.List[float], typing.List[typing.Tuple[int, float]], typing.List[typing.List[typing.Tuple[int, float]]], int, typing.List[int], typing.List[typing.Tuple[float, float, float]], typing.Tuple[float, float], typing.Tuple[int, typing.List[int]], None]:
+    def output_prediction(self) -> typing.Optional[typing.Union[float, typing.List[float], typing.List[typing.Tuple[int, float]], typing.List[typing.List[typing.Tuple[int, float]]], int, typing.List[int], typing.List[typing.Tuple[float, float, float]], typing.Tuple[float, float], typing.Tuple[int, typing.List[int]], None]]:
         """
         The prediction that this reduction produced.
 
-        :type: typing.Union[float, typing.List[float], typing.List[typing.Tuple[int, float]], typing.List[typing.List[typing.Tuple[int, float]]], int, typing.List[int], typing.List[typing.Tuple[float, float, float]], typing.Tuple[float, float], typing.Tuple[int, typing.List[int]], None]
+        :type: typing.Optional[typing.Union[float, typing.List[float], typing.List[typing.Tuple[int, float]], typing.List[typing.List[typing.Tuple[int, float]]], int, typing.List[int], typing.List[typing.Tuple[float, float, float]], typing.Tuple[float, float], typing.Tuple[int, typing.List[int]], None]]
         """
     @property
-    def partial_prediction(self) -> typing.Union[float, typing.List[float]]:
+    def partial_prediction(self) -> typing.Optional[typing.Union[float, typing.List[float]]]:
         """
         The partial prediction on the example after this reduction ran. Or, list of partial predictions if this reduction is a multi-example reduction. This is generally only set by the bottom of the stack.
 
-        :type: typing.Union[float, typing.List[float]]
+        :type: typing.Optional[typing.Union[float, typing.List[float]]]
         """
     @property
     def self_duration_ns(self) -> int:
@@ -249,18 +252,18 @@ class DebugNode():
         :type: int
         """
     @property
-    def updated_prediction(self) -> typing.Union[float, typing.List[float]]:
+    def updated_prediction(self) -> typing.Optional[typing.Union[float, typing.List[float]]]:
         """
         The partial prediction on the example after this reduction ran. Or, list of partial predictions if this reduction is a multi-example reduction. This is generally only set by the bottom of the stack.
 
-        :type: typing.Union[float, typing.List[float]]
+        :type: typing.Optional[typing.Union[float, typing.List[float]]]
         """
     @property
-    def weight(self) -> typing.Union[float, typing.List[float]]:
+    def weight(self) -> typing.Optional[typing.Union[float, typing.List[float]]]:
         """
         The weight of the example. Or, list of weights if this reduction is a multi-example reduction.
 
-        :type: typing.Union[float, typing.List[float]]
+        :type: typing.Optional[typing.Union[float, typing.List[float]]]
         """
     pass
 class DenseParameters():
@@ -472,36 +475,203 @@ class SimpleLabel():
         The weight of this label.
         """
     pass
+class SparseModelDelta():
+    def __len__(self) -> int: ...
+    @staticmethod
+    def deserialize(data: bytes) -> SparseModelDelta: ...
+    @staticmethod
+    def deserialize_from(file: object) -> SparseModelDelta: ...
+    def serialize(self, *, precision: _WeightPrecision, compress: bool) -> bytes: ...
+    def serialize_to(self, file: object, *, precision: _WeightPrecision, compress: bool) -> None: ...
+    @property
+    def indices(self) -> numpy.ndarray[numpy.uint64]:
+        """
+        :type: numpy.ndarray[numpy.uint64]
+        """
+    @property
+    def num_weights(self) -> int:
+        """
+        :type: int
+        """
+    @property
+    def values(self) -> numpy.ndarray[numpy.float32]:
+        """
+        :type: numpy.ndarray[numpy.float32]
+        """
+    @property
+    def weighted_examples(self) -> float:
+        """
+        :type: float
+        """
+    pass
 class Workspace():
-    def __init__(self, args: typing.List[str], *, model_data: typing.Optional[bytes] = None, record_feature_names: bool = False, record_metrics: bool = False, debug: bool = False) -> None: ...
+    def __init__(self, args: typing.List[str], *, model_data: typing.Optional[bytes] = None, model_path: typing.Optional[str] = None, model_file: typing.Optional[object] = None, record_feature_names: bool = False, record_metrics: bool = False, record_counters: bool = False, debug: bool = False, profile: bool = False, debug_sample_every: typing.Optional[int] = None, debug_sample_probability: typing.Optional[float] = None, debug_sample_buffer_size: int = 100, debug_tree_fields: typing.Optional[typing.List[str]] = None) -> None: ...
+    def attach_frozen(self, file: _FrozenModelFile) -> None: ...
+    def clone(self, *, share_weights: bool = False) -> Workspace: ...
     def end_pass(self) -> None: ...
+    def freeze(self, precision: _WeightPrecision) -> None: ...
+    def get_checkpoint_stats(self) -> dict: ...
+    @staticmethod
+    def get_counter_names() -> typing.List[str]: ...
+    def get_example_pool_stats(self) -> dict: ...
+    def get_frozen_weights_bytes(self) -> typing.Optional[int]: ...
     def get_index_for_scalar_feature(self, feature_name: str, feature_value: typing.Optional[str] = None, namespace_name: str = ' ') -> int: ...
+    def get_is_frozen(self) -> bool: ...
     def get_is_multiline(self) -> bool: ...
     def get_label_type(self) -> LabelType: ...
     def get_metrics(self) -> dict: ...
     def get_prediction_type(self) -> PredictionType: ...
+    def get_reduction_profile(self) -> tuple: ...
+    def get_sampled_debug_trees(self, *, clear: bool = False) -> typing.List[DebugNode]: ...
     def json_weights(self, *, include_feature_names: bool = False, include_online_state: bool = False) -> str: ...
+    def learn_batch(self, examples: typing.List[Example]) -> None: ...
+    def learn_multi_ex_batch(self, examples: typing.List[typing.List[Example]]) -> None: ...
     def learn_multi_ex_one(self, examples: typing.List[Example]) -> typing.Union[None, typing.List[DebugNode]]: ...
     def learn_one(self, examples: Example) -> typing.Union[None, typing.List[DebugNode]]: ...
+    def learn_parallel(self, examples: typing.List[Example], *, threads: int) -> int: ...
+    def learn_parallel_from_file(self, path: str, *, format: _InputFormat, threads: int) -> int: ...
+    def predict_batch(self, examples: typing.List[Example]) -> object: ...
+    def predict_multi_ex_batch(self, examples: typing.List[typing.List[Example]]) -> object: ...
     def predict_multi_ex_one(self, examples: typing.List[Example]) -> typing.Union[typing.Union[float, typing.List[float], typing.List[typing.Tuple[int, float]], typing.List[typing.List[typing.Tuple[int, float]]], int, typing.List[int], typing.List[typing.Tuple[float, float, float]], typing.Tuple[float, float], typing.Tuple[int, typing.List[int]], None], typing.Tuple[typing.Union[float, typing.List[float], typing.List[typing.Tuple[int, float]], typing.List[typing.List[typing.Tuple[int, float]]], int, typing.List[int], typing.List[typing.Tuple[float, float, float]], typing.Tuple[float, float], typing.Tuple[int, typing.List[int]], None], DebugNode]]: ...
+    def predict_multi_ex_one_numpy(self, example: typing.List[Example], *, out: typing.Optional[numpy.ndarray] = None) -> object: ...
     def predict_one(self, examples: Example) -> typing.Union[typing.Union[float, typing.List[float], typing.List[typing.Tuple[int, float]], typing.List[typing.List[typing.Tuple[int, float]]], int, typing.List[int], typing.List[typing.Tuple[float, float, float]], typing.Tuple[float, float], typing.Tuple[int, typing.List[int]], None], typing.Tuple[typing.Union[float, typing.List[float], typing.List[typing.Tuple[int, float]], typing.List[typing.List[typing.Tuple[int, float]]], int, typing.List[int], typing.List[typing.Tuple[float, float, float]], typing.Tuple[float, float], typing.Tuple[int, typing.List[int]], None], DebugNode]]: ...
+    def predict_one_numpy(self, example: Example, *, out: typing.Optional[numpy.ndarray] = None) -> object: ...
     def predict_then_learn_multi_ex_one(self, examples: typing.List[Example]) -> typing.Union[typing.Union[float, typing.List[float], typing.List[typing.Tuple[int, float]], typing.List[typing.List[typing.Tuple[int, float]]], int, typing.List[int], typing.List[typing.Tuple[float, float, float]], typing.Tuple[float, float], typing.Tuple[int, typing.List[int]], None], typing.Tuple[typing.Union[float, typing.List[float], typing.List[typing.Tuple[int, float]], typing.List[typing.List[typing.Tuple[int, float]]], int, typing.List[int], typing.List[typing.Tuple[float, float, float]], typing.Tuple[float, float], typing.Tuple[int, typing.List[int]], None], typing.List[DebugNode]]]: ...
     def predict_then_learn_one(self, examples: Example) -> typing.Union[typing.Union[float, typing.List[float], typing.List[typing.Tuple[int, float]], typing.List[typing.List[typing.Tuple[int, float]]], int, typing.List[int], typing.List[typing.Tuple[float, float, float]], typing.Tuple[float, float], typing.Tuple[int, typing.List[int]], None], typing.Tuple[typing.Union[float, typing.List[float], typing.List[typing.Tuple[int, float]], typing.List[typing.List[typing.Tuple[int, float]]], int, typing.List[int], typing.List[typing.Tuple[float, float, float]], typing.Tuple[float, float], typing.Tuple[int, typing.List[int]], None], typing.List[DebugNode]]]: ...
+    def prepare(self, examples: typing.List[Example]) -> None: ...
+    def read_counters(self, out: typing.Optional[numpy.ndarray] = None) -> numpy.ndarray: ...
     def readable_model(self, *, include_feature_names: bool = False) -> str: ...
+    def reset_counters(self) -> None: ...
+    def reset_reduction_profile(self) -> None: ...
+    def restore_checkpoint(self, file: _CheckpointFile) -> None: ...
+    def save_frozen(self, path: str) -> None: ...
     def serialize(self) -> bytes: ...
+    def serialize_to(self, file: object) -> None: ...
     def serialize_to_file(self, arg0: str) -> None: ...
+    def set_example_pool_max_retained(self, max_retained: int) -> None: ...
+    def take_snapshot(self) -> _WorkspaceSnapshot: ...
+    def train_from_file(self, path: str, *, format: _InputFormat, passes: int, queue_size: int) -> int: ...
+    def trim_example_pool(self) -> None: ...
+    def unprepare(self, examples: typing.List[Example]) -> None: ...
     def weights(self) -> DenseParameters: ...
     pass
 class _CacheReader():
     def __init__(self, arg0: Workspace, arg1: object) -> None: ...
     def _get_next(self) -> typing.Optional[Example]: ...
+    def _seek(self, offset: int) -> None: ...
+    def _tell(self) -> int: ...
+    pass
+class _CacheWriter():
+    def __init__(self, workspace: Workspace, file: object) -> None: ...
+    def close(self) -> None: ...
+    def flush(self) -> None: ...
+    def write_many(self, examples: typing.List[Example]) -> None: ...
+    def write_many_multi_ex(self, examples: typing.List[typing.List[Example]]) -> None: ...
+    pass
+class _CheckpointFile():
+    def __init__(self, path: str) -> None: ...
+    @property
+    def model_data(self) -> bytes:
+        """
+        :type: bytes
+        """
+    pass
+class _FileReader():
+    def __init__(self, workspace: Workspace, source: typing.Union[str, int], format: _InputFormat) -> None: ...
+    def _get_batch(self, max_items: int) -> typing.List[typing.Union[Example, typing.List[Example]]]: ...
+    def _get_next(self) -> typing.Optional[typing.Union[Example, typing.List[Example]]]: ...
+    pass
+class _FrozenModelFile():
+    def __init__(self, path: str) -> None: ...
+    @property
+    def model_data(self) -> bytes:
+        """
+        :type: bytes
+        """
+    pass
+class _InputFormat():
+    def __eq__(self, other: object) -> bool: ...
+    def __getstate__(self) -> int: ...
+    def __hash__(self) -> int: ...
+    def __index__(self) -> int: ...
+    def __init__(self, value: int) -> None: ...
+    def __int__(self) -> int: ...
+    def __ne__(self, other: object) -> bool: ...
+    def __repr__(self) -> str: ...
+    def __setstate__(self, state: int) -> None: ...
+    @property
+    def name(self) -> str:
+        """
+        :type: str
+        """
+    @property
+    def value(self) -> int:
+        """
+        :type: int
+        """
+    Cache: vowpal_wabbit_next._core._InputFormat # value = <_InputFormat.Cache: 3>
+    DSJson: vowpal_wabbit_next._core._InputFormat # value = <_InputFormat.DSJson: 1>
+    Json: vowpal_wabbit_next._core._InputFormat # value = <_InputFormat.Json: 2>
+    Text: vowpal_wabbit_next._core._InputFormat # value = <_InputFormat.Text: 0>
+    __members__: dict # value = {'Text': <_InputFormat.Text: 0>, 'DSJson': <_InputFormat.DSJson: 1>, 'Json': <_InputFormat.Json: 2>, 'Cache': <_InputFormat.Cache: 3>}
+    pass
+class _WeightPrecision():
+    def __eq__(self, other: object) -> bool: ...
+    def __getstate__(self) -> int: ...
+    def __hash__(self) -> int: ...
+    def __index__(self) -> int: ...
+    def __init__(self, value: int) -> None: ...
+    def __int__(self) -> int: ...
+    def __ne__(self, other: object) -> bool: ...
+    def __repr__(self) -> str: ...
+    def __setstate__(self, state: int) -> None: ...
+    @property
+    def name(self) -> str:
+        """
+        :type: str
+        """
+    @property
+    def value(self) -> int:
+        """
+        :type: int
+        """
+    Float16: vowpal_wabbit_next._core._WeightPrecision # value = <_WeightPrecision.Float16: 1>
+    Float32: vowpal_wabbit_next._core._WeightPrecision # value = <_WeightPrecision.Float32: 0>
+    Int8: vowpal_wabbit_next._core._WeightPrecision # value = <_WeightPrecision.Int8: 2>
+    __members__: dict # value = {'Float32': <_WeightPrecision.Float32: 0>, 'Float16': <_WeightPrecision.Float16: 1>, 'Int8': <_WeightPrecision.Int8: 2>}
+    pass
+class _WorkspaceSnapshot():
+    def write_to_file(self, path: str) -> None: ...
+    @property
+    def weights_bytes(self) -> int:
+        """
+        :type: int
+        """
     pass
 def _apply_delta(base_workspace: Workspace, delta: ModelDelta) -> Workspace:
     pass
+def _apply_delta_inplace(workspace: Workspace, delta: SparseModelDelta) -> None:
+    pass
 def _calculate_delta(base_workspace: Workspace, derived_workspace: Workspace) -> ModelDelta:
     pass
+def _calculate_sparse_delta(base_workspace: Workspace, derived_workspace: Workspace, *, num_threads: int) -> SparseModelDelta:
+    pass
+def _debug_trees_to_chrome_trace(trees: typing.List[DebugNode]) -> str:
+    pass
+def _debug_trees_to_collapsed_stacks(trees: typing.List[DebugNode]) -> str:
+    pass
 def _merge_deltas(deltas: typing.List[ModelDelta]) -> ModelDelta:
     pass
+def _merge_sparse_deltas(deltas: typing.List[SparseModelDelta], *, num_threads: int) -> SparseModelDelta:
+    pass
+def _open_cache_file_writer(workspace: Workspace, path: str) -> _CacheWriter:
+    pass
+def _open_mapped_cache_reader(workspace: Workspace, path: str) -> _CacheReader:
+    pass
+def _parse_csr(workspace: Workspace, indptr: numpy.ndarray[numpy.int64], indices: numpy.ndarray[numpy.int64], data: numpy.ndarray[numpy.float32], *, labels: typing.Optional[numpy.ndarray[numpy.float32]], namespace_name: str, hash_columns: bool) -> typing.List[Example]:
+    pass
+def _parse_dense(workspace: Workspace, matrix: numpy.ndarray[numpy.float32], *, labels: typing.Optional[numpy.ndarray[numpy.float32]], namespace_name: str, hash_columns: bool) -> typing.List[Example]:
+    pass
 def _parse_line_dsjson(workspace: Workspace, line: str) -> typing.List[Example]:
     pass
 def _parse_line_json(workspace: Workspace, line: str) -> typing.List[Example]:
@@ -510,9 +680,9 @@ def _parse_line_text(workspace: Workspace, line: str) -> Example:
     pass
 def _run_cli_driver(args: typing.List[str], *, onethread: bool = False) -> typing.Tuple[typing.Optional[str], str, typing.List[str]]:
     pass
-def _write_cache_example(workspace: Workspace, example: Example, file: object) -> None:
+def _train_data_parallel(workspace: Workspace, examples: typing.List[typing.List[Example]], *, replicas: int, sync_interval: int) -> Workspace:
     pass
-def _write_cache_header(workspace: Workspace, file: object) -> None:
+def _train_data_parallel_from_file(workspace: Workspace, path: str, *, format: _InputFormat, replicas: int, sync_interval: int) -> Workspace:
     pass
 __version__ = '0.7.0'
 _vw_commit = '9db1f5f'
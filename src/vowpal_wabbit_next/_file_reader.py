@@ -0,0 +1,44 @@
+import os
+import typing
+
+from vowpal_wabbit_next import _core, Example
+from vowpal_wabbit_next.labels import LabelType
+
+# Number of items fetched from the native reader per call, to amortize the cost of crossing into C++.
+_BATCH_SIZE = 64
+
+FileSource = typing.Union[str, "os.PathLike[typing.Any]", int]
+
+
+def _is_native_source(file: typing.Any) -> bool:
+    return isinstance(file, (str, os.PathLike, int))
+
+
+def _open_native_reader(
+    workspace: _core.Workspace, file: FileSource, format: _core._InputFormat
+) -> _core._FileReader:
+    source = file if isinstance(file, int) else os.fspath(file)
+    return _core._FileReader(workspace, source, format)
+
+
+def _iterate_native_reader(
+    reader: _core._FileReader, label_type: LabelType
+) -> typing.Iterator[typing.Union[Example, typing.List[Example]]]:
+    batch = reader._get_batch(_BATCH_SIZE)
+    while len(batch) != 0:
+        for item in batch:
+            if isinstance(item, list):
+                yield [
+                    Example(_existing_example=ex, _label_type=label_type) for ex in item
+                ]
+            else:
+                yield Example(_existing_example=item, _label_type=label_type)
+        batch = reader._get_batch(_BATCH_SIZE)
+
+
+def _non_blank_lines(file: typing.TextIO) -> typing.Iterator[str]:
+    # Lines without any content are skipped, the same as by the native reader.
+    for line in file:
+        stripped = line.rstrip()
+        if stripped:
+            yield stripped
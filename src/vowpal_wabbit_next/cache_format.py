@@ -1,6 +1,7 @@
+import os
 import typing
 
-from vowpal_wabbit_next import Example, Workspace, _core, TextFormatParser
+from vowpal_wabbit_next import Example, Workspace, _core
 from types import TracebackType
 
 CacheFormatReaderT = typing.TypeVar("CacheFormatReaderT", bound="CacheFormatReader")
@@ -9,9 +10,15 @@ T = typing.TypeVar("T")
 
 
 class CacheFormatReader:
-    def __init__(self, workspace: Workspace[T], file: typing.BinaryIO):
+    def __init__(
+        self,
+        workspace: Workspace[T],
+        file: typing.Union[typing.BinaryIO, str, "os.PathLike[typing.Any]"],
+    ):
         """Read VW examples in cache format from the given file.
 
+        If a path is given the file is memory mapped and read without going through Python file I/O. This also allows :py:meth:`~vowpal_wabbit_next.CacheFormatReader.seek` to jump to any example, for example to visit examples in a shuffled order on later passes.
+
         Examples:
             >>> from vowpal_wabbit_next import Workspace, TextFormatParser, CacheFormatWriter
             >>> workspace = Workspace()
@@ -23,11 +30,46 @@ class CacheFormatReader:
 
         Args:
             workspace (Workspace): Workspace object used to configure this reader
-            file (typing.BinaryIO): File to read from
+            file (typing.Union[typing.BinaryIO, str, os.PathLike[typing.Any]]): File or path to read from
         """
         self._workspace = workspace
-        self._file = file
-        self._reader = _core._CacheReader(self._workspace._workspace, self._file)
+        self._file: typing.Optional[typing.BinaryIO] = None
+        if isinstance(file, (str, os.PathLike)):
+            self._reader = _core._open_mapped_cache_reader(
+                self._workspace._workspace, os.fspath(file)
+            )
+        else:
+            self._file = file
+            self._reader = _core._CacheReader(self._workspace._workspace, self._file)
+
+    def tell(self) -> int:
+        """Get the offset in the file of the next example to be read. For multiline workspaces this is only an example boundary between iterations.
+
+        Returns:
+            int: Offset which can later be passed to :py:meth:`~vowpal_wabbit_next.CacheFormatReader.seek`
+        """
+        return self._reader._tell()
+
+    def seek(self, offset: int) -> None:
+        """Continue reading from the given offset, which must have been returned by :py:meth:`~vowpal_wabbit_next.CacheFormatReader.tell`. Iterating after seeking starts from this example.
+
+        Examples:
+            >>> from vowpal_wabbit_next import Workspace, CacheFormatReader
+            >>> workspace = Workspace()
+            >>> with CacheFormatReader(workspace, "data.cache") as reader:
+            ...     offsets = [reader.tell()]
+            ...     for example in reader:
+            ...         offsets.append(reader.tell())
+            ...     reader.seek(offsets[1])
+            ...     second_example = next(iter(reader))
+
+        Args:
+            offset (int): Offset of the example to read next
+
+        Raises:
+            RuntimeError: If this reader was not created from a path
+        """
+        self._reader._seek(offset)
 
     def __enter__(self: CacheFormatReaderT) -> CacheFormatReaderT:
         return self
@@ -38,7 +80,8 @@ class CacheFormatReader:
         exc_value: typing.Optional[BaseException],
         traceback: typing.Optional[TracebackType],
     ) -> None:
-        self._file.close()
+        if self._file is not None:
+            self._file.close()
 
     def __iter__(self) -> typing.Iterator[typing.Union[Example, typing.List[Example]]]:
         if self._workspace.multiline:
@@ -72,11 +115,20 @@ class CacheFormatReader:
 
 CacheFormatWriterT = typing.TypeVar("CacheFormatWriterT", bound="CacheFormatWriter")
 
+# Number of examples passed to the native writer per call by write_examples.
+_WRITE_CHUNK_SIZE = 1024
+
 
 class CacheFormatWriter:
-    def __init__(self, workspace: Workspace[T], file: typing.BinaryIO):
+    def __init__(
+        self,
+        workspace: Workspace[T],
+        file: typing.Union[typing.BinaryIO, str, "os.PathLike[typing.Any]"],
+    ):
         """Creates a VW cache file.
 
+        Examples are serialized into a native buffer which is written out at the end of each call. If a path is given the file is written directly without going through Python file I/O.
+
         Examples:
             >>> from vowpal_wabbit_next import Workspace, TextFormatParser, CacheFormatWriter
             >>> workspace = Workspace()
@@ -87,13 +139,17 @@ class CacheFormatWriter:
 
         Args:
             workspace (Workspace): Workspace object used to configure this writer.
-            file (typing.BinaryIO): File to write cache to
+            file (typing.Union[typing.BinaryIO, str, os.PathLike[typing.Any]]): File or path to write cache to
         """
         self._workspace = workspace
-        self._file = file
-        # TODO: workout a better way to handle this one...
-        self._newline_example = TextFormatParser(workspace).parse_line("")
-        _core._write_cache_header(self._workspace._workspace, self._file)
+        self._file: typing.Optional[typing.BinaryIO] = None
+        if isinstance(file, (str, os.PathLike)):
+            self._writer = _core._open_cache_file_writer(
+                self._workspace._workspace, os.fspath(file)
+            )
+        else:
+            self._file = file
+            self._writer = _core._CacheWriter(self._workspace._workspace, self._file)
 
     def __enter__(self: CacheFormatWriterT) -> CacheFormatWriterT:
         return self
@@ -104,7 +160,19 @@ class CacheFormatWriter:
         exc_value: typing.Optional[BaseException],
         traceback: typing.Optional[TracebackType],
     ) -> None:
-        self._file.close()
+        self.close()
+
+    def close(self) -> None:
+        """Write out the examples which are still buffered and close the file. This is called when the writer is used as a context manager. Without it a failure to write the end of the cache can't be reported.
+
+        Raises:
+            RuntimeError: If the cache could not be completely written
+        """
+        try:
+            self._writer.close()
+        finally:
+            if self._file is not None:
+                self._file.close()
 
     def write_example(
         self, example: typing.Union[Example, typing.List[Example]]
@@ -114,15 +182,38 @@ class CacheFormatWriter:
         Args:
             example (typing.Union[Example, typing.List[Example]]): Either a single or multiex to be written.
         """
-        if isinstance(example, list):
-            for e in example:
-                _core._write_cache_example(
-                    self._workspace._workspace, e._example, self._file
-                )
-            _core._write_cache_example(
-                self._workspace._workspace, self._newline_example._example, self._file
-            )
+        self.write_examples([example])
+
+    def write_examples(
+        self,
+        examples: typing.Iterable[typing.Union[Example, typing.List[Example]]],
+    ) -> None:
+        """Write many examples to the cache file. This is much faster than calling :py:meth:`~vowpal_wabbit_next.CacheFormatWriter.write_example` for each example as examples are passed to the native writer in chunks.
+
+        Examples:
+            >>> from vowpal_wabbit_next import Workspace, TextFormatReader, CacheFormatWriter
+            >>> workspace = Workspace()
+            >>> with TextFormatReader(workspace, "data.txt") as reader:
+            ...     with CacheFormatWriter(workspace, "data.cache") as writer:
+            ...         writer.write_examples(reader)
+
+        Args:
+            examples (typing.Iterable[typing.Union[Example, typing.List[Example]]]): Examples to write. Each item should be a list if the workspace is multiline.
+        """
+        chunk: typing.List[typing.Any] = []
+        for example in examples:
+            if isinstance(example, list):
+                chunk.append([ex._example for ex in example])
+            else:
+                chunk.append(example._example)
+            if len(chunk) == _WRITE_CHUNK_SIZE:
+                self._write_chunk(chunk)
+                chunk = []
+        if len(chunk) != 0:
+            self._write_chunk(chunk)
+
+    def _write_chunk(self, chunk: typing.List[typing.Any]) -> None:
+        if isinstance(chunk[0], list):
+            self._writer.write_many_multi_ex(chunk)
         else:
-            _core._write_cache_example(
-                self._workspace._workspace, example._example, self._file
-            )
+            self._writer.write_many(chunk)
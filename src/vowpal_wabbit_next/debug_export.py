@@ -0,0 +1,59 @@
+import os
+from typing import Any, Iterable, Union
+
+from vowpal_wabbit_next import _core
+from vowpal_wabbit_next.workspace import DebugNode
+
+
+def write_flamegraph(
+    trees: Iterable[DebugNode], file_path: Union[str, "os.PathLike[Any]"]
+) -> None:
+    """Write the time spent in each reduction across many debug trees as collapsed stacks, the input format of `flamegraph.pl <https://github.com/brendangregg/FlameGraph>`_, `speedscope <https://www.speedscope.app>`_ and similar tools.
+
+    Each line is a stack of `name(function)` frames separated by semicolons, such as `count_label(learn);scorer(learn);gd(learn)`, followed by the self time in nanoseconds of its last frame summed over all of the trees. The time spent recording the debug trees is not included. Since the stacks are aggregated they are written in alphabetical order, not in the order of the calls.
+
+    Examples:
+        >>> from vowpal_wabbit_next import Workspace, TextFormatParser
+        >>> import vowpal_wabbit_next as vw
+        >>> model = Workspace(enable_debug_tree=True)
+        >>> parser = TextFormatParser(model)
+        >>> trees = []
+        >>> for i in range(100):
+        ...     trees.extend(model.learn_one(parser.parse_line(f"{i % 2} | a b{i}")))
+        >>> vw.write_flamegraph(trees, "learn.folded")
+
+        The output can then be rendered with `flamegraph.pl learn.folded > learn.svg`.
+
+    Args:
+        trees (Iterable[DebugNode]): Root nodes of the debug trees, such as those returned by the learn and predict functions when `enable_debug_tree=True` was passed to the :py:class:`~vowpal_wabbit_next.Workspace` constructor, or by :py:meth:`~vowpal_wabbit_next.Workspace.sampled_debug_trees`.
+        file_path (Union[str, os.PathLike[Any]]): Path of the file to write.
+    """
+    output = _core._debug_trees_to_collapsed_stacks(list(trees))
+    with open(file_path, "w") as f:
+        f.write(output)
+
+
+def write_chrome_trace(
+    trees: Iterable[DebugNode], file_path: Union[str, "os.PathLike[Any]"]
+) -> None:
+    """Write debug trees as a timeline in the `trace event format <https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU>`_, which can be opened with `Perfetto <https://ui.perfetto.dev>`_ or `chrome://tracing`.
+
+    Every node becomes an event named after its reduction, with the function (learn or predict) as its category. Each tree starts at the time of its call relative to the first tree, so the trees should be given in the order they were produced. The time spent recording the debug trees is removed from within each tree, so the nodes show the duration the calls would have taken without it and the gaps between the trees include it.
+
+    Examples:
+        >>> from vowpal_wabbit_next import Workspace, TextFormatParser
+        >>> import vowpal_wabbit_next as vw
+        >>> model = Workspace(enable_debug_tree=True)
+        >>> parser = TextFormatParser(model)
+        >>> trees = []
+        >>> for i in range(100):
+        ...     trees.extend(model.learn_one(parser.parse_line(f"{i % 2} | a b{i}")))
+        >>> vw.write_chrome_trace(trees, "learn.json")
+
+    Args:
+        trees (Iterable[DebugNode]): Root nodes of the debug trees in the order they were produced, such as those returned by the learn and predict functions when `enable_debug_tree=True` was passed to the :py:class:`~vowpal_wabbit_next.Workspace` constructor, or by :py:meth:`~vowpal_wabbit_next.Workspace.sampled_debug_trees`.
+        file_path (Union[str, os.PathLike[Any]]): Path of the file to write.
+    """
+    output = _core._debug_trees_to_chrome_trace(list(trees))
+    with open(file_path, "w") as f:
+        f.write(output)
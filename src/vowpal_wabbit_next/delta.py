@@ -1,12 +1,17 @@
+import os
 import sys
-from typing import List, Optional, TypeVar
+from typing import Any, BinaryIO, List, Optional, TypeVar, Union
 
 if sys.version_info >= (3, 8):
     from typing import Literal
 else:
     from typing_extensions import Literal
 
-from vowpal_wabbit_next import _core, Workspace
+import numpy as np
+import numpy.typing as npt
+
+from vowpal_wabbit_next import _core, Example, Workspace
+from vowpal_wabbit_next.workspace import _get_input_format
 
 
 class ModelDelta:
@@ -35,6 +40,133 @@ class ModelDelta:
         return self._model_delta.serialize()
 
 
+class SparseModelDelta:
+    def __init__(self, *, _existing_sparse_delta: _core.SparseModelDelta):
+        """The difference between the weights of two VW models, holding only the weights which changed.
+
+        Unlike :py:class:`~vowpal_wabbit_next.ModelDelta` the cost of merging and applying a sparse delta scales with the number of changed weights instead of the size of the model. Only the weights are included, not the rest of the model state such as the statistics reported by the model. Only models with dense weights are supported.
+
+        The standard way to create one is with :py:func:`vowpal_wabbit_next.calculate_sparse_delta`.
+
+        Args:
+            _existing_sparse_delta (_core.SparseModelDelta): This is an internal parameter and should not be used by end users.
+        """
+        self._sparse_delta = _existing_sparse_delta
+
+    def __len__(self) -> int:
+        """Number of weights which changed."""
+        return len(self._sparse_delta)
+
+    @property
+    def indices(self) -> npt.NDArray[np.uint64]:
+        """Indices of the changed weights in ascending order, as used to index the first dimension of :py:meth:`~vowpal_wabbit_next.Workspace.weights`. This is a read only view of the delta."""
+        return self._sparse_delta.indices
+
+    @property
+    def values(self) -> npt.NDArray[np.float32]:
+        """Change in each weight and its learning state, with one row per index. This is a read only view of the delta."""
+        return self._sparse_delta.values
+
+    @property
+    def weighted_examples(self) -> float:
+        """Sum of the weights of the labeled examples this delta was learned from."""
+        return self._sparse_delta.weighted_examples
+
+    def serialize(
+        self,
+        *,
+        precision: Literal["float32", "float16", "int8"] = "float32",
+        compress: bool = False,
+    ) -> bytes:
+        """Serialize the delta in a compact encoding whose size scales with the number of changed weights rather than the size of the model.
+
+        The indices are stored as the varint encoded gaps between them, which usually takes one or two bytes per weight. The values can be rounded to a lower precision, which is applied to every value including the learning state, and the encoding can be compressed with zlib.
+
+        Examples:
+            >>> from vowpal_wabbit_next import Workspace, TextFormatParser, SparseModelDelta
+            >>> import vowpal_wabbit_next as vw
+            >>> base = Workspace()
+            >>> derived = Workspace(model_data=base.serialize())
+            >>> derived.learn_one(TextFormatParser(derived).parse_line("1 | a b"))
+            >>> data = vw.calculate_sparse_delta(base, derived).serialize(precision="float16")
+            >>> len(SparseModelDelta.deserialize(data))
+            3
+
+        Args:
+            precision (Literal["float32", "float16", "int8"]): Precision the values are stored in. `float16` halves the size of the values and `int8` quarters it, at the cost of accuracy. `float16` can't represent magnitudes above 65504, which an adaptive learning state can exceed after many updates. `int8` values are scaled per block of 64 values.
+            compress (bool): Whether to compress the encoding with zlib.
+
+        Returns:
+            bytes: The serialized delta.
+        """
+        return self._sparse_delta.serialize(
+            precision=_get_weight_precision(precision), compress=compress
+        )
+
+    def serialize_to(
+        self,
+        file: Union[BinaryIO, str, "os.PathLike[Any]"],
+        *,
+        precision: Literal["float32", "float16", "int8"] = "float32",
+        compress: bool = False,
+    ) -> None:
+        """Serialize the delta to a path or binary file object, such as a socket file. The encoding is written in chunks as it is produced. See :py:meth:`~vowpal_wabbit_next.SparseModelDelta.serialize`.
+
+        Args:
+            file (Union[BinaryIO, str, os.PathLike[Any]]): Path or binary file object to write the delta to.
+            precision (Literal["float32", "float16", "int8"]): Precision the values are stored in.
+            compress (bool): Whether to compress the encoding with zlib.
+        """
+        if isinstance(file, (str, os.PathLike)):
+            with open(file, "wb") as f:
+                self.serialize_to(f, precision=precision, compress=compress)
+            return
+        self._sparse_delta.serialize_to(
+            file, precision=_get_weight_precision(precision), compress=compress
+        )
+
+    @staticmethod
+    def deserialize(
+        data: Union[bytes, BinaryIO, str, "os.PathLike[Any]"]
+    ) -> "SparseModelDelta":
+        """Load a delta written by :py:meth:`~vowpal_wabbit_next.SparseModelDelta.serialize` or :py:meth:`~vowpal_wabbit_next.SparseModelDelta.serialize_to`.
+
+        Paths and file objects are decoded as they are read, so the encoded delta is never held in memory in full. A file object is read in chunks and may be read past the end of the delta.
+
+        Args:
+            data (Union[bytes, BinaryIO, str, os.PathLike[Any]]): The serialized delta, or a path or binary file object to read it from.
+
+        Raises:
+            ValueError: If the data is not a valid serialized delta.
+
+        Returns:
+            SparseModelDelta: The loaded delta.
+        """
+        if isinstance(data, (bytes, bytearray, memoryview)):
+            return SparseModelDelta(
+                _existing_sparse_delta=_core.SparseModelDelta.deserialize(bytes(data))
+            )
+        if isinstance(data, (str, os.PathLike)):
+            with open(data, "rb") as f:
+                return SparseModelDelta.deserialize(f)
+        return SparseModelDelta(
+            _existing_sparse_delta=_core.SparseModelDelta.deserialize_from(data)
+        )
+
+
+def _get_weight_precision(
+    precision: Literal["float32", "float16", "int8"]
+) -> _core._WeightPrecision:
+    weight_precision = {
+        "float32": _core._WeightPrecision.Float32,
+        "float16": _core._WeightPrecision.Float16,
+        "int8": _core._WeightPrecision.Int8,
+    }.get(precision)
+    if weight_precision is None:
+        raise ValueError(f"Unknown precision: {precision}")
+    return weight_precision
+
+
 T = TypeVar("T")
 
 
@@ -88,3 +220,125 @@ def merge_deltas(deltas: List[ModelDelta]) -> ModelDelta:
         bytes(),
         _existing_model_delta=_core._merge_deltas([x._model_delta for x in deltas]),
     )
+
+
+def calculate_sparse_delta(
+    base_model: Workspace[T],
+    derived_model: Workspace[T],
+    *,
+    num_threads: Optional[int] = None,
+) -> SparseModelDelta:
+    """Produce a sparse delta between the weights of two existing models. Both models must use the same number of bits and reductions.
+
+    Examples:
+        >>> from vowpal_wabbit_next import Workspace, TextFormatParser
+        >>> import vowpal_wabbit_next as vw
+        >>> base = Workspace()
+        >>> derived = Workspace(model_data=base.serialize())
+        >>> derived.learn_one(TextFormatParser(derived).parse_line("1 | a b"))
+        >>> delta = vw.calculate_sparse_delta(base, derived)
+        >>> len(delta)
+        3
+
+    Args:
+        base_model (Workspace): The base of the model
+        derived_model (Workspace): The model produced from further training of base_model
+        num_threads (Optional[int]): Number of threads to compare the weights with. Defaults to one per core.
+
+    Returns:
+        SparseModelDelta: The weights which changed and by how much.
+    """
+    return SparseModelDelta(
+        _existing_sparse_delta=_core._calculate_sparse_delta(
+            base_model._workspace,
+            derived_model._workspace,
+            num_threads=num_threads or 0,
+        )
+    )
+
+
+def merge_sparse_deltas(
+    deltas: List[SparseModelDelta], *, num_threads: Optional[int] = None
+) -> SparseModelDelta:
+    """Merge a list of sparse deltas into a single delta, weighting the weights of each as :py:func:`~vowpal_wabbit_next.merge_deltas` does.
+
+    Args:
+        deltas (List[SparseModelDelta]): The deltas to merge. All deltas should come from the same base model.
+        num_threads (Optional[int]): Number of threads to merge with. Defaults to one per core.
+
+    Returns:
+        SparseModelDelta: The merged delta.
+    """
+    return SparseModelDelta(
+        _existing_sparse_delta=_core._merge_sparse_deltas(
+            [x._sparse_delta for x in deltas], num_threads=num_threads or 0
+        )
+    )
+
+
+def apply_delta_inplace(model: Workspace[T], delta: SparseModelDelta) -> None:
+    """Add a sparse delta to the weights of a model in place, rather than creating a new model as :py:func:`~vowpal_wabbit_next.apply_delta` does.
+
+    Args:
+        model (Workspace): The model to apply the delta to. It must use the same number of bits and reductions as the models the delta was calculated from.
+        delta (SparseModelDelta): The delta to apply
+    """
+    _core._apply_delta_inplace(model._workspace, delta._sparse_delta)
+
+
+def train_data_parallel(
+    model: Workspace[T],
+    examples: Union[List[Example], List[List[Example]], str, "os.PathLike[Any]"],
+    *,
+    replicas: Optional[int] = None,
+    sync_interval: int = 10000,
+    format: Literal["text", "dsjson", "json", "cache"] = "text",
+) -> Workspace[Literal[False]]:
+    """Train copies of a model on several threads and periodically merge them, producing a new model. The given model is not modified.
+
+    The examples are learned in rounds of `sync_interval` examples. Each replica learns from an interleaved shard of the round on its own thread. At the end of each round the changes to the weights of the replicas are merged as :py:func:`~vowpal_wabbit_next.merge_sparse_deltas` does, and the merged weights are copied into every replica for the next round. The rest of the state of the replicas, such as the number of examples each has seen, is merged as :py:func:`~vowpal_wabbit_next.merge_deltas` does once all rounds are done.
+
+    Unlike :py:meth:`~vowpal_wabbit_next.Workspace.learn_parallel` no weights are shared between threads, so any model whose reductions VW can merge is supported, including contextual bandit models such as `--cb_explore_adf` and `--ccb_explore_adf`. The replicas are created once, and a round only copies the weights which changed, so `sync_interval` can be small. Dense weights are required. This is not supported if `enable_debug_tree=True` was passed in the constructor.
+
+    Examples:
+        >>> from vowpal_wabbit_next import Workspace, TextFormatParser
+        >>> import vowpal_wabbit_next as vw
+        >>> model = Workspace(["--cb_explore_adf"])
+        >>> parser = TextFormatParser(model)
+        >>> examples = [[parser.parse_line("shared | s"), parser.parse_line(f"0:{i % 2}:0.5 | a{i}")] for i in range(100)]
+        >>> trained = vw.train_data_parallel(model, examples, replicas=4, sync_interval=20)
+
+    Args:
+        model (Workspace): The model to start from.
+        examples (Union[List[Example], List[List[Example]], str, os.PathLike[Any]]): Examples to learn on, each of which may only appear once, or the path of a file to read them from. If the model is :py:meth:`vowpal_wabbit_next.Workspace.multiline` then each item is a list of examples. Files ending in `.gz` are decompressed.
+        replicas (Optional[int]): Number of replicas, each of which learns on its own thread. Defaults to one per core.
+        sync_interval (int): Number of examples, or multiline examples, learned by all replicas together between merges.
+        format (Literal["text", "dsjson", "json", "cache"]): Format of the file, if examples is a path.
+
+    Returns:
+        Workspace: The merged model after learning from every example.
+    """
+    num_replicas = replicas if replicas is not None else (os.cpu_count() or 1)
+    if isinstance(examples, (str, os.PathLike)):
+        trained = _core._train_data_parallel_from_file(
+            model._workspace,
+            os.fspath(examples),
+            format=_get_input_format(format),
+            replicas=num_replicas,
+            sync_interval=sync_interval,
+        )
+    else:
+        groups: List[List[_core.Example]] = []
+        for item in examples:
+            model._check_label(item)
+            if isinstance(item, list):
+                groups.append([ex._example for ex in item])
+            else:
+                groups.append([item._example])
+        trained = _core._train_data_parallel(
+            model._workspace,
+            groups,
+            replicas=num_replicas,
+            sync_interval=sync_interval,
+        )
+    return Workspace(_existing_workspace=trained)
@@ -1,6 +1,13 @@
 import typing
 
 from vowpal_wabbit_next import _core, Workspace, Example
+from vowpal_wabbit_next._file_reader import (
+    FileSource,
+    _is_native_source,
+    _iterate_native_reader,
+    _non_blank_lines,
+    _open_native_reader,
+)
 from types import TracebackType
 
 T = typing.TypeVar("T")
@@ -57,7 +64,9 @@ JsonFormatReaderT = typing.TypeVar("JsonFormatReaderT", bound="JsonFormatReader"
 
 # takes a file and uses a context manager to generate based on the contents of the file
 class JsonFormatReader:
-    def __init__(self, workspace: Workspace[T], file: typing.TextIO):
+    def __init__(
+        self, workspace: Workspace[T], file: typing.Union[typing.TextIO, FileSource]
+    ):
         """Read VW Json format examples from the given text file. This reader always produces lists of examples.
 
         Examples:
@@ -71,11 +80,20 @@ class JsonFormatReader:
 
         Args:
             workspace (Workspace): Workspace object used to configure this reader
-            file (typing.BinaryIO): File to read from
+            file (typing.Union[typing.TextIO, str, os.PathLike, int]): File to read from. If a path or file descriptor is given the file is read and split into lines natively, which is faster than iterating a Python file object. Paths ending in `.gz` are decompressed.
         """
         self._parser = JsonFormatParser(workspace)
         self._workspace = workspace
-        self._file = file
+        self._file: typing.Optional[typing.TextIO] = None
+        self._native_reader: typing.Optional[_core._FileReader] = None
+        if _is_native_source(file):
+            self._native_reader = _open_native_reader(
+                workspace._workspace,
+                typing.cast(FileSource, file),
+                _core._InputFormat.Json,
+            )
+        else:
+            self._file = typing.cast(typing.TextIO, file)
         if not self._workspace.multiline:
             raise ValueError("Must use a multiline Workspace for json format")
 
@@ -88,9 +106,17 @@ class JsonFormatReader:
         exc_value: typing.Optional[BaseException],
         traceback: typing.Optional[TracebackType],
     ) -> None:
-        self._file.close()
+        if self._file is not None:
+            self._file.close()
 
     def __iter__(self) -> typing.Iterator[typing.Union[Example, typing.List[Example]]]:
+        if self._native_reader is not None:
+            yield from _iterate_native_reader(
+                self._native_reader, self._workspace.label_type
+            )
+            return
+
+        assert self._file is not None
         if self._workspace.multiline:
-            for line in self._file:
-                yield self._parser.parse_json(line.rstrip())
+            for line in _non_blank_lines(self._file):
+                yield self._parser.parse_json(line)
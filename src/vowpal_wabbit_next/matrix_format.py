@@ -0,0 +1,112 @@
+import typing
+
+import numpy as np
+import numpy.typing as npt
+
+from vowpal_wabbit_next import _core, Workspace, Example
+from vowpal_wabbit_next.labels import LabelType
+
+T = typing.TypeVar("T")
+
+
+class MatrixFormatParser:
+    def __init__(
+        self,
+        workspace: Workspace[T],
+        *,
+        namespace: str = " ",
+        hash_columns: bool = False,
+    ):
+        """Create examples from the rows of a NumPy array or CSR matrix. Each row becomes one example with a feature per non zero entry, all in a single namespace. The whole matrix is converted in a single call without building features from Python.
+
+        Args:
+            workspace (Workspace): Workspace object used to configure this parser
+            namespace (str): Name of the namespace the features are placed in. As in the text format, the namespace is identified by its first character.
+            hash_columns (bool): If True, each column id is hashed as if it were a feature name in the text format, so row `i` of a matrix is equivalent to the text `| 0:x[i, 0] 1:x[i, 1] ...`. Otherwise column ids are used as feature indices as is, which is useful if they have already been hashed.
+        """
+        self._workspace = workspace
+        self._namespace = namespace
+        self._hash_columns = hash_columns
+
+    def _wrap(
+        self,
+        examples: typing.List[_core.Example],
+        labels: typing.Optional[npt.ArrayLike],
+    ) -> typing.List[Example]:
+        label_type = (
+            LabelType.Simple if labels is not None else self._workspace.label_type
+        )
+        return [
+            Example(_existing_example=ex, _label_type=label_type) for ex in examples
+        ]
+
+    def parse_csr(
+        self,
+        indptr: npt.ArrayLike,
+        indices: npt.ArrayLike,
+        data: npt.ArrayLike,
+        *,
+        labels: typing.Optional[npt.ArrayLike] = None,
+    ) -> typing.List[Example]:
+        """Create an example for each row of a matrix in compressed sparse row format. The arguments correspond to the attributes of a `scipy.sparse.csr_matrix`, the features of row `i` are `indices[indptr[i]:indptr[i+1]]` and `data[indptr[i]:indptr[i+1]]`.
+
+        Examples:
+            >>> from vowpal_wabbit_next import Workspace, MatrixFormatParser
+            >>> import scipy.sparse
+            >>> workspace = Workspace()
+            >>> parser = MatrixFormatParser(workspace, hash_columns=True)
+            >>> matrix = scipy.sparse.csr_matrix([[1.0, 0.0, 2.0], [0.0, 3.0, 0.0]])
+            >>> examples = parser.parse_csr(matrix.indptr, matrix.indices, matrix.data, labels=[1.0, 0.0])
+            >>> workspace.learn_batch(examples)
+
+        Args:
+            indptr (npt.ArrayLike): Offsets of the start of each row into `indices` and `data`, with a final element equal to their length.
+            indices (npt.ArrayLike): Column id of each stored value. Must not be negative.
+            data (npt.ArrayLike): Stored values. Zeros are skipped.
+            labels (Optional[npt.ArrayLike]): Simple label of each row. Only supported if the workspace uses :py:attr:`~vowpal_wabbit_next.LabelType.Simple` labels. If not given the examples are unlabeled.
+
+        Returns:
+            List[Example]: One example per row
+        """
+        examples = _core._parse_csr(
+            self._workspace._workspace,
+            np.asarray(indptr),
+            np.asarray(indices),
+            np.asarray(data),
+            labels=None if labels is None else np.asarray(labels),
+            namespace_name=self._namespace,
+            hash_columns=self._hash_columns,
+        )
+        return self._wrap(examples, labels)
+
+    def parse_dense(
+        self,
+        matrix: npt.ArrayLike,
+        *,
+        labels: typing.Optional[npt.ArrayLike] = None,
+    ) -> typing.List[Example]:
+        """Create an example for each row of a 2-dimensional array. The column id of each value is its position in the row.
+
+        Examples:
+            >>> from vowpal_wabbit_next import Workspace, MatrixFormatParser
+            >>> import numpy as np
+            >>> workspace = Workspace()
+            >>> parser = MatrixFormatParser(workspace)
+            >>> examples = parser.parse_dense(np.array([[1.0, 0.0, 2.0], [0.0, 3.0, 0.0]]), labels=[1.0, 0.0])
+            >>> workspace.learn_batch(examples)
+
+        Args:
+            matrix (npt.ArrayLike): 2-dimensional array with one row per example. Zeros are skipped.
+            labels (Optional[npt.ArrayLike]): Simple label of each row. Only supported if the workspace uses :py:attr:`~vowpal_wabbit_next.LabelType.Simple` labels. If not given the examples are unlabeled.
+
+        Returns:
+            List[Example]: One example per row
+        """
+        examples = _core._parse_dense(
+            self._workspace._workspace,
+            np.asarray(matrix),
+            labels=None if labels is None else np.asarray(labels),
+            namespace_name=self._namespace,
+            hash_columns=self._hash_columns,
+        )
+        return self._wrap(examples, labels)
@@ -1,6 +1,12 @@
 import typing
 
 from vowpal_wabbit_next import _core, Workspace, Example
+from vowpal_wabbit_next._file_reader import (
+    FileSource,
+    _is_native_source,
+    _iterate_native_reader,
+    _open_native_reader,
+)
 from types import TracebackType
 
 T = typing.TypeVar("T")
@@ -41,7 +47,9 @@ TextFormatReaderT = typing.TypeVar("TextFormatReaderT", bound="TextFormatReader"
 
 # takes a file and uses a context manager to generate based on the contents of the file
 class TextFormatReader:
-    def __init__(self, workspace: Workspace[T], file: typing.TextIO):
+    def __init__(
+        self, workspace: Workspace[T], file: typing.Union[typing.TextIO, FileSource]
+    ):
         """Read VW text format examples from the given text file. This reader produces either single Examples or List[Example] based on if the given workspace is multiline or not.
 
         Examples:
@@ -55,11 +63,20 @@ class TextFormatReader:
 
         Args:
             workspace (Workspace): Workspace object used to configure this reader
-            file (typing.BinaryIO): File to read from
+            file (typing.Union[typing.TextIO, str, os.PathLike, int]): File to read from. If a path or file descriptor is given the file is read and split into lines natively, which is faster than iterating a Python file object. Paths ending in `.gz` are decompressed.
         """
         self._parser = TextFormatParser(workspace)
         self._workspace = workspace
-        self._file = file
+        self._file: typing.Optional[typing.TextIO] = None
+        self._native_reader: typing.Optional[_core._FileReader] = None
+        if _is_native_source(file):
+            self._native_reader = _open_native_reader(
+                workspace._workspace,
+                typing.cast(FileSource, file),
+                _core._InputFormat.Text,
+            )
+        else:
+            self._file = typing.cast(typing.TextIO, file)
 
     def __enter__(self: TextFormatReaderT) -> TextFormatReaderT:
         return self
@@ -70,9 +87,17 @@ class TextFormatReader:
         exc_value: typing.Optional[BaseException],
         traceback: typing.Optional[TracebackType],
     ) -> None:
-        self._file.close()
+        if self._file is not None:
+            self._file.close()
 
     def __iter__(self) -> typing.Iterator[typing.Union[Example, typing.List[Example]]]:
+        if self._native_reader is not None:
+            yield from _iterate_native_reader(
+                self._native_reader, self._workspace.label_type
+            )
+            return
+
+        assert self._file is not None
         if self._workspace.multiline:
             so_far: typing.List[Example] = []
             # parse until we find a newline example
@@ -1,9 +1,12 @@
 from __future__ import annotations
+import concurrent.futures
 import os
 import sys
+import threading
 
 from typing import (
     Any,
+    BinaryIO,
     Dict,
     List,
     Optional,
@@ -52,13 +55,65 @@ Prediction = Union[
     NoPrediction,
 ]
 
+BatchPrediction = Union[
+    npt.NDArray[np.float32],
+    npt.NDArray[np.uint32],
+    Tuple[npt.NDArray[np.int64], npt.NDArray[np.float32]],
+    Tuple[npt.NDArray[np.int64], npt.NDArray[np.uint32], npt.NDArray[np.float32]],
+]
+
+NumpyPrediction = Union[
+    npt.NDArray[np.float32],
+    npt.NDArray[np.uint32],
+    npt.NDArray[np.void],
+    Tuple[npt.NDArray[np.int64], npt.NDArray[np.void]],
+]
+
 MetricsDict = Dict[str, Union[int, float, str, bool, "MetricsDict"]]
 
 DebugNode = _core.DebugNode
 
+DebugTreeField = Literal[
+    "input_labels",
+    "output_prediction",
+    "interactions",
+    "weight",
+    "offset",
+    "partial_prediction",
+    "updated_prediction",
+]
+
 IsDebugT = TypeVar("IsDebugT")
 
 
+def _flatten_examples(
+    examples: Union[Example, List[Example], List[List[Example]]]
+) -> List[_core.Example]:
+    if isinstance(examples, Example):
+        return [examples._example]
+    result: List[_core.Example] = []
+    for item in examples:
+        if isinstance(item, list):
+            result.extend(ex._example for ex in item)
+        else:
+            result.append(item._example)
+    return result
+
+
+def _get_input_format(
+    format: Literal["text", "dsjson", "json", "cache"]
+) -> _core._InputFormat:
+    input_format = {
+        "text": _core._InputFormat.Text,
+        "dsjson": _core._InputFormat.DSJson,
+        "json": _core._InputFormat.Json,
+        "cache": _core._InputFormat.Cache,
+    }.get(format)
+    if input_format is None:
+        raise ValueError(f"Unknown format: {format}")
+    return input_format
+
+
 class Workspace(Generic[IsDebugT]):
     @overload
     def __init__(
@@ -66,9 +121,16 @@ class Workspace(Generic[IsDebugT]):
         args: List[str] = [],
         *,
         model_data: Optional[bytes] = None,
+        model_file: Optional[Union[BinaryIO, str, os.PathLike[Any]]] = None,
         record_feature_names: bool = False,
         record_metrics: bool = False,
+        record_counters: bool = False,
         enable_debug_tree: Literal[False] = False,
+        enable_profiling: bool = False,
+        debug_sample_every: Optional[int] = None,
+        debug_sample_probability: Optional[float] = None,
+        debug_sample_buffer_size: int = 100,
+        debug_tree_fields: Optional[List[DebugTreeField]] = None,
     ):
         ...
 
@@ -78,9 +140,13 @@ class Workspace(Generic[IsDebugT]):
         args: List[str] = [],
         *,
         model_data: Optional[bytes] = None,
+        model_file: Optional[Union[BinaryIO, str, os.PathLike[Any]]] = None,
         record_feature_names: bool = False,
         record_metrics: bool = False,
+        record_counters: bool = False,
         enable_debug_tree: Literal[True] = True,
+        enable_profiling: Literal[False] = False,
+        debug_tree_fields: Optional[List[DebugTreeField]] = None,
     ):
         ...
 
@@ -97,9 +163,16 @@ class Workspace(Generic[IsDebugT]):
         args: List[str] = [],
         *,
         model_data: Optional[bytes] = None,
+        model_file: Optional[Union[BinaryIO, str, os.PathLike[Any]]] = None,
         record_feature_names: bool = False,
         record_metrics: bool = False,
+        record_counters: bool = False,
         enable_debug_tree: bool = False,
+        enable_profiling: bool = False,
+        debug_sample_every: Optional[int] = None,
+        debug_sample_probability: Optional[float] = None,
+        debug_sample_buffer_size: int = 100,
+        debug_tree_fields: Optional[List[DebugTreeField]] = None,
         _existing_workspace: Optional[_core.Workspace] = None,
     ):
         """Main object used for making predictions and training a model.
@@ -110,13 +183,13 @@ class Workspace(Generic[IsDebugT]):
 
         See the logging example below.
 
+        Learn and predict calls release the GIL while the reduction stack runs, so separate Workspaces can be used from multiple Python threads to use multiple cores. Calls into a single Workspace which run the reduction stack or read the model are serialized. Predictions of a frozen Workspace, see :py:meth:`~vowpal_wabbit_next.Workspace.freeze`, and reading statistics such as :py:meth:`~vowpal_wabbit_next.Workspace.read_counters` and :py:attr:`~vowpal_wabbit_next.Workspace.checkpoint_stats` do not wait for other calls. An Example must not be passed to two calls at the same time.
+
         Examples:
             Load a model from a file:
 
             >>> from vowpal_wabbit_next import Workspace
-            >>> with open("model.bin", "rb") as f:
-            ...     model_data = f.read()
-            >>> workspace = Workspace(model_data=model_data)
+            >>> workspace = Workspace(model_file="model.bin")
 
             Create a workspace for training a contextual bandit with action dependent features model:
 
@@ -135,24 +208,43 @@ class Workspace(Generic[IsDebugT]):
             args (List[str]): VowpalWabbit command line options for configuring the model. An overall list can be found `here <https://vowpalwabbit.org/docs/vowpal_wabbit/python/latest/command_line_args.html>`_. Options which affect the driver are not supported. For example:
                 `--sort_features`, `--ngram`, `--feature_limit`, `--ignore`, `--extra_metrics`, `--dump_json_weights_experimental`
             model_data (Optional[bytes], optional): Bytes of a VW model to be loaded.
+            model_file (Optional[Union[BinaryIO, str, os.PathLike[Any]]], optional): Path or binary file object to load a VW model from. The model is deserialized as it is read, without reading the whole file into memory first. Paths ending in `.gz` are decompressed, and a compressed file object can be read with :py:func:`gzip.open`. Only one of `model_data` and `model_file` can be given.
             record_feature_names (bool, optional): If true, the invert hash will be recorded for each example. This is required to use :py:meth:`vowpal_wabbit_next.Workspace.json_weights`. This will slow down parsing and learn/predict.
             record_metrics (bool, optional): If true, reduction metrics will be enabled and can be fetched with :py:attr:`vowpal_wabbit_next.Workspace.metrics`
+            record_counters (bool, optional): If true, the examples learned from and predicted on, their features, the lines which failed to parse and the latency of each call are counted, see :py:meth:`~vowpal_wabbit_next.Workspace.read_counters`. Unlike `record_metrics` the counters are cheap to update and can be read at any time without allocating, so they are suited to being scraped by a monitoring system.
             enable_debug_tree (bool, optional): If true, debug information in the form of the computation tree will be emitted by :py:meth:`~vowpal_wabbit_next.learn_one`, :py:meth:`~vowpal_wabbit_next.predict_one` and :py:meth:`~vowpal_wabbit_next.predict_then_learn_one`. This will affect performance negatively. See :py:class:`~vowpal_wabbit_next.DebugNode` for more information.
 
                     .. warning::
                         This is an experimental feature.
 
+            enable_profiling (bool, optional): If true, the time spent in each reduction is recorded, see :py:attr:`~vowpal_wabbit_next.Workspace.reduction_profile`. Unlike the debug tree this only counts calls and their time, which costs little enough to leave enabled in production. Can't be combined with `enable_debug_tree`.
+            debug_sample_every (Optional[int], optional): If given, the debug tree is captured for every nth call into the reduction stack and kept for :py:meth:`~vowpal_wabbit_next.Workspace.sampled_debug_trees`, rather than returned by each call. Calls which are not captured skip the work of building the tree. Can't be combined with `enable_debug_tree`, `enable_profiling` or `debug_sample_probability`.
+            debug_sample_probability (Optional[float], optional): If given, as `debug_sample_every` but each call is captured with this probability.
+            debug_sample_buffer_size (int, optional): Number of the most recently captured debug trees which are kept when sampling.
+            debug_tree_fields (Optional[List[DebugTreeField]], optional): The example fields to record in each :py:class:`~vowpal_wabbit_next.DebugNode`, out of "input_labels", "output_prediction", "interactions", "weight", "offset", "partial_prediction" and "updated_prediction". The fields which are not recorded are None. Copying the labels and predictions is most of the cost of the debug tree, so recording only the fields which are needed keeps the timings of the tree closer to those of the model without it. Defaults to all of them. Requires `enable_debug_tree`, `debug_sample_every` or `debug_sample_probability`.
             _existing_workspace (Optional[_core.Workspace], optional): This is for internal usage and should not be set by a user.
         """
         if _existing_workspace is not None:
             self._workspace = _existing_workspace
         else:
+            model_path: Optional[str] = None
+            if isinstance(model_file, (str, os.PathLike)):
+                model_path = os.fspath(model_file)
+                model_file = None
             self._workspace = _core.Workspace(
                 args,
                 model_data=model_data,
+                model_path=model_path,
+                model_file=model_file,
                 record_feature_names=record_feature_names,
                 record_metrics=record_metrics,
+                record_counters=record_counters,
                 debug=enable_debug_tree,
+                profile=enable_profiling,
+                debug_sample_every=debug_sample_every,
+                debug_sample_probability=debug_sample_probability,
+                debug_sample_buffer_size=debug_sample_buffer_size,
+                debug_tree_fields=debug_tree_fields,
             )
 
     def _check_label(self, example: Union[Example, List[Example]]) -> None:
@@ -206,6 +298,58 @@ class Workspace(Generic[IsDebugT]):
         else:
             return self._workspace.predict_multi_ex_one([ex._example for ex in example])
 
+    def predict_one_numpy(
+        self,
+        example: Union[Example, List[Example]],
+        *,
+        out: Optional[npt.NDArray[Any]] = None,
+    ) -> NumpyPrediction:
+        """Make a single prediction and return it as a NumPy array rather than Python objects. This avoids creating a Python object per value for predictions such as action scores.
+
+        The layout of the result depends on the :py:meth:`~vowpal_wabbit_next.Workspace.prediction_type` of the model:
+
+        * `Scalar` and `Prob` - A float32 array with one element.
+        * `Multiclass` - A uint32 array with one element.
+        * `Scalars` - A float32 array.
+        * `Multilabels` - A uint32 array.
+        * `ActionScores` and `ActionProbs` - A structured array with the fields `action` (uint32) and `score` (float32).
+        * `Pdf` - A structured array with the fields `left`, `right` and `pdf_value` (all float32).
+        * `DecisionProbs` - A tuple of `(offsets, action_scores)` where `action_scores` is a structured array as above. The action scores for slot `i` are `action_scores[offsets[i]:offsets[i+1]]`.
+
+        Other prediction types are not supported. This is not supported if `enable_debug_tree=True` was passed in the constructor.
+
+        Examples:
+            >>> from vowpal_wabbit_next import Workspace, TextFormatParser
+            >>> import numpy as np
+            >>> workspace = Workspace(["--cb_explore_adf"])
+            >>> parser = TextFormatParser(workspace)
+            >>> buffer = np.empty(16, dtype=[("action", np.uint32), ("score", np.float32)])
+            >>> scores = workspace.predict_one_numpy([parser.parse_line("| a"), parser.parse_line("| b")], out=buffer)
+            >>> scores["action"]
+            array([0, 1], dtype=uint32)
+
+        Args:
+            example (Union[Example, List[Example]]): Example to use for prediction. This should be a list if this workspace is :py:meth:`vowpal_wabbit_next.Workspace.multiline`, otherwise it is should be a single Example
+            out (Optional[npt.NDArray[Any]]): Contiguous 1-dimensional array with the dtype of the result to write the prediction into, so that it can be reused across calls. It must be at least as long as the prediction. If given, the result is a view of the start of this array. Not supported for `DecisionProbs`.
+
+        Returns:
+            NumpyPrediction: Prediction produced by this example, see above for the layout.
+        """
+        self._check_label(example)
+
+        if isinstance(example, Example):
+            return cast(
+                NumpyPrediction,
+                self._workspace.predict_one_numpy(example._example, out=out),
+            )
+        else:
+            return cast(
+                NumpyPrediction,
+                self._workspace.predict_multi_ex_one_numpy(
+                    [ex._example for ex in example], out=out
+                ),
+            )
+
     @overload
     def learn_one(
         self: Workspace[Literal[True]], example: Union[Example, List[Example]]
@@ -283,10 +427,254 @@ class Workspace(Generic[IsDebugT]):
                 [ex._example for ex in example]
             )
 
+    def learn_batch(self, examples: Union[List[Example], List[List[Example]]]) -> None:
+        """Learn from a list of examples in a single call. This is equivalent to calling :py:meth:`~vowpal_wabbit_next.Workspace.learn_one` on each example in order, but avoids crossing from Python into the library for each example.
+
+        This is not supported if `enable_debug_tree=True` was passed in the constructor.
+
+        Examples:
+            >>> from vowpal_wabbit_next import Workspace, TextFormatParser
+            >>> workspace = Workspace()
+            >>> parser = TextFormatParser(workspace)
+            >>> workspace.learn_batch([parser.parse_line("1 | a"), parser.parse_line("0 | b")])
+
+        Args:
+            examples (Union[List[Example], List[List[Example]]]): Examples to learn on. If this workspace is :py:meth:`vowpal_wabbit_next.Workspace.multiline` then each item is a list of examples.
+        """
+        for example in examples:
+            self._check_label(example)
+
+        if self.multiline:
+            self._workspace.learn_multi_ex_batch(
+                [
+                    [ex._example for ex in multi_ex]
+                    for multi_ex in cast(List[List[Example]], examples)
+                ]
+            )
+        else:
+            self._workspace.learn_batch(
+                [ex._example for ex in cast(List[Example], examples)]
+            )
+
+    def predict_batch(
+        self, examples: Union[List[Example], List[List[Example]]]
+    ) -> BatchPrediction:
+        """Make a prediction for each example in a list in a single call. The predictions are returned as NumPy arrays rather than Python objects.
+
+        The layout of the result depends on the :py:meth:`~vowpal_wabbit_next.Workspace.prediction_type` of the model:
+
+        * `Scalar` and `Prob` - A float32 array with one element per example.
+        * `Multiclass` - A uint32 array with one element per example.
+        * `Scalars` - A tuple of `(offsets, values)`. The values for example `i` are `values[offsets[i]:offsets[i+1]]`.
+        * `ActionScores` and `ActionProbs` - A tuple of `(offsets, actions, scores)`. The action scores for example `i` are `actions[offsets[i]:offsets[i+1]]` and `scores[offsets[i]:offsets[i+1]]`.
+
+        Other prediction types are not supported. This is not supported if `enable_debug_tree=True` was passed in the constructor.
+
+        Examples:
+            >>> from vowpal_wabbit_next import Workspace, TextFormatParser
+            >>> workspace = Workspace()
+            >>> parser = TextFormatParser(workspace)
+            >>> workspace.predict_batch([parser.parse_line("| a"), parser.parse_line("| b")])
+            array([0., 0.], dtype=float32)
+
+        Args:
+            examples (Union[List[Example], List[List[Example]]]): Examples to predict on. If this workspace is :py:meth:`vowpal_wabbit_next.Workspace.multiline` then each item is a list of examples.
+
+        Returns:
+            BatchPrediction: Predictions for all examples, see above for the layout.
+        """
+        for example in examples:
+            self._check_label(example)
+
+        if self.multiline:
+            return cast(
+                BatchPrediction,
+                self._workspace.predict_multi_ex_batch(
+                    [
+                        [ex._example for ex in multi_ex]
+                        for multi_ex in cast(List[List[Example]], examples)
+                    ]
+                ),
+            )
+        else:
+            return cast(
+                BatchPrediction,
+                self._workspace.predict_batch(
+                    [ex._example for ex in cast(List[Example], examples)]
+                ),
+            )
+
+    def prepare(
+        self, examples: Union[Example, List[Example], List[List[Example]]]
+    ) -> None:
+        """Prepare examples which will be passed to learn or predict repeatedly, such as candidate actions which are scored many times or data used for several passes.
+
+        Before each learn or predict call the feature indices of an example are rewritten for this workspace and afterwards they are restored, which costs time proportional to the number of features. Prepared examples are left rewritten, so these calls skip that work until :py:meth:`~vowpal_wabbit_next.Workspace.unprepare` is called.
+
+        While an example is prepared its features cannot be modified, its indices reflect the internal layout of this workspace and it cannot be used with another workspace. Examples which are already prepared for this workspace are left as is.
+
+        Examples:
+            >>> from vowpal_wabbit_next import Workspace, TextFormatParser
+            >>> workspace = Workspace()
+            >>> parser = TextFormatParser(workspace)
+            >>> examples = [parser.parse_line("1 | a"), parser.parse_line("0 | b")]
+            >>> workspace.prepare(examples)
+            >>> for _ in range(10):
+            ...     workspace.learn_batch(examples)
+            >>> workspace.unprepare(examples)
+
+        Args:
+            examples (Union[Example, List[Example], List[List[Example]]]): Examples to prepare. Multiline examples may be given as lists.
+        """
+        self._workspace.prepare(_flatten_examples(examples))
+
+    def unprepare(
+        self, examples: Union[Example, List[Example], List[List[Example]]]
+    ) -> None:
+        """Restore examples prepared by :py:meth:`~vowpal_wabbit_next.Workspace.prepare` so that they can be modified or used with other workspaces. Examples which are not prepared are left as is.
+
+        Args:
+            examples (Union[Example, List[Example], List[List[Example]]]): Examples to restore. Multiline examples may be given as lists.
+        """
+        self._workspace.unprepare(_flatten_examples(examples))
+
+    def train_from_file(
+        self,
+        file_path: Union[str, os.PathLike[Any]],
+        *,
+        format: Literal["text", "dsjson", "json", "cache"] = "text",
+        passes: int = 1,
+        queue_size: int = 256,
+    ) -> int:
+        """Learn from every example in a file. The file is read and parsed on a background thread while learning happens on the calling thread, so parsing overlaps with learning and no Python objects are created per example.
+
+        Multiline examples are grouped in the same way as the format readers do. :py:meth:`~vowpal_wabbit_next.Workspace.end_pass` is called after each pass. Files ending in `.gz` are decompressed.
+
+        The workspace must not be used to parse examples from another thread while this runs. This is not supported if `enable_debug_tree=True` was passed in the constructor.
+
+        Examples:
+            >>> from vowpal_wabbit_next import Workspace
+            >>> workspace = Workspace()
+            >>> workspace.train_from_file("data.txt", passes=2) # doctest: +SKIP
+
+        Args:
+            file_path (Union[str, os.PathLike[Any]]): Path of the file to learn from.
+            format (Literal["text", "dsjson", "json", "cache"]): Format of the file. `cache` is the format written by :py:class:`~vowpal_wabbit_next.CacheFormatWriter`.
+            passes (int): Number of passes to make over the file.
+            queue_size (int): Maximum number of parsed examples, or multiline examples, waiting to be learned from.
+
+        Returns:
+            int: Number of examples, or multiline examples, learned from across all passes.
+        """
+        return self._workspace.train_from_file(
+            os.fspath(file_path),
+            format=_get_input_format(format),
+            passes=passes,
+            queue_size=queue_size,
+        )
+
+    def learn_parallel(
+        self,
+        examples: Union[List[Example], str, os.PathLike[Any]],
+        *,
+        threads: Optional[int] = None,
+        format: Literal["text", "dsjson", "json", "cache"] = "text",
+    ) -> int:
+        """Learn from examples on several native threads which all update the weights of this workspace without synchronization, in the style of Hogwild!. Updates from different threads can overwrite each other, which linear models tolerate with a small loss in accuracy in exchange for using many cores on one model.
+
+        Each thread after the first learns with a replica of this workspace which shares its weights but has its own reduction stack. Statistics such as the number of examples and the average loss are updated once all threads have finished. Replicas are created by the first call which needs them and are reused afterwards. The order examples are learned from is not deterministic.
+
+        Only linear models, where the reductions are `gd`, `scorer` and `count_label`, with dense weights are supported. Use :py:meth:`~vowpal_wabbit_next.Workspace.learn_batch` or :py:meth:`~vowpal_wabbit_next.Workspace.train_from_file` for other models. This is not supported if `enable_debug_tree=True` was passed in the constructor.
+
+        Examples:
+            >>> from vowpal_wabbit_next import Workspace, TextFormatParser
+            >>> workspace = Workspace()
+            >>> parser = TextFormatParser(workspace)
+            >>> workspace.learn_parallel([parser.parse_line("1 | a"), parser.parse_line("0 | b")], threads=2)
+            2
+
+        Args:
+            examples (Union[List[Example], str, os.PathLike[Any]]): Examples to learn on, each of which may only appear once, or the path of a file to read them from. A file is parsed by the learning threads in turn, each parsing a batch while the others learn. Files ending in `.gz` are decompressed.
+            threads (Optional[int]): Number of threads to learn with, including the calling thread. Defaults to one per core.
+            format (Literal["text", "dsjson", "json", "cache"]): Format of the file, if examples is a path.
+
+        Returns:
+            int: Number of examples learned from.
+        """
+        num_threads = threads if threads is not None else (os.cpu_count() or 1)
+        if isinstance(examples, (str, os.PathLike)):
+            return self._workspace.learn_parallel_from_file(
+                os.fspath(examples),
+                format=_get_input_format(format),
+                threads=num_threads,
+            )
+
+        for example in examples:
+            self._check_label(example)
+        return self._workspace.learn_parallel(
+            [ex._example for ex in examples], threads=num_threads
+        )
+
     def end_pass(self) -> None:
         """Signal the end of a pass to the model."""
         self._workspace.end_pass()
 
+    def freeze(
+        self, *, precision: Literal["float32", "float16", "int8"] = "float32"
+    ) -> None:
+        """Convert this workspace into an inference only workspace. The weights are copied into a compact array without the per weight state used for learning, optionally quantized, and the full weights are released.
+
+        Afterwards only prediction is supported. Prediction does not take the workspace's lock, so a frozen workspace can be used to predict from many threads concurrently. Parsing examples works as before. Learning, serialization other than :py:meth:`~vowpal_wabbit_next.Workspace.save_frozen` and access to the weights raise an error.
+
+        Only linear models, where the reductions are `gd`, `scorer` and `count_label`, can be frozen. This is not supported if `enable_debug_tree=True` was passed in the constructor. Examples prepared with :py:meth:`~vowpal_wabbit_next.Workspace.prepare` must be unprepared before they are used with a frozen workspace.
+
+        Examples:
+            >>> from vowpal_wabbit_next import Workspace, TextFormatParser
+            >>> workspace = Workspace()
+            >>> parser = TextFormatParser(workspace)
+            >>> workspace.learn_one(parser.parse_line("1 | a"))
+            >>> workspace.freeze(precision="float16")
+            >>> prediction = workspace.predict_one(parser.parse_line("| a"))
+
+        Args:
+            precision (Literal["float32", "float16", "int8"]): Precision the weights are stored in. `float16` halves the memory of `float32` and `int8` quarters it, both at a small cost in accuracy. `int8` weights are scaled per block of 64 weights.
+        """
+        weight_precision = {
+            "float32": _core._WeightPrecision.Float32,
+            "float16": _core._WeightPrecision.Float16,
+            "int8": _core._WeightPrecision.Int8,
+        }.get(precision)
+        if weight_precision is None:
+            raise ValueError(f"Unknown precision: {precision}")
+
+        self._workspace.freeze(precision=weight_precision)
+
+    @property
+    def frozen(self) -> bool:
+        """Whether :py:meth:`~vowpal_wabbit_next.Workspace.freeze` has been called on this workspace.
+
+        Returns:
+            bool: True if this workspace is inference only
+        """
+        return self._workspace.get_is_frozen()
+
+    @property
+    def frozen_weights_bytes(self) -> Optional[int]:
+        """Memory used by the weights of a frozen workspace.
+
+        Returns:
+            Optional[int]: Size of the weights in bytes, or None if this workspace is not frozen
+        """
+        return self._workspace.get_frozen_weights_bytes()
+
+    def save_frozen(self, file_path: Union[str, os.PathLike[Any]]) -> None:
+        """Save a frozen workspace to a file which can be loaded with :py:meth:`~vowpal_wabbit_next.Workspace.load_frozen`. The weights are stored exactly as they are laid out in memory, in the precision they were frozen with.
+
+        Args:
+            file_path (Union[str, os.PathLike[Any]]): Path to write the frozen model to
+        """
+        self._workspace.save_frozen(os.fspath(file_path))
+
     @property
     def prediction_type(self) -> PredictionType:
         """Based on the command line parameters used to setup VW a certain type of prediction is produced. See :py:class:`vowpal_wabbit_next.PredictionType` for the list of types and their corresponding Python type.
@@ -327,8 +715,233 @@ class Workspace(Generic[IsDebugT]):
         """
         return cast(MetricsDict, self._workspace.get_metrics())
 
+    def sampled_debug_trees(self, *, clear: bool = False) -> List[DebugNode]:
+        """The debug trees captured for the most recent sampled calls into the reduction stack, oldest first. Requires the workspace to be created with `debug_sample_every` or `debug_sample_probability`.
+
+        Each learn or predict of a reduction stack is a call, so a single :py:meth:`~vowpal_wabbit_next.Workspace.learn_one` may make more than one and a batch makes one per example.
+
+        .. warning::
+            This is an experimental feature.
+
+        Examples:
+            >>> from vowpal_wabbit_next import Workspace, TextFormatParser
+            >>> workspace = Workspace(debug_sample_every=100)
+            >>> parser = TextFormatParser(workspace)
+            >>> for _ in range(1000):
+            ...     workspace.learn_one(parser.parse_line("1 | a"))
+            >>> trees = workspace.sampled_debug_trees(clear=True)
+
+        Args:
+            clear (bool): If true, the captured trees are discarded once returned.
+
+        Returns:
+            List[DebugNode]: Root of each captured tree
+
+        Raises:
+            ValueError: If the workspace was not created with debug tree sampling
+        """
+        return self._workspace.get_sampled_debug_trees(clear=clear)
+
+    @property
+    def reduction_profile(self) -> List[Dict[str, Any]]:
+        """Time spent in each reduction since the workspace was created or :py:meth:`~vowpal_wabbit_next.Workspace.reset_reduction_profile` was called. Requires the workspace to be created with `enable_profiling`.
+
+        There is an element for each reduction from the top of the stack down, since a stack can contain a reduction more than once. Each holds the `name` of the reduction and the counters of each function under `learn` and `predict`, which are:
+
+        * `calls` - Number of calls.
+        * `total_seconds` - Time spent in the reduction and the reductions below it.
+        * `self_seconds` - Time spent in the reduction itself.
+        * `histogram` - Array where element i counts the calls which took between 2^i and 2^(i+1) nanoseconds in total. The first and last elements also count shorter and longer calls.
+
+        Only calls made on the thread calling into the workspace are recorded, so the other threads of :py:meth:`~vowpal_wabbit_next.Workspace.learn_parallel` are not. A reduction which calls the one below it several times for an example adds a call for each.
+
+        Examples:
+            >>> from vowpal_wabbit_next import Workspace, TextFormatParser
+            >>> workspace = Workspace(enable_profiling=True)
+            >>> parser = TextFormatParser(workspace)
+            >>> workspace.learn_one(parser.parse_line("1 | a"))
+            >>> profile = workspace.reduction_profile
+            >>> print([reduction["learn"]["calls"] for reduction in profile])
+            [1, 1, 1]
+
+        Returns:
+            List[Dict[str, Any]]: Name and counters of each function of each reduction
+
+        Raises:
+            ValueError: If the workspace was not created with profiling enabled
+        """
+        names, counters = self.reduction_profile_counters()
+        result: List[Dict[str, Any]] = []
+        for name, reduction in zip(names, counters):
+            entry: Dict[str, Any] = {"name": name}
+            for function, values in zip(("learn", "predict"), reduction):
+                entry[function] = {
+                    "calls": int(values[0]),
+                    "total_seconds": values[1] / 1e9,
+                    "self_seconds": values[2] / 1e9,
+                    "histogram": values[3:],
+                }
+            result.append(entry)
+        return result
+
+    def reduction_profile_counters(self) -> Tuple[List[str], npt.NDArray[np.uint64]]:
+        """The counters of :py:attr:`~vowpal_wabbit_next.Workspace.reduction_profile` as a single array, which is cheaper to read at a high frequency.
+
+        Returns:
+            Tuple[List[str], npt.NDArray[np.uint64]]: The names of the reductions from the top of the stack down, and an array of shape `(reductions, 2, 35)`. The second axis is learn then predict, and the last holds the number of calls, the total and self time in nanoseconds and then the 32 elements of the histogram.
+
+        Raises:
+            ValueError: If the workspace was not created with profiling enabled
+        """
+        return cast(
+            Tuple[List[str], npt.NDArray[np.uint64]],
+            self._workspace.get_reduction_profile(),
+        )
+
+    def reset_reduction_profile(self) -> None:
+        """Reset the counters of :py:attr:`~vowpal_wabbit_next.Workspace.reduction_profile` to zero.
+
+        Raises:
+            ValueError: If the workspace was not created with profiling enabled
+        """
+        self._workspace.reset_reduction_profile()
+
+    @property
+    def counters(self) -> Dict[str, Any]:
+        """Counters of the work done by the workspace since it was created or :py:meth:`~vowpal_wabbit_next.Workspace.reset_counters` was called. Requires the workspace to be created with `record_counters`.
+
+        The values are:
+
+        * `examples_learned` - Number of examples learned from. A multiline example counts once, and so does a call to :py:meth:`~vowpal_wabbit_next.Workspace.predict_then_learn_one`.
+        * `examples_predicted` - Number of examples predicted on.
+        * `features` - Number of features of those examples, including the constant feature.
+        * `interacted_features` - Number of features generated by interactions.
+        * `average_features_per_example` - Features, including the interacted features, per example learned from or predicted on.
+        * `parse_errors` - Number of lines which the parsers of this workspace failed to parse.
+        * `learn_latency` and `predict_latency` - Dictionaries of the `total_seconds` spent in the calls and a `histogram` array where element i counts the calls which took between 2^i and 2^(i+1) nanoseconds. The first and last elements also count shorter and longer calls. Each example of a batch is a call.
+
+        Examples:
+            >>> from vowpal_wabbit_next import Workspace, TextFormatParser
+            >>> workspace = Workspace(record_counters=True)
+            >>> parser = TextFormatParser(workspace)
+            >>> workspace.learn_one(parser.parse_line("1 | a b"))
+            >>> workspace.counters["features"]
+            3
+
+        Returns:
+            Dict[str, Any]: Value of each counter
+
+        Raises:
+            ValueError: If the workspace was not created with counters enabled
+        """
+        names = self.counter_names()
+        array = self.read_counters()
+        values = dict(zip(names, array.tolist()))
+        examples = values["examples_learned"] + values["examples_predicted"]
+        result: Dict[str, Any] = {
+            name: values[name]
+            for name in (
+                "examples_learned",
+                "examples_predicted",
+                "features",
+                "interacted_features",
+                "parse_errors",
+            )
+        }
+        result["average_features_per_example"] = (
+            (values["features"] + values["interacted_features"]) / examples
+            if examples > 0
+            else 0.0
+        )
+        for kind in ("learn", "predict"):
+            result[f"{kind}_latency"] = {
+                "total_seconds": values[f"{kind}_latency_total_ns"] / 1e9,
+                "histogram": array[
+                    [
+                        i
+                        for i, name in enumerate(names)
+                        if name.startswith(f"{kind}_latency_bucket_")
+                    ]
+                ],
+            }
+        return result
+
+    def read_counters(
+        self, *, out: Optional[npt.NDArray[np.uint64]] = None
+    ) -> npt.NDArray[np.uint64]:
+        """The values of :py:attr:`~vowpal_wabbit_next.Workspace.counters` as a flat array, named by :py:meth:`~vowpal_wabbit_next.Workspace.counter_names`. The counters are read without waiting for calls in progress, so this can be scraped at a high frequency from another thread. Passing the same `out` array each time avoids any allocation.
+
+        Each counter is read on its own, so the values of a call in progress may be partially included.
+
+        Examples:
+            >>> import numpy as np
+            >>> from vowpal_wabbit_next import Workspace
+            >>> workspace = Workspace(record_counters=True)
+            >>> buffer = np.zeros(len(Workspace.counter_names()), dtype=np.uint64)
+            >>> counters = workspace.read_counters(out=buffer)
+
+        Args:
+            out (Optional[npt.NDArray[np.uint64]]): If given, a contiguous uint64 array with at least as many elements as there are counters which the values are written into.
+
+        Returns:
+            npt.NDArray[np.uint64]: The values of the counters. If `out` was given this is a view of it.
+
+        Raises:
+            ValueError: If the workspace was not created with counters enabled, or `out` is not a suitable array
+        """
+        return cast(npt.NDArray[np.uint64], self._workspace.read_counters(out))
+
+    @staticmethod
+    def counter_names() -> List[str]:
+        """The name of each value of :py:meth:`~vowpal_wabbit_next.Workspace.read_counters`, in order. These are `examples_learned`, `examples_predicted`, `features`, `interacted_features`, `parse_errors`, `learn_latency_total_ns` and `predict_latency_total_ns`, followed by the buckets of the latency histograms named `learn_latency_bucket_<i>` and then `predict_latency_bucket_<i>`.
+
+        Returns:
+            List[str]: Names of the counters
+        """
+        return _core.Workspace.get_counter_names()
+
+    def reset_counters(self) -> None:
+        """Reset the values of :py:attr:`~vowpal_wabbit_next.Workspace.counters` to zero.
+
+        Raises:
+            ValueError: If the workspace was not created with counters enabled
+        """
+        self._workspace.reset_counters()
+
+    @property
+    def example_pool_stats(self) -> Dict[str, int]:
+        """Statistics for the pool which examples parsed for this workspace are allocated from. Released examples are kept for reuse, along with their feature buffers, up to a maximum count.
+
+        The keys are:
+
+        * `hits` - Number of examples served from retained examples.
+        * `misses` - Number of examples which needed a new allocation.
+        * `discarded` - Number of released examples which were freed because the maximum was already retained.
+        * `in_use` - Number of examples currently alive.
+        * `retained` - Number of examples held for reuse.
+        * `retained_bytes` - Approximate memory held by retained examples.
+        * `high_water_mark` - Largest number of examples in use at once since the last :py:meth:`~vowpal_wabbit_next.Workspace.trim_example_pool`.
+        * `max_retained` - Maximum number of examples retained, see :py:meth:`~vowpal_wabbit_next.Workspace.set_example_pool_max_retained`.
+
+        Returns:
+            Dict[str, int]: Pool statistics
+        """
+        return cast(Dict[str, int], self._workspace.get_example_pool_stats())
+
+    def set_example_pool_max_retained(self, max_retained: int) -> None:
+        """Set the maximum number of released examples kept for reuse by this workspace's pool. Any retained above this are freed immediately.
+
+        Args:
+            max_retained (int): Maximum number of examples to retain
+        """
+        self._workspace.set_example_pool_max_retained(max_retained)
+
+    def trim_example_pool(self) -> None:
+        """Free retained examples which are not needed to reach the high water mark of examples in use again, then reset the high water mark. Call this after a burst, such as parsing a large batch, to release memory the steady state does not need."""
+        self._workspace.trim_example_pool()
+
     def serialize(self) -> bytes:
-        """Serialize the current workspace as a VW model that can be loaded by the Workspace constructor, or command line tool.
+        """Serialize the current workspace as a VW model that can be loaded by the Workspace constructor, or command line tool. For large models prefer :py:meth:`~vowpal_wabbit_next.Workspace.serialize_to`, which does not hold the whole model in memory.
 
         Returns:
             bytes: raw bytes of serialized Workspace
@@ -344,10 +957,10 @@ class Workspace(Generic[IsDebugT]):
         record_metrics: bool = False,
         enable_debug_tree: bool = False,
     ) -> Workspace[Any]:
-        """Load a VW model from a file.
+        """Load a VW model from a file. The model is deserialized as the file is read, see the `model_file` argument of :py:class:`~vowpal_wabbit_next.Workspace`.
 
         Args:
-            file_path (Union[str, os.PathLike[Any]]): Path to file containing serialized model
+            file_path (Union[str, os.PathLike[Any]]): Path to file containing serialized model. Files ending in `.gz` are decompressed.
             args (List[str]): VowpalWabbit command line options for configuring the model. An overall list can be found `here <https://vowpalwabbit.org/docs/vowpal_wabbit/python/latest/command_line_args.html>`_. Options which affect the driver are not supported. For example:
                 `--sort_features`, `--ngram`, `--feature_limit`, `--ignore`, `--extra_metrics`, `--dump_json_weights_experimental`
             record_feature_names (bool, optional): If true, the invert hash will be recorded for each example. This is required to use :py:meth:`vowpal_wabbit_next.Workspace.json_weights`. This will slow down parsing and learn/predict.
@@ -360,13 +973,10 @@ class Workspace(Generic[IsDebugT]):
         Returns:
             Workspace[Any]: Workspace with the loaded model
         """
-        with open(file_path, "rb") as f:
-            model_data = f.read()
-
         if enable_debug_tree:
             return Workspace[Literal[True]](
                 args,
-                model_data=model_data,
+                model_file=file_path,
                 record_feature_names=record_feature_names,
                 record_metrics=record_metrics,
                 enable_debug_tree=True,
@@ -374,16 +984,198 @@ class Workspace(Generic[IsDebugT]):
         else:
             return Workspace[Literal[False]](
                 args,
-                model_data=model_data,
+                model_file=file_path,
                 record_feature_names=record_feature_names,
                 record_metrics=record_metrics,
                 enable_debug_tree=False,
             )
 
+    @staticmethod
+    def load_for_inference(
+        file_path: Union[str, os.PathLike[Any]],
+        args: List[str] = [],
+        *,
+        precision: Literal["float32", "float16", "int8"] = "float32",
+    ) -> Workspace[Literal[False]]:
+        """Load a VW model from a file into a frozen, inference only, workspace. See :py:meth:`~vowpal_wabbit_next.Workspace.freeze`.
+
+        Args:
+            file_path (Union[str, os.PathLike[Any]]): Path to file containing serialized model
+            args (List[str]): VowpalWabbit command line options for configuring the model, see :py:meth:`~vowpal_wabbit_next.Workspace.load_from_file`.
+            precision (Literal["float32", "float16", "int8"]): Precision the weights are stored in.
+
+        Returns:
+            Workspace[Literal[False]]: Frozen workspace with the loaded model
+        """
+        workspace = cast(
+            Workspace[Literal[False]], Workspace.load_from_file(file_path, args)
+        )
+        workspace.freeze(precision=precision)
+        return workspace
+
+    @staticmethod
+    def load_frozen(
+        file_path: Union[str, os.PathLike[Any]], args: List[str] = []
+    ) -> Workspace[Literal[False]]:
+        """Load a file written by :py:meth:`~vowpal_wabbit_next.Workspace.save_frozen` into a frozen, inference only, workspace.
+
+        The file is memory mapped and the weights are used directly from the mapping rather than being copied. Every process which loads the same file shares a single copy of the weights in physical memory, and loading takes the same time regardless of the size of the model. Placing the file on a memory backed file system such as `/dev/shm` makes it a named shared memory segment. The file must not be modified while any workspace is using it.
+
+        Examples:
+            >>> from vowpal_wabbit_next import Workspace, TextFormatParser
+            >>> workspace = Workspace()
+            >>> parser = TextFormatParser(workspace)
+            >>> workspace.learn_one(parser.parse_line("1 | a"))
+            >>> workspace.freeze()
+            >>> workspace.save_frozen("/dev/shm/model.frozen")
+            >>> worker = Workspace.load_frozen("/dev/shm/model.frozen")
+            >>> prediction = worker.predict_one(TextFormatParser(worker).parse_line("| a"))
+
+        Args:
+            file_path (Union[str, os.PathLike[Any]]): Path to the frozen model
+            args (List[str]): VowpalWabbit command line options for configuring the model, see :py:meth:`~vowpal_wabbit_next.Workspace.load_from_file`.
+
+        Returns:
+            Workspace[Literal[False]]: Frozen workspace using the weights in the file
+        """
+        frozen_file = _core._FrozenModelFile(os.fspath(file_path))
+        workspace = Workspace[Literal[False]](
+            args, model_data=frozen_file.model_data, enable_debug_tree=False
+        )
+        workspace._workspace.attach_frozen(frozen_file)
+        return workspace
+
     def serialize_to_file(self, file_path: Union[str, os.PathLike[Any]]) -> None:
-        """Serialize the current workspace as a VW model to a file."""
+        """Serialize the current workspace as a VW model to a file. Files ending in `.gz` are compressed."""
         return self._workspace.serialize_to_file(os.fspath(file_path))
 
+    def serialize_to(self, file: Union[BinaryIO, str, os.PathLike[Any]]) -> None:
+        """Serialize the current workspace as a VW model to a path or binary file object. Unlike :py:meth:`~vowpal_wabbit_next.Workspace.serialize` the model is written in chunks as it is serialized, so it is never held in memory in full.
+
+        Examples:
+            >>> from vowpal_wabbit_next import Workspace
+            >>> import gzip
+            >>> workspace = Workspace()
+            >>> with gzip.open("model.vw.gz", "wb") as f:
+            ...     workspace.serialize_to(f)
+
+        Args:
+            file (Union[BinaryIO, str, os.PathLike[Any]]): Path or binary file object to write the model to. Paths ending in `.gz` are compressed.
+        """
+        if isinstance(file, (str, os.PathLike)):
+            self._workspace.serialize_to_file(os.fspath(file))
+        else:
+            self._workspace.serialize_to(file)
+
+    def checkpoint(self, file_path: Union[str, os.PathLike[Any]]) -> None:
+        """Write a checkpoint of this workspace which can be loaded with :py:meth:`~vowpal_wabbit_next.Workspace.load_checkpoint`.
+
+        The workspace is only locked while a snapshot is taken, which copies the weights but does not serialize them. The checkpoint is then written without the lock, so other threads can keep learning while it is written. The snapshot temporarily uses as much memory as the weights.
+
+        The checkpoint is written to a uniquely named temporary file next to `file_path`, synced to disk and then renamed, so an interrupted or failed checkpoint does not replace an existing one. Checkpoints are not VW models and can't be loaded by the command line tool, use :py:meth:`~vowpal_wabbit_next.Workspace.serialize_to` for that. Only supported for dense weights.
+
+        Args:
+            file_path (Union[str, os.PathLike[Any]]): Path to write the checkpoint to
+        """
+        self._workspace.take_snapshot().write_to_file(os.fspath(file_path))
+
+    def checkpoint_async(
+        self, file_path: Union[str, os.PathLike[Any]]
+    ) -> concurrent.futures.Future[None]:
+        """Take a snapshot of this workspace and write it as a checkpoint on a background thread. See :py:meth:`~vowpal_wabbit_next.Workspace.checkpoint`.
+
+        The snapshot is taken before this returns, so the checkpoint holds the state of the workspace at the time of the call regardless of any learning which happens while it is written. The time learning was paused to take each snapshot is reported by :py:attr:`~vowpal_wabbit_next.Workspace.checkpoint_stats`.
+
+        Examples:
+            >>> from vowpal_wabbit_next import Workspace, TextFormatParser
+            >>> workspace = Workspace()
+            >>> parser = TextFormatParser(workspace)
+            >>> workspace.learn_one(parser.parse_line("1 | a"))
+            >>> future = workspace.checkpoint_async("model.checkpoint")
+            >>> workspace.learn_one(parser.parse_line("0 | b"))
+            >>> future.result()
+
+        Args:
+            file_path (Union[str, os.PathLike[Any]]): Path to write the checkpoint to
+
+        Returns:
+            concurrent.futures.Future[None]: Completes once the checkpoint has been written, or holds the error if writing it failed
+        """
+        snapshot = self._workspace.take_snapshot()
+        path = os.fspath(file_path)
+        future: concurrent.futures.Future[None] = concurrent.futures.Future()
+        future.set_running_or_notify_cancel()
+
+        def write() -> None:
+            try:
+                snapshot.write_to_file(path)
+            except BaseException as e:
+                future.set_exception(e)
+            else:
+                future.set_result(None)
+
+        # Not a daemon thread, so a checkpoint in progress is finished before the interpreter exits.
+        threading.Thread(target=write, name="vowpal_wabbit_next.checkpoint").start()
+        return future
+
+    @property
+    def checkpoint_stats(self) -> Dict[str, float]:
+        """How long learning was paused to take the snapshots of :py:meth:`~vowpal_wabbit_next.Workspace.checkpoint` and :py:meth:`~vowpal_wabbit_next.Workspace.checkpoint_async`.
+
+        Returns:
+            Dict[str, float]: Contains `checkpoints`, the number of snapshots taken, and `last_pause_seconds`, `max_pause_seconds` and `total_pause_seconds`
+        """
+        return cast(Dict[str, float], self._workspace.get_checkpoint_stats())
+
+    @staticmethod
+    def load_checkpoint(
+        file_path: Union[str, os.PathLike[Any]], args: List[str] = []
+    ) -> Workspace[Literal[False]]:
+        """Load a file written by :py:meth:`~vowpal_wabbit_next.Workspace.checkpoint`.
+
+        Args:
+            file_path (Union[str, os.PathLike[Any]]): Path to the checkpoint
+            args (List[str]): VowpalWabbit command line options for configuring the model, see :py:meth:`~vowpal_wabbit_next.Workspace.load_from_file`.
+
+        Returns:
+            Workspace[Literal[False]]: Workspace in the state it was in when the checkpoint was taken
+        """
+        checkpoint_file = _core._CheckpointFile(os.fspath(file_path))
+        workspace = Workspace[Literal[False]](
+            args, model_data=checkpoint_file.model_data, enable_debug_tree=False
+        )
+        workspace._workspace.restore_checkpoint(checkpoint_file)
+        return workspace
+
+    def clone(self, *, share_weights: bool = False) -> Workspace[IsDebugT]:
+        """Create a copy of this workspace, for example to experiment with a copy of a model while the original keeps serving. Cloning is much cheaper than loading the output of :py:meth:`~vowpal_wabbit_next.Workspace.serialize`, as the weights are copied directly rather than serialized and parsed.
+
+        The clone is created with the same arguments as this workspace and continues learning from the same state. Changes to either workspace are never seen by the other.
+
+        With `share_weights` the weights are not copied. Both workspaces use the same weights until one of them changes its weights, by learning or any other call which can change them, at which point that workspace copies the weights first. Cloning is then cheap regardless of the size of the model, which suits a clone that is only used for prediction or is discarded after a few updates. Arrays returned by :py:meth:`~vowpal_wabbit_next.Workspace.weights` before the weights are copied keep viewing the shared weights.
+
+        .. attention::
+            Only dense weights are supported.
+
+        Examples:
+            >>> from vowpal_wabbit_next import Workspace, TextFormatParser
+            >>> workspace = Workspace()
+            >>> parser = TextFormatParser(workspace)
+            >>> workspace.learn_one(parser.parse_line("1 | a"))
+            >>> experiment = workspace.clone(share_weights=True)
+            >>> experiment.learn_one(TextFormatParser(experiment).parse_line("0 | a"))
+
+        Args:
+            share_weights (bool): If true, the weights are shared until either workspace changes them.
+
+        Returns:
+            Workspace[IsDebugT]: Copy of this workspace
+        """
+        clone = Workspace(
+            _existing_workspace=self._workspace.clone(share_weights=share_weights)
+        )
+        return cast(Workspace[IsDebugT], clone)
+
     def weights(self) -> npt.NDArray[np.float32]:
         """Access to the weights of the model currently.
 
@@ -1,4 +1,5 @@
 import io
+import pytest
 import vowpal_wabbit_next as vw
 from textwrap import dedent
 
@@ -31,3 +32,73 @@ def test_write_and_read_cache() -> None:
             read_counter += 1
 
     assert write_counter == read_counter
+
+
+class _FullFile(io.RawIOBase):
+    # Accepts the first capacity bytes, then writes short as a full disk would.
+    def __init__(self, capacity: int) -> None:
+        self.capacity = capacity
+
+    def writable(self) -> bool:
+        return True
+
+    def write(self, data) -> int:  # type: ignore[override]
+        written = min(len(data), self.capacity)
+        self.capacity -= written
+        return written
+
+
+def test_short_cache_write_is_reported() -> None:
+    workspace = vw.Workspace()
+    parser = vw.TextFormatParser(workspace)
+    line = "1 | " + " ".join(f"feature_{i}" for i in range(100))
+    with pytest.raises(RuntimeError):
+        with vw.CacheFormatWriter(workspace, _FullFile(64)) as writer:
+            writer.write_example(parser.parse_line(line))
+
+
+def write_cache_file(workspace: vw.Workspace, path, lines) -> None:
+    parser = vw.TextFormatParser(workspace)
+    with open(path, "wb") as f:
+        with vw.CacheFormatWriter(workspace, f) as writer:
+            for line in lines:
+                writer.write_example(parser.parse_line(line))
+
+
+def test_read_cache_from_path_and_seek(tmp_path) -> None:
+    workspace = vw.Workspace()
+    cache_file = tmp_path / "data.cache"
+    write_cache_file(workspace, cache_file, ["1 | a", "0 | b c", "1 | d e f"])
+
+    with vw.CacheFormatReader(workspace, cache_file) as reader:
+        offsets = [reader.tell()]
+        num_features = []
+        for example in reader:
+            assert isinstance(example, vw.Example)
+            num_features.append(len(example[" "]))
+            offsets.append(reader.tell())
+        assert num_features == [1, 2, 3]
+
+        reader.seek(offsets[1])
+        example = next(iter(reader))
+        assert isinstance(example, vw.Example)
+        assert len(example[" "]) == 2
+
+        with pytest.raises(IndexError):
+            reader.seek(offsets[-1] + 1)
+
+
+def test_write_examples_multiline_to_path(tmp_path) -> None:
+    workspace = vw.Workspace(["--cb_explore_adf"])
+    parser = vw.TextFormatParser(workspace)
+    multi_exs = [
+        [parser.parse_line("shared | s_1"), parser.parse_line("0:0.1:0.25 | a")],
+        [parser.parse_line("| b"), parser.parse_line("| c"), parser.parse_line("| d")],
+    ]
+
+    cache_file = tmp_path / "data.cache"
+    with vw.CacheFormatWriter(workspace, cache_file) as writer:
+        writer.write_examples(multi_exs)
+
+    with vw.CacheFormatReader(workspace, cache_file) as reader:
+        assert [len(multi_ex) for multi_ex in reader] == [2, 3]
@@ -85,3 +85,127 @@ def test_automl_epsilon_decay_return_tree():
     assert isinstance(dbg_node, list)
     assert len(dbg_node) == 1
     assert calc_depth(dbg_node[0]) > 5
+
+
+def test_sampled_debug_trees():
+    workspace = vw.Workspace(debug_sample_every=4, debug_sample_buffer_size=3)
+    parser = vw.TextFormatParser(workspace)
+
+    ex = parser.parse_line("1 | price:.23 sqft:.25 age:.05 2006")
+    for _ in range(10):
+        assert workspace.predict_one(ex) == pytest.approx(workspace.predict_one(ex))
+    # 20 calls, every 4th is captured.
+    trees = workspace.sampled_debug_trees()
+    assert len(trees) == 3
+    for tree in trees:
+        assert isinstance(tree, vw.DebugNode)
+        assert tree.function == "predict"
+        assert calc_depth(tree) == 3
+
+    workspace.learn_one(ex)
+    assert len(workspace.sampled_debug_trees(clear=True)) == 3
+    assert workspace.sampled_debug_trees() == []
+
+    with pytest.raises(ValueError):
+        vw.Workspace().sampled_debug_trees()
+    with pytest.raises(ValueError):
+        vw.Workspace(debug_sample_every=2, debug_sample_probability=0.5)
+
+
+def test_write_flamegraph_and_chrome_trace(tmp_path):
+    workspace = vw.Workspace(enable_debug_tree=True)
+    parser = vw.TextFormatParser(workspace)
+
+    trees = []
+    for i in range(10):
+        trees.extend(workspace.learn_one(parser.parse_line(f"{i % 2} | a b{i}")))
+    assert len(trees) == 10
+
+    flamegraph_file = tmp_path / "learn.folded"
+    vw.write_flamegraph(trees, flamegraph_file)
+    stacks = {}
+    for line in flamegraph_file.read_text().splitlines():
+        stack, self_ns = line.rsplit(" ", 1)
+        stacks[stack] = int(self_ns)
+    # The calls are aggregated into one line per stack.
+    expected_stacks = set()
+
+    def add_stacks(node, parent_stack):
+        stack = f"{parent_stack};{node.name}({node.function})".lstrip(";")
+        expected_stacks.add(stack)
+        for child in node.children:
+            add_stacks(child, stack)
+
+    for tree in trees:
+        add_stacks(tree, "")
+    assert set(stacks) == expected_stacks
+    assert all(self_ns >= 0 for self_ns in stacks.values())
+
+    trace_file = tmp_path / "learn.json"
+    vw.write_chrome_trace(trees, trace_file)
+    events = iter(json.loads(trace_file.read_text())["traceEvents"])
+
+    # Events are written depth first, and each is within the event of its parent.
+    def check_events(node, parent_event):
+        event = next(events)
+        assert event["ph"] == "X"
+        assert event["name"] == node.name
+        assert event["cat"] == node.function
+        if parent_event is not None:
+            assert event["ts"] >= parent_event["ts"]
+            end = event["ts"] + event["dur"]
+            assert end <= parent_event["ts"] + parent_event["dur"] + 1e-3
+        for child in node.children:
+            check_events(child, event)
+        return event
+
+    root_starts = [check_events(tree, None)["ts"] for tree in trees]
+    assert next(events, None) is None
+    assert root_starts == sorted(root_starts)
+
+    vw.write_flamegraph([], flamegraph_file)
+    assert flamegraph_file.read_text() == ""
+    vw.write_chrome_trace([], trace_file)
+    assert json.loads(trace_file.read_text())["traceEvents"] == []
+
+
+def test_debug_tree_fields():
+    workspace = vw.Workspace(
+        enable_debug_tree=True, debug_tree_fields=["weight", "interactions"]
+    )
+    parser = vw.TextFormatParser(workspace)
+
+    prediction, tree = workspace.predict_one(parser.parse_line("1 2 | a b"))
+    assert calc_depth(tree) == 3
+    node = tree
+    while node is not None:
+        assert node.weight == pytest.approx(2)
+        assert node.interactions == []
+        assert node.input_labels is None
+        assert node.output_prediction is None
+        assert node.offset is None
+        assert node.partial_prediction is None
+        assert node.updated_prediction is None
+        node = node.children[0] if node.children else None
+
+    with pytest.raises(ValueError):
+        vw.Workspace(enable_debug_tree=True, debug_tree_fields=["not_a_field"])
+    with pytest.raises(ValueError):
+        vw.Workspace(debug_tree_fields=["weight"])
+
+
+def test_debug_trees_outlive_later_calls():
+    workspace = vw.Workspace(["-q", "ab"], enable_debug_tree=True)
+    parser = vw.TextFormatParser(workspace)
+
+    _, first_tree = workspace.predict_one(parser.parse_line("| a:1 b:1"))
+    first_leaf = first_tree.children[0].children[0]
+    for i in range(10):
+        _, tree = workspace.predict_one(parser.parse_line(f"1 2 | a:{i} b:1"))
+        assert tree.children[0].children[0].weight == pytest.approx(2)
+
+    # The nodes of a tree are reused for later calls only once nothing refers to it.
+    assert first_tree.weight == pytest.approx(1)
+    assert first_leaf.weight == pytest.approx(1)
+    assert first_leaf.interactions == ["ab"]
+    assert first_leaf.children == []
@@ -1,3 +1,4 @@
+import io
 import vowpal_wabbit_next as vw
 import pytest
 import numpy as np
@@ -106,3 +107,89 @@ def test_delta_aggregate_check_all():
 
     assert np.allclose(new_model.weights()[:, :, 0], reweighted_weights)
     assert np.allclose(new_model.weights()[:, :, 1], reweighted_adaptives)
+
+
+def test_sparse_delta_equivalent_to_dense() -> None:
+    base = vw.Workspace([])
+    parser = vw.TextFormatParser(base)
+
+    model_a = vw.Workspace(model_data=base.serialize())
+    model_a.learn_one(parser.parse_line("1 | a:1.1 b:0.3 c:-0.4"))
+    model_b = vw.Workspace(model_data=base.serialize())
+    model_b.learn_one(parser.parse_line("1 | a:-1.7 b:0.9 d:1.3"))
+
+    delta_a = vw.calculate_sparse_delta(base, model_a, num_threads=2)
+    delta_b = vw.calculate_sparse_delta(base, model_b)
+    # a, b, c and the constant feature
+    assert len(delta_a) == 4
+    assert delta_a.values.shape == (4, base.weights().shape[1])
+
+    merged = vw.merge_sparse_deltas([delta_a, delta_b], num_threads=2)
+    expected = vw.apply_delta(
+        base,
+        vw.merge_deltas(
+            [vw.calculate_delta(base, model_a), vw.calculate_delta(base, model_b)]
+        ),
+    )
+    vw.apply_delta_inplace(base, merged)
+    assert np.allclose(base.weights(), expected.weights())
+
+    with pytest.raises(ValueError):
+        vw.apply_delta_inplace(vw.Workspace(["-b", "10"]), merged)
+
+
+def test_sparse_delta_serialize_roundtrip() -> None:
+    base = vw.Workspace([])
+    parser = vw.TextFormatParser(base)
+    derived = vw.Workspace(model_data=base.serialize())
+    for line in ["1 | a:1.1 b:0.3 c:-0.4", "0 | a:-1.7 b:0.9 d:1.3"]:
+        derived.learn_one(parser.parse_line(line))
+    delta = vw.calculate_sparse_delta(base, derived)
+
+    data = delta.serialize(compress=True)
+    loaded = vw.SparseModelDelta.deserialize(io.BytesIO(data))
+    assert np.array_equal(loaded.indices, delta.indices)
+    assert np.array_equal(loaded.values, delta.values)
+    assert loaded.weighted_examples == delta.weighted_examples
+    vw.apply_delta_inplace(base, loaded)
+    assert np.allclose(base.weights(), derived.weights())
+
+    half = vw.SparseModelDelta.deserialize(delta.serialize(precision="float16"))
+    assert np.allclose(half.values, delta.values, rtol=1e-3)
+    assert len(delta.serialize(precision="float16")) < len(delta.serialize())
+
+    with pytest.raises(ValueError):
+        vw.SparseModelDelta.deserialize(data[:-1])
+
+
+def test_train_data_parallel(tmp_path) -> None:
+    lines = [f"{i % 2} | a:{i % 5} b c{i % 7}" for i in range(200)]
+    data_file = tmp_path / "data.txt"
+    data_file.write_text("\n".join(lines) + "\n")
+
+    # With one replica each round is learned in order and merged back unchanged.
+    model = vw.Workspace([])
+    parser = vw.TextFormatParser(model)
+    expected = vw.Workspace([])
+    expected.learn_batch([parser.parse_line(line) for line in lines])
+    trained = vw.train_data_parallel(
+        model, [parser.parse_line(line) for line in lines], replicas=1, sync_interval=50
+    )
+    assert np.allclose(trained.weights(), expected.weights())
+    assert np.count_nonzero(model.weights()) == 0
+
+    trained = vw.train_data_parallel(model, data_file, replicas=4, sync_interval=50)
+    assert np.count_nonzero(trained.weights()) > 0
+    # The replicas are kept between rounds, each counts only the examples it learned from.
+    assert vw.calculate_sparse_delta(model, trained).weighted_examples == 200
+
+    cb_model = vw.Workspace(["--cb_explore_adf"])
+    cb_parser = vw.TextFormatParser(cb_model)
+    cb_examples = [
+        [
+            cb_parser.parse_line("shared | s"),
+            cb_parser.parse_line(f"0:{i % 2}:0.5 | a{i % 3}"),
+        ]
+        for i in range(40)
+    ]
+    vw.train_data_parallel(cb_model, cb_examples, replicas=2, sync_interval=10)
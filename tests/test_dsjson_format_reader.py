@@ -129,3 +129,27 @@ def test_reader() -> None:
             assert len(example) == 5
 
     assert counter == 10
+
+
+def test_native_reader_from_path(tmp_path) -> None:
+    line = """{"_label_cost":-0.0,"_label_probability":0.05,"_label_Action":2,"_labelIndex":1,"a":[1,2],"c":{"shared":{"f":"1"},"_multi":[{"action":{"f":"1"}},{"action":{"f":"2"}}]},"p":[0.95,0.05]}"""
+    data_file = tmp_path / "data.json"
+    data_file.write_text(f"{line}\n\n{line}\n")
+    workspace = vw.Workspace(["--cb_explore_adf"])
+    counter = 0
+    with vw.DSJsonFormatReader(workspace, data_file) as reader:
+        for example in reader:
+            counter += 1
+            assert isinstance(example, list)
+            assert len(example) == 3
+
+    assert counter == 2
+
+
+def test_file_object_skips_blank_lines() -> None:
+    line = """{"_label_cost":-0.0,"_label_probability":0.05,"_label_Action":2,"_labelIndex":1,"a":[1,2],"c":{"shared":{"f":"1"},"_multi":[{"action":{"f":"1"}},{"action":{"f":"2"}}]},"p":[0.95,0.05]}"""
+    workspace = vw.Workspace(["--cb_explore_adf"])
+    with vw.DSJsonFormatReader(
+        workspace, io.StringIO(f"{line}\n\n \t\n{line}\n")
+    ) as reader:
+        assert len(list(reader)) == 2
@@ -76,3 +76,35 @@ def test_example_creation_index() -> None:
     del example["a"]
     assert "a" not in example
     assert len(example.feat_group_indices) == 0
+
+
+def test_example_pool_reuse_and_trim() -> None:
+    workspace = vw.Workspace()
+    parser = vw.TextFormatParser(workspace)
+
+    examples = [parser.parse_line(f"1 | a{i} b c") for i in range(10)]
+    stats = workspace.example_pool_stats
+    assert stats["in_use"] == 10
+    assert stats["misses"] == 10
+    assert stats["high_water_mark"] == 10
+
+    del examples
+    stats = workspace.example_pool_stats
+    assert stats["in_use"] == 0
+    assert stats["retained"] == 10
+    assert stats["retained_bytes"] > 0
+
+    example = parser.parse_line("1 | a")
+    assert workspace.example_pool_stats["hits"] == 1
+
+    # Nothing else is in use now, so trimming again drops down to what is needed for the single example in use.
+    workspace.trim_example_pool()
+    workspace.trim_example_pool()
+    assert workspace.example_pool_stats["retained"] == 0
+    del example
+
+    workspace.set_example_pool_max_retained(0)
+    parser.parse_line("1 | a")
+    stats = workspace.example_pool_stats
+    assert stats["retained"] == 0
+    assert stats["discarded"] == 1
@@ -1,5 +1,6 @@
 import vowpal_wabbit_next as vw
 import numpy as np
+import pytest
 
 
 def test_learn() -> None:
@@ -95,3 +96,273 @@ def test_igl_predict_and_learn():
         ][0][0]
         != 0
     )
+
+
+def test_learn_from_multiple_threads() -> None:
+    from concurrent.futures import ThreadPoolExecutor
+
+    lines = ["1 | a b c", "0 | b d", "0.5 | a c e"] * 50
+
+    def train() -> vw.Workspace:
+        model = vw.Workspace(["-q::"])
+        parser = vw.TextFormatParser(model)
+        for line in lines:
+            model.learn_one(parser.parse_line(line))
+        return model
+
+    expected = train()
+    with ThreadPoolExecutor(max_workers=4) as executor:
+        models = list(executor.map(lambda _: train(), range(4)))
+
+    for model in models:
+        assert np.allclose(model.weights(), expected.weights())
+
+
+def test_learn_batch_equivalent() -> None:
+    model_learn_one = vw.Workspace()
+    model_learn_batch = vw.Workspace()
+    parser = vw.TextFormatParser(model_learn_one)
+    lines = ["1 | a b c", "2 | b d", "0.5 | b"]
+
+    for line in lines:
+        model_learn_one.learn_one(parser.parse_line(line))
+    model_learn_batch.learn_batch([parser.parse_line(line) for line in lines])
+
+    assert np.allclose(model_learn_one.weights(), model_learn_batch.weights())
+
+
+def test_predict_batch_scalar() -> None:
+    model = vw.Workspace()
+    parser = vw.TextFormatParser(model)
+    model.learn_one(parser.parse_line("1 | a b c"))
+
+    examples = [parser.parse_line("| a"), parser.parse_line("| d")]
+    preds = model.predict_batch(examples)
+
+    assert isinstance(preds, np.ndarray)
+    assert preds.dtype == np.float32
+    assert np.allclose(preds, [model.predict_one(ex) for ex in examples])
+
+
+def test_predict_batch_action_probs() -> None:
+    model = vw.Workspace(["--cb_explore_adf"])
+    parser = vw.TextFormatParser(model)
+    multi_ex = [
+        parser.parse_line("shared | s_1"),
+        parser.parse_line("0:0.1:0.25 | a:0.5 b:1"),
+        parser.parse_line("| a:-1 b:-0.5"),
+    ]
+    model.learn_batch([multi_ex])
+
+    offsets, actions, scores = model.predict_batch([multi_ex, multi_ex[:2]])
+    assert list(offsets) == [0, 2, 3]
+    expected = model.predict_one(multi_ex)
+    assert list(zip(actions[:2], scores[:2])) == [
+        (a, pytest.approx(s)) for a, s in expected
+    ]
+
+
+def test_predict_one_numpy_equivalent() -> None:
+    model = vw.Workspace(["--cb_explore_adf"])
+    parser = vw.TextFormatParser(model)
+    multi_ex = [
+        parser.parse_line("shared | s_1"),
+        parser.parse_line("0:0.1:0.25 | a:0.5 b:1"),
+        parser.parse_line("| a:-1 b:-0.5"),
+    ]
+    model.learn_one(multi_ex)
+
+    expected = model.predict_one(multi_ex)
+    preds = model.predict_one_numpy(multi_ex)
+    assert list(zip(preds["action"], preds["score"])) == [
+        (a, pytest.approx(s)) for a, s in expected
+    ]
+
+    buffer = np.zeros(8, dtype=[("action", np.uint32), ("score", np.float32)])
+    preds = model.predict_one_numpy(multi_ex, out=buffer)
+    assert len(preds) == 2
+    assert np.shares_memory(preds, buffer)
+    assert list(buffer["action"][:2]) == [a for a, _ in expected]
+
+    with pytest.raises(ValueError):
+        model.predict_one_numpy(multi_ex, out=np.zeros(8, dtype=np.float32))
+    with pytest.raises(ValueError):
+        model.predict_one_numpy(multi_ex, out=buffer[:1])
+
+
+@pytest.mark.parametrize(
+    "precision,tolerance", [("float32", 1e-6), ("float16", 1e-2), ("int8", 5e-2)]
+)
+def test_frozen_predictions_equivalent(precision: str, tolerance: float) -> None:
+    from concurrent.futures import ThreadPoolExecutor
+
+    model = vw.Workspace(
+        ["-q", "ab", "--link", "logistic", "--loss_function", "logistic"]
+    )
+    parser = vw.TextFormatParser(model)
+    for i in range(100):
+        label = 1 if i % 3 == 0 else -1
+        model.learn_one(parser.parse_line(f"{label} |a x{i % 7} y:0.5 |b z{i % 5}"))
+
+    lines = [f"|a x{i} y:0.5 |b z{i}" for i in range(7)]
+    examples = [parser.parse_line(line) for line in lines]
+    expected = [model.predict_one(ex) for ex in examples]
+
+    model.freeze(precision=precision)
+    assert model.frozen
+    assert model.frozen_weights_bytes is not None
+
+    assert [model.predict_one(ex) for ex in examples] == pytest.approx(
+        expected, abs=tolerance
+    )
+    assert list(model.predict_batch(examples)) == pytest.approx(expected, abs=tolerance)
+
+    # Frozen predictions don't take the workspace lock. Predicting changes an example
+    # in place, so each task gets its own.
+    distinct_examples = [parser.parse_line(line) for line in lines * 10]
+    with ThreadPoolExecutor(max_workers=4) as executor:
+        results = list(executor.map(model.predict_one, distinct_examples))
+    assert results == pytest.approx(expected * 10, abs=tolerance)
+
+    with pytest.raises(RuntimeError):
+        model.learn_one(examples[0])
+    with pytest.raises(RuntimeError):
+        model.serialize()
+
+
+def test_freeze_rejects_non_linear_model() -> None:
+    model = vw.Workspace(["--oaa", "3"])
+    with pytest.raises(ValueError):
+        model.freeze()
+    assert not model.frozen
+
+
+@pytest.mark.parametrize("precision", ["float32", "int8"])
+def test_load_frozen_equivalent(tmp_path, precision: str) -> None:
+    model = vw.Workspace(["-q", "ab", "--link", "logistic", "-b", "20"])
+    parser = vw.TextFormatParser(model)
+    for i in range(100):
+        model.learn_one(parser.parse_line(f"{i % 2} |a x{i % 7} |b z{i % 5}"))
+    model.freeze(precision=precision)
+
+    frozen_file = tmp_path / "model.frozen"
+    model.save_frozen(frozen_file)
+    # The saved model only holds the weights once, in the frozen layout.
+    assert frozen_file.stat().st_size < model.frozen_weights_bytes + 4096
+
+    loaded = vw.Workspace.load_frozen(frozen_file)
+    assert loaded.frozen
+    assert loaded.frozen_weights_bytes == model.frozen_weights_bytes
+    loaded_parser = vw.TextFormatParser(loaded)
+    for i in range(7):
+        line = f"|a x{i} |b z{i}"
+        assert loaded.predict_one(loaded_parser.parse_line(line)) == model.predict_one(
+            parser.parse_line(line)
+        )
+
+    with pytest.raises(RuntimeError):
+        vw.Workspace().save_frozen(tmp_path / "not_frozen")
+    not_frozen_file = tmp_path / "not_frozen.txt"
+    not_frozen_file.write_text("1 | a")
+    with pytest.raises(ValueError):
+        vw.Workspace.load_frozen(not_frozen_file)
+
+
+def test_train_from_file_equivalent(tmp_path) -> None:
+    lines = ["1 | a b c", "2 | b d", "0.5 | b"]
+    data_file = tmp_path / "data.txt"
+    data_file.write_text("\n".join(lines) + "\n")
+
+    model_learn_one = vw.Workspace()
+    model_from_file = vw.Workspace()
+    parser = vw.TextFormatParser(model_learn_one)
+
+    for _ in range(2):
+        for line in lines:
+            model_learn_one.learn_one(parser.parse_line(line))
+        model_learn_one.end_pass()
+
+    assert model_from_file.train_from_file(data_file, passes=2) == 6
+    assert np.allclose(model_learn_one.weights(), model_from_file.weights())
+
+
+def test_train_from_file_multiline(tmp_path) -> None:
+    data_file = tmp_path / "data.txt"
+    data_file.write_text(
+        "shared | s_1\n0:0.1:0.25 | a:0.5 b:1\n| a:-1 b:-0.5\n\n"
+        "shared | s_2\n| a:1\n1:0.5:0.5 | b:2\n"
+    )
+
+    model = vw.Workspace(["--cb_explore_adf"])
+    assert model.train_from_file(data_file) == 2
+
+
+def test_train_from_file_error_is_raised(tmp_path) -> None:
+    data_file = tmp_path / "data.json"
+    data_file.write_text('{"_label_cost": 1, "c": \n')
+
+    model = vw.Workspace(["--cb_explore_adf"])
+    with pytest.raises(Exception):
+        model.train_from_file(data_file, format="dsjson")
+    with pytest.raises(Exception):
+        model.train_from_file(tmp_path / "missing.txt")
+
+
+def test_learn_parallel(tmp_path) -> None:
+    lines = [f"{i % 2} | a:{i} b c{i % 7}" for i in range(500)]
+    data_file = tmp_path / "data.txt"
+    data_file.write_text("\n".join(lines) + "\n")
+
+    # A single thread learns in order, exactly as learn_batch does.
+    model_batch = vw.Workspace()
+    model_parallel = vw.Workspace()
+    parser = vw.TextFormatParser(model_batch)
+    model_batch.learn_batch([parser.parse_line(line) for line in lines])
+    assert (
+        model_parallel.learn_parallel(
+            [parser.parse_line(line) for line in lines], threads=1
+        )
+        == 500
+    )
+    assert np.allclose(model_batch.weights(), model_parallel.weights())
+
+    model_threaded = vw.Workspace()
+    assert model_threaded.learn_parallel(data_file, threads=4) == 500
+    assert model_threaded.learn_parallel(data_file, threads=4) == 500
+    assert np.count_nonzero(model_threaded.weights()) > 0
+    # Each thread counts its examples separately, so none are lost to the race.
+    delta = vw.calculate_sparse_delta(vw.Workspace(), model_threaded)
+    assert delta.weighted_examples == 1000
+
+    example = parser.parse_line(lines[0])
+    with pytest.raises(ValueError):
+        model_threaded.learn_parallel([example, example], threads=2)
+    with pytest.raises(ValueError):
+        vw.Workspace(["--cb_explore_adf"]).learn_parallel(data_file, threads=2)
+
+
+def test_prepared_examples_equivalent() -> None:
+    lines = ["1 | a b c", "2 | b d", "0.5 | b"]
+    model = vw.Workspace(["-q::"])
+    model_prepared = vw.Workspace(["-q::"])
+    parser = vw.TextFormatParser(model)
+    examples = [parser.parse_line(line) for line in lines]
+    prepared = [parser.parse_line(line) for line in lines]
+
+    model_prepared.prepare(prepared)
+    for _ in range(3):
+        model.learn_batch(examples)
+        model_prepared.learn_batch(prepared)
+    assert np.allclose(model.weights(), model_prepared.weights())
+    assert model.predict_one(examples[0]) == pytest.approx(
+        model_prepared.predict_one(prepared[0])
+    )
+
+    with pytest.raises(ValueError):
+        prepared[0]["a"].push_feature(1, 1.0)
+    with pytest.raises(Exception):
+        model.learn_one(prepared[0])
+
+    model_prepared.unprepare(prepared)
+    assert prepared[0]["a"].indices == examples[0]["a"].indices
+    model.learn_one(prepared[0])
@@ -0,0 +1,62 @@
+import numpy as np
+import pytest
+import vowpal_wabbit_next as vw
+
+
+def test_csr_equivalent_to_text() -> None:
+    workspace = vw.Workspace()
+    text_parser = vw.TextFormatParser(workspace)
+    parser = vw.MatrixFormatParser(workspace, namespace="features", hash_columns=True)
+
+    indptr = np.array([0, 2, 2, 3])
+    indices = np.array([0, 3, 1], dtype=np.int32)
+    data = np.array([1.5, 2.0, -1.0])
+    examples = parser.parse_csr(indptr, indices, data, labels=[1.0, 0.0, 1.0])
+    expected = [
+        text_parser.parse_line("1 |features 0:1.5 3:2"),
+        text_parser.parse_line("0 |features"),
+        text_parser.parse_line("1 |features 1:-1"),
+    ]
+
+    assert len(examples) == 3
+    for ex, expected_ex in zip(examples, expected):
+        assert ex.get_label().label == expected_ex.get_label().label
+        assert ex["f"].indices == expected_ex["f"].indices
+        assert ex["f"].values == expected_ex["f"].values
+        assert workspace.predict_one(ex) == workspace.predict_one(expected_ex)
+
+
+def test_dense_skips_zeros_and_learns() -> None:
+    workspace = vw.Workspace()
+    parser = vw.MatrixFormatParser(workspace)
+
+    matrix = np.array([[1.0, 0.0, 2.0], [0.0, 0.0, 0.0]], dtype=np.float32)
+    examples = parser.parse_dense(matrix, labels=[1.0, 0.0])
+    assert examples[0][" "].indices == [0, 2]
+    assert examples[0][" "].values == [1.0, 2.0]
+    assert examples[1].feat_group_indices == []
+
+    workspace.learn_batch(examples)
+    assert workspace.predict_one(examples[0]) != 0.0
+
+
+def test_invalid_matrix_is_rejected() -> None:
+    workspace = vw.Workspace()
+    parser = vw.MatrixFormatParser(workspace)
+
+    with pytest.raises(ValueError):
+        parser.parse_csr([0, 3], [0, 1], [1.0, 2.0])
+    with pytest.raises(ValueError):
+        parser.parse_dense(np.ones((2, 2)), labels=[1.0])
+    with pytest.raises(ValueError):
+        parser.parse_csr([0, 2], [0, -1], [1.0, 2.0])
+
+
+def test_default_namespace_with_hash_seed_equivalent_to_text() -> None:
+    workspace = vw.Workspace(["--hash_seed", "7"])
+    text_parser = vw.TextFormatParser(workspace)
+    parser = vw.MatrixFormatParser(workspace, hash_columns=True)
+
+    examples = parser.parse_csr([0, 2], [0, 3], [1.5, 2.0])
+    expected = text_parser.parse_line("| 0:1.5 3:2")
+    assert examples[0][" "].indices == expected[" "].indices
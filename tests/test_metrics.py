@@ -1,4 +1,5 @@
 import vowpal_wabbit_next as vw
+import numpy as np
 import pytest
 
 
@@ -17,3 +18,93 @@ def test_get_metric_not_enabled() -> None:
 
     with pytest.raises(RuntimeError):
         workspace.metrics
+
+
+def test_counters() -> None:
+    workspace = vw.Workspace(record_counters=True)
+    parser = vw.TextFormatParser(workspace)
+    for _ in range(10):
+        workspace.learn_one(parser.parse_line("1 | a b"))
+    workspace.predict_batch([parser.parse_line("| a b") for _ in range(5)])
+
+    counters = workspace.counters
+    assert counters["examples_learned"] == 10
+    assert counters["examples_predicted"] == 5
+    # Each example has the constant feature as well as a and b.
+    assert counters["features"] == 15 * 3
+    assert counters["interacted_features"] == 0
+    assert counters["average_features_per_example"] == 3.0
+    assert counters["parse_errors"] == 0
+    assert counters["learn_latency"]["histogram"].sum() == 10
+    assert counters["predict_latency"]["histogram"].sum() == 5
+    assert counters["learn_latency"]["total_seconds"] > 0
+
+    workspace.reset_counters()
+    assert not workspace.read_counters().any()
+
+
+def test_counters_interactions_and_parse_errors() -> None:
+    workspace = vw.Workspace(["--cb_explore_adf", "-q", "sa"], record_counters=True)
+    parser = vw.TextFormatParser(workspace)
+    workspace.learn_one(
+        [
+            parser.parse_line("shared |s s_1 s_2"),
+            parser.parse_line("0:0.1:0.25 |a a_1"),
+            parser.parse_line("|a a_2"),
+        ]
+    )
+    counters = workspace.counters
+    assert counters["examples_learned"] == 1
+    assert counters["interacted_features"] > 0
+
+    with pytest.raises(RuntimeError):
+        vw.DSJsonFormatParser(workspace).parse_json("{")
+    assert workspace.counters["parse_errors"] == 1
+
+
+def test_counters_skip_failed_calls() -> None:
+    workspace = vw.Workspace(["--cb_explore_adf"], record_counters=True)
+    parser = vw.TextFormatParser(workspace)
+    # Only one action may have a known cost.
+    with pytest.raises(Exception):
+        workspace.learn_one(
+            [
+                parser.parse_line("0:0.1:0.5 |a a_1"),
+                parser.parse_line("1:0.2:0.5 |a a_2"),
+            ]
+        )
+    assert not workspace.read_counters().any()
+
+
+def test_counters_frozen() -> None:
+    workspace = vw.Workspace(record_counters=True)
+    parser = vw.TextFormatParser(workspace)
+    workspace.learn_one(parser.parse_line("1 | a b"))
+    workspace.freeze()
+    workspace.predict_one(parser.parse_line("| a b"))
+    counters = workspace.counters
+    assert counters["examples_predicted"] == 1
+    assert counters["features"] == 6
+
+
+def test_read_counters_into_buffer() -> None:
+    workspace = vw.Workspace(record_counters=True)
+    names = vw.Workspace.counter_names()
+    buffer = np.zeros(len(names), dtype=np.uint64)
+    workspace.learn_one(vw.TextFormatParser(workspace).parse_line("1 | a"))
+    result = workspace.read_counters(out=buffer)
+    assert np.shares_memory(result, buffer)
+    assert buffer[names.index("examples_learned")] == 1
+
+    with pytest.raises(ValueError):
+        workspace.read_counters(out=np.zeros(3, dtype=np.uint64))
+    with pytest.raises(ValueError):
+        workspace.read_counters(out=np.zeros(len(names), dtype=np.float64))
+
+
+def test_counters_not_enabled() -> None:
+    workspace = vw.Workspace()
+    with pytest.raises(ValueError):
+        workspace.counters
+    with pytest.raises(ValueError):
+        workspace.reset_counters()
@@ -0,0 +1,56 @@
+import vowpal_wabbit_next as vw
+import numpy as np
+import pytest
+
+
+def test_reduction_profile() -> None:
+    workspace = vw.Workspace(enable_profiling=True)
+    parser = vw.TextFormatParser(workspace)
+    for _ in range(10):
+        workspace.learn_one(parser.parse_line("1 | a b c"))
+    workspace.predict_one(parser.parse_line("| a b"))
+
+    names, counters = workspace.reduction_profile_counters()
+    # count_label, scorer, gd
+    assert len(names) == 3
+    assert counters.shape == (3, 2, 35)
+    assert counters.dtype == np.uint64
+
+    profile = workspace.reduction_profile
+    assert [reduction["name"] for reduction in profile] == names
+    for reduction in profile:
+        learn = reduction["learn"]
+        assert learn["calls"] == 10
+        assert 0 <= learn["self_seconds"] <= learn["total_seconds"]
+        assert learn["histogram"].sum() == learn["calls"]
+        assert reduction["predict"]["calls"] >= 1
+
+    # Each reduction's total time includes the reductions below it.
+    totals = [reduction["learn"]["total_seconds"] for reduction in profile]
+    assert totals == sorted(totals, reverse=True)
+
+    workspace.reset_reduction_profile()
+    _, counters = workspace.reduction_profile_counters()
+    assert not counters.any()
+
+
+def test_reduction_profile_multiline() -> None:
+    workspace = vw.Workspace(["--cb_explore_adf"], enable_profiling=True)
+    parser = vw.TextFormatParser(workspace)
+    workspace.learn_one(
+        [
+            parser.parse_line("shared | s_1"),
+            parser.parse_line("0:0.1:0.25 | a:0.5 b:1"),
+            parser.parse_line("| a:-1 b:-0.5"),
+        ]
+    )
+    profile = workspace.reduction_profile
+    assert len(profile) > 3
+    assert profile[0]["learn"]["calls"] == 1
+
+
+def test_reduction_profile_not_enabled() -> None:
+    with pytest.raises(ValueError):
+        vw.Workspace().reduction_profile
+    with pytest.raises(ValueError):
+        vw.Workspace(enable_debug_tree=True, enable_profiling=True)  # type: ignore
@@ -51,3 +51,125 @@ def test_serialize_to_file_and_load() -> None:
         assert pred1 == pytest.approx(pred2)
     finally:
         model_path.unlink()
+
+
+def test_load_from_stream_and_gzip(tmp_path) -> None:
+    import gzip
+    import io
+
+    model = vw.Workspace()
+    parser = vw.TextFormatParser(model)
+    model.learn_one(parser.parse_line("1 | a b c"))
+    pred1 = model.predict_one(parser.parse_line("| b c"))
+    data = model.serialize()
+
+    gz_path = tmp_path / "model.vw.gz"
+    with gzip.open(gz_path, "wb") as f:
+        f.write(data)
+
+    with gzip.open(gz_path, "rb") as gz_file:
+        models = [
+            vw.Workspace(model_file=io.BytesIO(data)),
+            vw.Workspace(model_file=gz_file),
+            vw.Workspace.load_from_file(gz_path),
+        ]
+    for model2 in models:
+        parser2 = vw.TextFormatParser(model2)
+        assert model2.predict_one(parser2.parse_line("| b c")) == pytest.approx(pred1)
+
+    with pytest.raises(ValueError):
+        vw.Workspace(model_data=data, model_file=io.BytesIO(data))
+
+
+def test_serialize_to_file_object_and_gzip(tmp_path) -> None:
+    import io
+
+    model = vw.Workspace()
+    parser = vw.TextFormatParser(model)
+    model.learn_one(parser.parse_line("1 | a b c"))
+
+    buffer = io.BytesIO()
+    model.serialize_to(buffer)
+    assert buffer.getvalue() == model.serialize()
+
+    gz_path = tmp_path / "model.vw.gz"
+    model.serialize_to(gz_path)
+    model2 = vw.Workspace.load_from_file(gz_path)
+    assert model2.serialize() == model.serialize()
+
+
+def test_checkpoint_and_load(tmp_path) -> None:
+    model = vw.Workspace(["-q", "ab"])
+    parser = vw.TextFormatParser(model)
+    model.learn_one(parser.parse_line("1 |a x y |b z"))
+
+    checkpoint_path = tmp_path / "model.checkpoint"
+    model.checkpoint(checkpoint_path)
+    restored = vw.Workspace.load_checkpoint(checkpoint_path)
+    assert restored.serialize() == model.serialize()
+
+    # Learning after the checkpoint doesn't affect it.
+    model.learn_one(parser.parse_line("0 |a x |b w"))
+    assert (
+        vw.Workspace.load_checkpoint(checkpoint_path).serialize()
+        == restored.serialize()
+    )
+
+
+def test_checkpoint_async(tmp_path) -> None:
+    model = vw.Workspace(["-q", "ab"])
+    parser = vw.TextFormatParser(model)
+    model.learn_one(parser.parse_line("1 |a x y |b z"))
+    expected = model.serialize()
+
+    checkpoint_path = tmp_path / "model.checkpoint"
+    future = model.checkpoint_async(checkpoint_path)
+    # The snapshot was taken when checkpoint_async was called.
+    model.learn_one(parser.parse_line("0 |a x |b w"))
+    assert future.result() is None
+    assert vw.Workspace.load_checkpoint(checkpoint_path).serialize() == expected
+
+    stats = model.checkpoint_stats
+    assert stats["checkpoints"] == 1
+    assert stats["max_pause_seconds"] == stats["last_pause_seconds"] > 0
+
+    with pytest.raises(RuntimeError):
+        model.checkpoint_async(tmp_path / "missing" / "model.checkpoint").result()
+
+
+def test_overlapping_checkpoints(tmp_path) -> None:
+    model = vw.Workspace(["-q", "ab"])
+    parser = vw.TextFormatParser(model)
+    checkpoint_path = tmp_path / "model.checkpoint"
+    futures = []
+    for i in range(8):
+        model.learn_one(parser.parse_line(f"{i % 2} |a x{i} |b z"))
+        futures.append(model.checkpoint_async(checkpoint_path))
+    for future in futures:
+        future.result()
+
+    # Each checkpoint was written to its own temporary file, so the last one renamed
+    # into place is complete and none are left behind.
+    vw.Workspace.load_checkpoint(checkpoint_path)
+    assert [path.name for path in tmp_path.iterdir()] == ["model.checkpoint"]
+
+
+@pytest.mark.parametrize("share_weights", [False, True])
+def test_clone(share_weights: bool) -> None:
+    model = vw.Workspace(["-q", "ab"])
+    parser = vw.TextFormatParser(model)
+    model.learn_one(parser.parse_line("1 |a x y |b z"))
+
+    clone = model.clone(share_weights=share_weights)
+    assert clone.serialize() == model.serialize()
+
+    # Learning in either workspace is not seen by the other.
+    expected = clone.serialize()
+    model.learn_one(parser.parse_line("0 |a x |b w"))
+    assert clone.serialize() == expected
+    model_expected = model.serialize()
+    clone_parser = vw.TextFormatParser(clone)
+    clone.learn_one(clone_parser.parse_line("1 |a y |b z"))
+    clone.learn_one(clone_parser.parse_line("1 |a y |b z"))
+    assert model.serialize() == model_expected
+    assert clone.serialize() != model_expected
@@ -51,3 +51,46 @@ def test_cb_input() -> None:
             assert isinstance(example, list)
 
     assert counter == 3
+
+
+def test_native_reader_from_path(tmp_path) -> None:
+    data_file = tmp_path / "data.txt"
+    data_file.write_text(
+        dedent(
+            """shared | s_1
+        0:1.5:0.25 | a:0.5 b:1
+        | a:-1 b:-0.5
+
+        shared | s_1
+        | a:-1 b:-0.5
+        0:-1.5:0.5 | a:2 b:-1
+    """
+        )
+    )
+    workspace = vw.Workspace(["--cb_explore_adf"])
+    lengths = []
+    with vw.TextFormatReader(workspace, data_file) as reader:
+        for example in reader:
+            assert isinstance(example, list)
+            lengths.append(len(example))
+
+    assert lengths == [3, 3]
+
+
+def test_native_reader_matches_python_reader(tmp_path) -> None:
+    data = "1 | a b c\n0 | d e f\n\n0.5 |x y:2\n"
+    data_file = tmp_path / "data.txt"
+    data_file.write_text(data)
+    workspace = vw.Workspace()
+
+    with vw.TextFormatReader(workspace, io.StringIO(data)) as reader:
+        expected = [(ex.get_label(), list(ex)) for ex in reader]
+    with vw.TextFormatReader(workspace, str(data_file)) as reader:
+        actual = [(ex.get_label(), list(ex)) for ex in reader]
+
+    assert len(actual) == len(expected) == 4
+    for (expected_label, expected_groups), (label, groups) in zip(expected, actual):
+        assert repr(expected_label) == repr(label)
+        assert [(g.indices, g.values) for g in expected_groups] == [
+            (g.indices, g.values) for g in groups
+        ]